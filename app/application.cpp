@@ -1,5 +1,7 @@
 #include "application.h"
 #include "vulkan_wrapper/image.h"
+#include <cmath>
+#include <filesystem>
 
 namespace FF {
 
@@ -19,8 +21,11 @@ namespace FF {
 	}
 
 	void Application::initWindow() {
-		_window = Wrapper::Window::create(_width, _height);
-		_window->setApp(shared_from_this());
+		//޴ģʽֻ
+		if (!_headless) {
+			_window = Wrapper::Window::create(_width, _height);
+			_window->setApp(shared_from_this());
+		}
 
 		_camera.lookAt(
 			glm::vec3(0.0f, 0.0f, 3.0f), 
@@ -34,95 +39,194 @@ namespace FF {
 	}
 
 	void Application::initVulkan() {
-		_instance = Wrapper::Instance::create(true);
-		_surface = Wrapper::WindowSurface::create(_instance, _window);
+		FF_PROFILE_ZONE("Application::initVulkan");
+		_instance = Wrapper::Instance::create(true, _headless);
+		if (!_headless) {
+			_surface = Wrapper::WindowSurface::create(_instance, _window);
+		}
 		_device = Wrapper::Device::create(_instance, _surface);
-		_commandPool = Wrapper::CommandPool::create(_device);
-		_swapChain = Wrapper::SwapChain::create(_device, _commandPool, _window, _surface);
-
-		_width = _swapChain->getExtent().width;
-		_height = _swapChain->getExtent().height;
+		_pipelineCache = Wrapper::PipelineCache::create(_device);
+		_pipelineRegistry = Wrapper::PipelineRegistry::create(_device);
+		_graphicScheduler = Wrapper::SubmitScheduler::create(_device, _device->getGraphicQueue());
+		_uploadManager = Wrapper::UploadManager::create(_device, _graphicScheduler);
+		_threadPool = ThreadPool::create();
+		_recordThreadPool = ThreadPool::create();
+		_pipelineCompiler = Wrapper::PipelineCompiler::create(_pipelineRegistry, _threadPool);
+		_samplerCache = Wrapper::SamplerCache::create(_device);
+		_textureCache = TextureCache::create(_device, _uploadManager, _samplerCache);
+		_textureLoader = TextureLoader::create(_textureCache, _threadPool);
+		//ͼƬÿһ֡һţ֡ύִ֮ǰٴд룬Ҫͬ
+		if (_headless) {
+			_offscreenTarget = Wrapper::OffscreenTarget::create(_device, _width, _height, _framesInFlight, !_readbackPath.empty());
+		}
+		else {
+			_swapChain = Wrapper::SwapChain::create(_device, _window, _surface);
+			_width = _swapChain->getExtent().width;
+			_height = _swapChain->getExtent().height;
+		}
 
 		_renderPass = Wrapper::RenderPass::create(_device);
 		createRenderPass();
-		_swapChain->createFrameBuffers(_renderPass);
+		if (_headless) {
+			_offscreenTarget->createFrameBuffers(_renderPass);
+		}
+		else {
+			_swapChain->createFrameBuffers(_renderPass);
+		}
 
 		//uniformManager
 		_uniformManager = UniformManager::create();
-		_uniformManager->init(_device, _commandPool, _swapChain->getImageCount());
+		if (_bindlessRequested) {
+			if (!_device->isBindlessSupported()) {
+				std::cout << "Warning: descriptor indexing is not supported, bindless disabled" << std::endl;
+			}
+			else if (!std::filesystem::exists(BINDLESS_FRAGMENT_SHADER)) {
+				std::cout << "Warning: " << BINDLESS_FRAGMENT_SHADER << " not found, bindless disabled" << std::endl;
+			}
+			else {
+				_bindlessTable = Wrapper::BindlessTable::create(_device);
+			}
+		}
+		//ÿһuniformλ尴ջбĴС
+		_uniformManager->init(
+			_device, _textureLoader, static_cast<int>(_framesInFlight), 
+			std::max(UniformManager::DEFAULT_MAX_OBJECT_COUNT, _instanceCount), _bindlessTable
+		);
 
 		//ģ
-		_model = Model::create(_device);
+		_model = Model::create(_device, _uploadManager);
 
+		//гʼ׶εϴϲΪһύ
+		_uploadManager->flush();
 
-		_pipeline = Wrapper::Pipeline::create(_device, _renderPass);
+
+		_pipeline = Wrapper::Pipeline::create(_device, _renderPass, _pipelineCache);
 		createPipeline();
-		createCommandBuffers();
-		createSyncObjects();
+		createFrameContexts();
+
+		_deletionQueue = Wrapper::DeletionQueue::create(_graphicScheduler);
+
+		if (_gpuProfilingRequested) {
+			_gpuProfiler = Wrapper::GpuProfiler::create(
+				_device, _framesInFlight, 
+				Wrapper::GpuProfiler::DEFAULT_MAX_REGIONS, _gpuProfileHistorySize
+			);
+			if (_cpuProfilingRequested) {
+				_gpuProfiler->calibrate(_graphicScheduler);
+			}
+			_mainPassRegionId = _gpuProfiler->getRegionId(MAIN_PASS_REGION);
+		}
 	}
 
 	void Application::mainLoop() {
-		while (!_window->shouldClose()) {
-			_window->pollEvents();
-			_window->proccessEvent();
-			_model->update();
+		_startTime = std::chrono::steady_clock::now();
+		while (!shouldExit()) {
+			FF_PROFILE_ZONE("Application::mainLoop");
+			if (!_headless) {
+				_window->pollEvents();
+				_window->proccessEvent();
+			}
+			if (_frameCallback) {
+				_frameCallback(_frameNumber, _camera);
+			}
+			_model->update(getSimulationTime());
+			buildDrawList();
 			_vpMatrices.mViewMatrix = _camera.getViewMatrix();
 			_vpMatrices.mProjectionMatrix = _camera.getProjectionMatrix();
-			_uniformManager->update(_vpMatrices, _model->getUniform(), _currentFrame);
+
+			updatePipeline();
+
+			//ɵ¼ϴ뱾֡ϴһύѾɵ
+			_textureLoader->update();
+			_uploadManager->update();
+
+			//ϴϣµdescriptorSetCommandBufferÿ֡¼ƣһ֡ȻµdescriptorSet
+			//bindlessģʽ»µĲ±꣬ͬһ֡¼ʱдpush constant
+			if (_uniformManager->hasTextureUpdates()) {
+				_uniformManager->applyTextureUpdates();
+			}
 
 			render();
+
+			++_frameNumber;
+			if (_gpuProfiler && _gpuProfileReportInterval > 0 && _frameNumber % _gpuProfileReportInterval == 0) {
+				printGpuProfile();
+			}
 		}
 		vkDeviceWaitIdle(_device->getDevice());
 	}
 
+	bool Application::isLastFrame() const {
+		return _frameLimit > 0 && _frameNumber + 1 >= _frameLimit;
+	}
+
+	bool Application::shouldExit() const {
+		if (_frameLimit > 0 && _frameNumber >= _frameLimit) {
+			return true;
+		}
+		return !_headless && _window->shouldClose();
+	}
+
+	double Application::getSimulationTime() const {
+		if (_fixedTimeStep > 0.0) {
+			return static_cast<double>(_frameNumber) * _fixedTimeStep;
+		}
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - _startTime).count();
+	}
+
 	void Application::render() {
-		//ȴǰҪύCommandBufferִ
-		_fences[_currentFrame]->block();
+		FF_PROFILE_ZONE("Application::render");
+		if (_headless) {
+			renderHeadless();
+			return;
+		}
+
+		auto& frame = _frames[_currentFrame];
+
+		//ȴһ֡һεύִϣ֮һ֡CommandBufferuniform򶼿Ը
+		frame->begin();
+		_deletionQueue->update();
+
 		//ȡеһ֡
 		uint32_t imageIndex{ 0 };
-		VkResult result = vkAcquireNextImageKHR(
-			_device->getDevice(),
-			_swapChain->getSwapChain(),
-			UINT64_MAX,
-			_imageAvailableSemaphores[_currentFrame]->getSemaphore(),
-			VK_NULL_HANDLE,
-			&imageIndex
-		);
+		VkResult result{ VK_SUCCESS };
+		{
+			FF_PROFILE_ZONE("vkAcquireNextImageKHR");
+			result = vkAcquireNextImageKHR(
+				_device->getDevice(),
+				_swapChain->getSwapChain(),
+				UINT64_MAX,
+				frame->getImageAvailableSemaphore()->getSemaphore(),
+				VK_NULL_HANDLE,
+				&imageIndex
+			);
+		}
 
+		//ûõͼsemaphoreҲᱻ֡ύؽֱӷأ֡ûȾ
 		if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+			_skippedFrames.push_back(_frameNumber);
 			reCreateSwapChain();
 			_window->mWindowResized = false;
+			return;
 		}//VK_SUBOPTIMAL_KHRõһΪõͼ񣬵ʽһƥ
 		else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
 			throw std::runtime_error("Error: Failed to acquire next image");
 		}
 
-		//ύϢ
-		VkSubmitInfo submitInfo{};
-		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		//GPUѾٶȡһ֡uniformд뱾֡ݲ¼
+		_uniformManager->update(_vpMatrices, _objectUniforms, _currentFrame);
+		recordCommandBuffer(frame, imageIndex);
 
 		//ͬϢȾʾͼʾϺ󣬲ɫ
-		VkSemaphore waitSemaphores[] = { _imageAvailableSemaphores[_currentFrame]->getSemaphore() };
-		VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-
-		submitInfo.waitSemaphoreCount = 1;
-		submitInfo.pWaitSemaphores = waitSemaphores;
-		submitInfo.pWaitDstStageMask = waitStages;
-
-		//ָύЩ
-		auto commandBuffer = _commandBuffers[imageIndex]->getCommandBuffer();
-		submitInfo.commandBufferCount = 1;
-		submitInfo.pCommandBuffers = &commandBuffer;
-		
-		//ִ֮ҪЩsemaphore
-		VkSemaphore signalSemaphores[] = { _renderFinishedSemaphores[_currentFrame]->getSemaphore() };
-		submitInfo.signalSemaphoreCount = 1;
-		submitInfo.pSignalSemaphores = signalSemaphores;
-
-		_fences[_currentFrame]->resetFence();
-		if (vkQueueSubmit(_device->getGraphicQueue(), 1, &submitInfo, _fences[_currentFrame]->getFence()) != VK_SUCCESS) {
-			throw std::runtime_error("Error: failed to submit render command");
-		}
+		//ִ֮󼤻ͼƬrenderFinishedͬʱtimelineﱾύֵ
+		VkSemaphore signalSemaphores[] = { _swapChain->getRenderFinishedSemaphore(imageIndex)->getSemaphore() };
+		uint64_t submitValue = _graphicScheduler->submit(
+			{ frame->getCommandBuffer()->getCommandBuffer() },
+			{ frame->getImageAvailableSemaphore()->getSemaphore() },
+			{ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT },
+			{ signalSemaphores[0] }
+		);
+		frame->setSubmitValue(submitValue);
 
 		VkPresentInfoKHR presentInfo{};
 		presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -136,7 +240,10 @@ namespace FF {
 
 		presentInfo.pImageIndices = &imageIndex;
 
-		result = vkQueuePresentKHR(_device->getPresentQueue(), &presentInfo);
+		{
+			FF_PROFILE_ZONE("vkQueuePresentKHR");
+			result = vkQueuePresentKHR(_device->getPresentQueue(), &presentInfo);
+		}
 
 		//һ׼ǻҪԼı־λж
 		if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || _window->mWindowResized) {
@@ -147,46 +254,66 @@ namespace FF {
 			throw std::runtime_error("Error: failed to present");
 		}
 
-		_currentFrame = (_currentFrame + 1) % _swapChain->getImageCount();
+		_currentFrame = (_currentFrame + 1) % static_cast<int>(_frames.size());
 	}
 
-	void Application::cleanUp() {
-		
+	void Application::renderHeadless() {
+		auto& frame = _frames[_currentFrame];
+
+		frame->begin();
+		_deletionQueue->update();
+
+		//ͼƬ֡һһӦ
+		uint32_t imageIndex = frame->getIndex();
+
+		_uniformManager->update(_vpMatrices, _objectUniforms, _currentFrame);
+		recordCommandBuffer(frame, imageIndex);
+
+		//ûacquirepresentҪbinary semaphore
+		uint64_t submitValue = _graphicScheduler->submit({ frame->getCommandBuffer()->getCommandBuffer() });
+		frame->setSubmitValue(submitValue);
+
+		_currentFrame = (_currentFrame + 1) % static_cast<int>(_frames.size());
 	}
 
-	void Application::createPipeline() {
+	void Application::cleanUp() {
+		//mainLoopʱ豸Ѿ
+		_deletionQueue->flush();
 
-		//ӿ
-		VkViewport viewport = {};
-		viewport.x = 0.0f;
-		viewport.y = (float)_height;
-		viewport.width = (float)_width;
-		viewport.height = -(float)_height;
-		viewport.minDepth = 0.0f;
-		viewport.maxDepth = 1.0f;
+		//һ֡¼˶
+		if (_offscreenTarget && _offscreenTarget->hasReadback()) {
+			_offscreenTarget->saveImage(_readbackPath);
+		}
 
-		VkRect2D scissor = {};
-		scissor.offset = { 0,0 };
-		scissor.extent = { _width,_height };
+		//һʱpipelineֱ
+		_pipelineCache->save();
+
+		//֡GPUûжأtraceGPU¼CPU
+		if (_cpuProfilingRequested) {
+			CpuProfiler::getInstance().writeChromeTrace(_tracePath);
+		}
+	}
+
+	void Application::createPipeline() {
 
-		_pipeline->setViewports({ viewport });
-		_pipeline->setScissors({ scissor });
+		//ӿΪ̬״̬¼CommandBufferʱսĴСãڴС仯ʱpipelineҪؽ
+		_pipeline->setDynamicStates({ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR });
 
 		//shader
 		std::vector<Wrapper::Shader::Ptr> shaderGroup{};
 		auto shaderVertex = Wrapper::Shader::create(_device, "shaders/vs.spv", VK_SHADER_STAGE_VERTEX_BIT, "main");
-		auto shaderFragment = Wrapper::Shader::create(_device, "shaders/fs.spv", VK_SHADER_STAGE_FRAGMENT_BIT, "main");
+		auto shaderFragment = Wrapper::Shader::create(
+			_device, 
+			_bindlessTable ? BINDLESS_FRAGMENT_SHADER : "shaders/fs.spv", 
+			VK_SHADER_STAGE_FRAGMENT_BIT, 
+			"main"
+		);
 		shaderGroup.push_back(shaderVertex);
 		shaderGroup.push_back(shaderFragment);
 		_pipeline->setShaderGroup(shaderGroup);
 
 		//Ųģʽ
-		auto vertexBindingDes = _model->getVertexInputBingdingDescription();
-		auto vertexAttribuDes = _model->getVertexInputAttributeDescription();
-		_pipeline->mVertexInputState.vertexBindingDescriptionCount = static_cast<uint32_t>(vertexBindingDes.size());
-		_pipeline->mVertexInputState.pVertexBindingDescriptions = vertexBindingDes.data();
-		_pipeline->mVertexInputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexAttribuDes.size());
-		_pipeline->mVertexInputState.pVertexAttributeDescriptions = vertexAttribuDes.data();
+		_pipeline->setVertexInput(_model->getVertexInputBingdingDescription(), _model->getVertexInputAttributeDescription());
 
 		//ͼԪװ
 		_pipeline->mAssemblyState.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
@@ -248,30 +375,56 @@ namespace FF {
 		_pipeline->mBlendState.blendConstants[3] = 0.0f;
 
 		//uniformĴ
-		auto layout = _uniformManager->getDescriptorSetLayout()->getLayout();
-		_pipeline->mLayoutCreateInfo.setLayoutCount = 1;
-		_pipeline->mLayoutCreateInfo.pSetLayouts = &layout;
-		_pipeline->mLayoutCreateInfo.pushConstantRangeCount = 0;
-		_pipeline->mLayoutCreateInfo.pPushConstantRanges = nullptr;
+		//bindlessģʽset 1Ϊbindless±ͨpush constant
+		if (_bindlessTable) {
+			VkPushConstantRange materialRange{};
+			materialRange.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+			materialRange.offset = 0;
+			materialRange.size = sizeof(uint32_t);
+
+			_pipeline->setDescriptorSetLayouts(
+				{ _uniformManager->getDescriptorSetLayout()->getLayout(), _bindlessTable->getLayout() },
+				{ _uniformManager->getDescriptorSetLayout()->getLayoutKey(), _bindlessTable->getLayoutKey() }
+			);
+			_pipeline->setPushConstantRanges({ materialRange });
+		}
+		else {
+			_pipeline->setDescriptorSetLayouts(
+				{ _uniformManager->getDescriptorSetLayout()->getLayout() },
+				{ _uniformManager->getDescriptorSetLayout()->getLayoutKey() }
+			);
+		}
+
+		//״̬ͬpipelineѾʱֱӸã̳߳б룬߳
+		//֮߳ٷʣǰ_pipelineΪգupdatePipelineл
+		_pipelineHandle = _pipelineCompiler->compile(_pipeline);
+		_pipeline = _pipelineHandle->getPipeline();
+	}
 
-		_pipeline->build();
+	void Application::updatePipeline() {
+		_pipelineCompiler->update();
+		if (_pipelineHandle->isFailed()) {
+			throw std::runtime_error("Error: failed to compile pipeline: " + _pipelineHandle->getError());
+		}
+		_pipeline = _pipelineHandle->getPipeline();
 	}
 
 	void Application::createRenderPass() {
 		//뻭
 		VkAttachmentDescription colorAttachmentDes{};
-		colorAttachmentDes.format = _swapChain->getFormat();
+		colorAttachmentDes.format = getColorFormat();
 		colorAttachmentDes.samples = VK_SAMPLE_COUNT_1_BIT;
 		colorAttachmentDes.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
 		colorAttachmentDes.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
 		colorAttachmentDes.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 		colorAttachmentDes.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 		colorAttachmentDes.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-		colorAttachmentDes.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		//Ⱦֱ֮ӿ
+		colorAttachmentDes.finalLayout = _headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 		_renderPass->addAttachment(colorAttachmentDes);
 
 		VkAttachmentDescription multiSampleAttachmentDes{};
-		multiSampleAttachmentDes.format = _swapChain->getFormat();
+		multiSampleAttachmentDes.format = getColorFormat();
 		multiSampleAttachmentDes.samples = _device->getMaxUsableSampleCount();
 		multiSampleAttachmentDes.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
 		multiSampleAttachmentDes.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
@@ -323,59 +476,271 @@ namespace FF {
 		dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
 		_renderPass->addDependency(dependency);
 
+		//صĿҪȴɫдԼTRANSFER_SRClayoutת
+		if (_headless) {
+			VkSubpassDependency readbackDependency{};
+			readbackDependency.srcSubpass = 0;
+			readbackDependency.dstSubpass = VK_SUBPASS_EXTERNAL;
+			readbackDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			readbackDependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+			readbackDependency.dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+			readbackDependency.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+			_renderPass->addDependency(readbackDependency);
+		}
+
 		_renderPass->buildPrenderPass();
 	}
 
-	void Application::createCommandBuffers() {
-		_commandBuffers.resize(_swapChain->getImageCount());
-		for (int i = 0; i < _swapChain->getImageCount(); ++i) {
-			_commandBuffers[i] = Wrapper::CommandBuffer::create(_device, _commandPool);
-			_commandBuffers[i]->begin();
-
-			VkRenderPassBeginInfo renderBeginInfo{};
-			renderBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-			renderBeginInfo.renderPass = _renderPass->getRenderPass();
-			renderBeginInfo.framebuffer = _swapChain->getFrameBuffer(i);
-			renderBeginInfo.renderArea.offset = { 0,0 };
-			renderBeginInfo.renderArea.extent = _swapChain->getExtent();
-
-			std::vector<VkClearValue> clearColors{};
-			//չʾɫ
-			VkClearValue clearColor = {};
-			clearColor.color = { 0.0f,0.0f,0.0f,1.0f };
-			clearColors.push_back(clearColor);
-			//ز
-			VkClearValue clearMultiSampleColor = {};
-			clearMultiSampleColor.color = { 0.0f,0.0f,0.0f,1.0f };
-			clearColors.push_back(clearMultiSampleColor);
-			//
-			VkClearValue clearDepth{};
-			clearDepth.depthStencil = { 1.0f,0 };
-			clearColors.push_back(clearDepth);
-			renderBeginInfo.clearValueCount = static_cast<uint32_t>(clearColors.size());
-			renderBeginInfo.pClearValues = clearColors.data();
-
-			_commandBuffers[i]->beginRenderPass(renderBeginInfo);
-			_commandBuffers[i]->bindGraphicPipeline(_pipeline->getPipeline());
-			_commandBuffers[i]->bindDescriptorSet(_pipeline->getPipelineLayout(), _uniformManager->getDescriptorSet(_currentFrame));
-			//_commandBuffers[i]->bindVertexBuffer({ mModel->getVertexBuffer()->getBuffer() });
-			_commandBuffers[i]->bindVertexBuffer(_model->getVertexBuffers());
-			_commandBuffers[i]->bindIndexBuffer(_model->getIndexBuffer()->getBuffer());
-			_commandBuffers[i]->drawIndex(_model->getIndexCount());
-			_commandBuffers[i]->endRenderPass();
-			_commandBuffers[i]->end();
+	void Application::recordCommandBuffer(const Wrapper::FrameContext::Ptr& frame, uint32_t imageIndex) {
+		FF_PROFILE_ZONE("Application::recordCommandBuffer");
+		auto commandBuffer = frame->getCommandBuffer();
+		commandBuffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+		//ѯصҪRenderPass֮
+		uint32_t passRegion{ Wrapper::GpuProfiler::INVALID_REGION };
+		if (_gpuProfiler) {
+			//ƼʱʱÿһregionѯذӴ
+			auto drawCount = static_cast<uint32_t>(_drawList.size());
+			_gpuProfiler->beginFrame(commandBuffer, frame->getIndex(), _frameNumber, 1 + (_gpuProfileDraws ? drawCount : 0));
+			passRegion = _gpuProfiler->beginRegion(commandBuffer, _mainPassRegionId);
+
+			//Ƶregion¼߳̿ʼ֮ǰһԤ¼ʱټ
+			if (_gpuProfileDraws) {
+				_firstDrawRegion = _gpuProfiler->reserveRegions(drawCount);
+			}
 		}
+
+		recordRenderPass(commandBuffer, frame, imageIndex);
+
+		if (_gpuProfiler) {
+			_gpuProfiler->endRegion(commandBuffer, passRegion);
+		}
+
+		//ֻһ֡Ľᱻ棬֮ǰ֡
+		if (_offscreenTarget && isLastFrame()) {
+			_offscreenTarget->recordReadback(commandBuffer, imageIndex);
+		}
+
+		commandBuffer->end();
 	}
 
-	void Application::createSyncObjects() {
-		for (int i = 0; i < _swapChain->getImageCount(); ++i) {
-			auto imageSemaphore = Wrapper::Semaphore::create(_device);
-			_imageAvailableSemaphores.push_back(imageSemaphore);
-			auto renderSemaphore = Wrapper::Semaphore::create(_device);
-			_renderFinishedSemaphores.push_back(renderSemaphore);
-			auto fence = Wrapper::Fence::create(_device);
-			_fences.push_back(fence);
+	void Application::recordRenderPass(
+		const Wrapper::CommandBuffer::Ptr& commandBuffer, 
+		const Wrapper::FrameContext::Ptr& frame, 
+		uint32_t imageIndex
+	) {
+		VkRenderPassBeginInfo renderBeginInfo{};
+		renderBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderBeginInfo.renderPass = _renderPass->getRenderPass();
+		renderBeginInfo.framebuffer = getFrameBuffer(imageIndex);
+		renderBeginInfo.renderArea.offset = { 0,0 };
+		renderBeginInfo.renderArea.extent = getRenderExtent();
+
+		std::vector<VkClearValue> clearColors{};
+		//չʾɫ
+		VkClearValue clearColor = {};
+		clearColor.color = { 0.0f,0.0f,0.0f,1.0f };
+		clearColors.push_back(clearColor);
+		//ز
+		VkClearValue clearMultiSampleColor = {};
+		clearMultiSampleColor.color = { 0.0f,0.0f,0.0f,1.0f };
+		clearColors.push_back(clearMultiSampleColor);
+		//
+		VkClearValue clearDepth{};
+		clearDepth.depthStencil = { 1.0f,0 };
+		clearColors.push_back(clearDepth);
+		renderBeginInfo.clearValueCount = static_cast<uint32_t>(clearColors.size());
+		renderBeginInfo.pClearValues = clearColors.data();
+
+		//pipelineڱ룬ֻ
+		if (!_pipeline) {
+			commandBuffer->beginRenderPass(renderBeginInfo);
+			commandBuffer->endRenderPass();
+			return;
+		}
+
+		//ʱֱ¼
+		uint32_t workerCount = frame->getWorkerCount();
+		if (workerCount < 2 || _drawList.size() < PARALLEL_RECORD_MIN_DRAWS) {
+			commandBuffer->beginRenderPass(renderBeginInfo);
+			recordDraws(commandBuffer, frame->getIndex(), 0, _drawList.size());
+			commandBuffer->endRenderPass();
+			return;
 		}
+
+		//RenderPassеָȫԶ
+		commandBuffer->beginRenderPass(renderBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+		VkCommandBufferInheritanceInfo inheritance{};
+		inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritance.renderPass = _renderPass->getRenderPass();
+		inheritance.subpass = 0;
+		inheritance.framebuffer = getFrameBuffer(imageIndex);
+
+		//ÿһʹԼλCommandPool֮ͬ߳䲻Ҫ
+		auto recordChunk = [this, frame, inheritance](uint32_t workerIndex, size_t first, size_t last) {
+			auto secondaryCommandBuffer = frame->getSecondaryCommandBuffer(workerIndex);
+			secondaryCommandBuffer->begin(
+				VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT, 
+				inheritance
+			);
+			recordDraws(secondaryCommandBuffer, frame->getIndex(), first, last);
+			secondaryCommandBuffer->end();
+		};
+
+		//бƽз֣0߳¼ƣν̳߳
+		size_t chunkSize = (_drawList.size() + workerCount - 1) / workerCount;
+		std::vector<std::future<void>> futures{};
+		std::vector<VkCommandBuffer> secondaryCommandBuffers{};
+		for (uint32_t i = 0; i < workerCount; ++i) {
+			size_t first = i * chunkSize;
+			size_t last = std::min(first + chunkSize, _drawList.size());
+			if (first >= last) {
+				break;
+			}
+
+			secondaryCommandBuffers.push_back(frame->getSecondaryCommandBuffer(i)->getCommandBuffer());
+			if (i > 0) {
+				futures.push_back(_recordThreadPool->submit(recordChunk, i, first, last));
+			}
+		}
+		recordChunk(0, 0, std::min(chunkSize, _drawList.size()));
+
+		//get׳¼е쳣
+		for (auto& future : futures) {
+			future.get();
+		}
+
+		//зֵ˳ִУ˳뵥߳¼һ
+		commandBuffer->executeCommands(secondaryCommandBuffers);
+		commandBuffer->endRenderPass();
+	}
+
+	void Application::recordDraws(const Wrapper::CommandBuffer::Ptr& commandBuffer, uint32_t frameIndex, size_t first, size_t last) {
+		FF_PROFILE_ZONE("Application::recordDraws");
+		//岻̳İ붯̬״̬ÿ
+		commandBuffer->bindGraphicPipeline(_pipeline->getPipeline());
+
+		//ӿڣyת(ҪVK_KHR_maintenance1)
+		VkViewport viewport = {};
+		viewport.x = 0.0f;
+		viewport.y = (float)_height;
+		viewport.width = (float)_width;
+		viewport.height = -(float)_height;
+		viewport.minDepth = 0.0f;
+		viewport.maxDepth = 1.0f;
+		commandBuffer->setViewport(viewport);
+
+		VkRect2D scissor = {};
+		scissor.offset = { 0,0 };
+		scissor.extent = { _width,_height };
+		commandBuffer->setScissor(scissor);
+
+		if (_bindlessTable) {
+			uint32_t materialIndex = _uniformManager->getMaterialIndex();
+			commandBuffer->bindDescriptorSets(_pipeline->getPipelineLayout(), 1, { _bindlessTable->getDescriptorSet() });
+			commandBuffer->pushConstants(
+				_pipeline->getPipelineLayout(), 
+				VK_SHADER_STAGE_FRAGMENT_BIT, 
+				0, sizeof(uint32_t), &materialIndex
+			);
+		}
+
+		//ڵĻʹͬһģʱظ󶨶
+		Model* boundModel{ nullptr };
+		for (size_t i = first; i < last; ++i) {
+			const auto& drawCommand = _drawList[i];
+			if (drawCommand.mModel.get() != boundModel) {
+				commandBuffer->bindVertexBuffer(drawCommand.mModel->getVertexBuffers());
+				commandBuffer->bindIndexBuffer(drawCommand.mModel->getIndexBuffer()->getBuffer());
+				boundModel = drawCommand.mModel.get();
+			}
+
+			//ÿƵʱʹ¼֮ǰԤregion
+			uint32_t drawRegion{ Wrapper::GpuProfiler::INVALID_REGION };
+			if (_gpuProfileDraws && _firstDrawRegion != Wrapper::GpuProfiler::INVALID_REGION) {
+				drawRegion = _firstDrawRegion + static_cast<uint32_t>(i);
+				_gpuProfiler->beginReservedRegion(commandBuffer, drawRegion, _drawRegionIds[i]);
+			}
+
+			commandBuffer->bindDescriptorSet(
+				_pipeline->getPipelineLayout(), 
+				_uniformManager->getDescriptorSet(frameIndex), 
+				{ _uniformManager->getObjectDynamicOffset(drawCommand.mObjectIndex) }
+			);
+			commandBuffer->drawIndex(drawCommand.mModel->getIndexCount());
+
+			if (drawRegion != Wrapper::GpuProfiler::INVALID_REGION) {
+				_gpuProfiler->endReservedRegion(commandBuffer, drawRegion);
+			}
+		}
+	}
+
+	void Application::printGpuProfile() {
+		std::cout << "GPU time (ms, last " << _gpuProfileHistorySize << " frames)" << std::endl;
+		for (const auto& name : _gpuProfiler->getRegionNames()) {
+			auto stats = _gpuProfiler->getStats(name);
+			std::cout << "  " << name 
+				<< "  min " << stats.mMinMs 
+				<< "  avg " << stats.mAvgMs 
+				<< "  p99 " << stats.mP99Ms << std::endl;
+		}
+	}
+
+	void Application::buildDrawList() {
+		//бÿ֡ؽɾ岻ҪؽκCommandBuffer
+		_drawList.clear();
+		_objectUniforms.clear();
+
+		//ʵxyƽųɱ߳Ϊ2ÿʵСһС
+		uint32_t gridSize = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(_instanceCount))));
+		float cellSize = 2.0f / static_cast<float>(gridSize);
+
+		for (uint32_t i = 0; i < _instanceCount; ++i) {
+			ObjectUniform uniform = _model->getUniform();
+			if (gridSize > 1) {
+				glm::vec3 position(
+					-1.0f + cellSize * (static_cast<float>(i % gridSize) + 0.5f),
+					-1.0f + cellSize * (static_cast<float>(i / gridSize) + 0.5f),
+					0.0f
+				);
+				glm::mat4 placement = glm::translate(glm::mat4(1.0f), position);
+				placement = glm::scale(placement, glm::vec3(cellSize * 0.5f));
+				uniform.mModelMatrix = placement * uniform.mModelMatrix;
+			}
+
+			DrawCommand drawCommand{};
+			drawCommand.mModel = _model;
+			drawCommand.mObjectIndex = static_cast<uint32_t>(_objectUniforms.size());
+			_drawList.push_back(drawCommand);
+			_objectUniforms.push_back(uniform);
+		}
+
+		//ʱŵǼµƣ¼ʱƴַ
+		if (_gpuProfileDraws) {
+			for (size_t i = _drawRegionIds.size(); i < _drawList.size(); ++i) {
+				_drawRegionIds.push_back(_gpuProfiler->getRegionId("Draw " + std::to_string(i)));
+			}
+		}
+	}
+
+	void Application::createFrameContexts() {
+		_frames.resize(_framesInFlight);
+		for (uint32_t i = 0; i < _framesInFlight; ++i) {
+			_frames[i] = Wrapper::FrameContext::create(_device, _graphicScheduler, i, _recordThreadPool->getThreadCount());
+		}
+	}
+
+	VkFormat Application::getColorFormat() const {
+		return _headless ? _offscreenTarget->getFormat() : _swapChain->getFormat();
+	}
+
+	VkFramebuffer Application::getFrameBuffer(uint32_t imageIndex) const {
+		return _headless ? _offscreenTarget->getFrameBuffer(imageIndex) : _swapChain->getFrameBuffer(imageIndex);
+	}
+
+	VkExtent2D Application::getRenderExtent() const {
+		return _headless ? _offscreenTarget->getExtent() : _swapChain->getExtent();
 	}
 
 	void Application::reCreateSwapChain() {
@@ -387,27 +752,36 @@ namespace FF {
 			glfwGetFramebufferSize(_window->getWindow(), &width, &height);
 		}
 
-		vkDeviceWaitIdle(_device->getDevice());
-		cleanUpSwapChain();
-		_swapChain = Wrapper::SwapChain::create(_device, _commandPool, _window, _surface);
+		//ֻؽСصԴͼƬ/زͼƬFrameBufferԼFrameBufferCommandBuffer
+		//ִе֡ʹþԴȴ豸
+		auto oldSwapChain = _swapChain;
+		_swapChain = Wrapper::SwapChain::create(_device, _window, _surface, oldSwapChain);
 		_width = _swapChain->getExtent().width;
 		_height = _swapChain->getExtent().height;
-		_renderPass = Wrapper::RenderPass::create(_device);
-		createRenderPass();
+		retireSwapChain(oldSwapChain);
+
+		//render passpipelineֻŵĸʽʽ仯(細Ƶһָʽʾ)ʱؽ
+		if (_swapChain->getFormat() != oldSwapChain->getFormat()) {
+			_deletionQueue->push(_renderPass);
+			if (_pipeline) {
+				_deletionQueue->push(_pipeline);
+			}
+
+			_renderPass = Wrapper::RenderPass::create(_device);
+			createRenderPass();
+			_pipeline = Wrapper::Pipeline::create(_device, _renderPass, _pipelineCache);
+			createPipeline();
+
+			//ɵpipelineӳٶгУᱻƳ
+			_pipelineRegistry->purgeUnused();
+		}
+
 		_swapChain->createFrameBuffers(_renderPass);
-		_pipeline = Wrapper::Pipeline::create(_device, _renderPass);
-		createPipeline();
-		createCommandBuffers();
-		createSyncObjects();
 	}
 
-	void Application::cleanUpSwapChain() {
-		_swapChain.reset();
-		_commandBuffers.clear();
-		_pipeline.reset();
-		_renderPass.reset();
-		_imageAvailableSemaphores.clear();
-		_renderFinishedSemaphores.clear();
-		_fences.clear();
+	void Application::retireSwapChain(const Wrapper::SwapChain::Ptr& oldSwapChain) {
+		//ִе֡CommandBufferȻþɵFrameBufferӳٵЩִ֡Ϻ
+		//CommandBufferͬFrameContext潻仯
+		_deletionQueue->push(oldSwapChain);
 	}
 }
\ No newline at end of file
@@ -6,21 +6,36 @@
 #include "vulkan_wrapper/window.h"
 #include "vulkan_wrapper/window_surface.h"
 #include "vulkan_wrapper/swap_chain.h"
+#include "vulkan_wrapper/offscreen_target.h"
 #include "vulkan_wrapper/shader.h"
 #include "vulkan_wrapper/pipeline.h"
+#include "vulkan_wrapper/pipeline_cache.h"
+#include "vulkan_wrapper/pipeline_registry.h"
+#include "vulkan_wrapper/pipeline_compiler.h"
 #include "vulkan_wrapper/render_pass.h"
 #include "vulkan_wrapper/command_pool.h"
 #include "vulkan_wrapper/command_buffer.h"
 #include "vulkan_wrapper/semaphore.h"
-#include "vulkan_wrapper/fence.h"
+#include "vulkan_wrapper/submit_scheduler.h"
+#include "vulkan_wrapper/deletion_queue.h"
+#include "vulkan_wrapper/frame_context.h"
+#include "vulkan_wrapper/gpu_profiler.h"
 #include "vulkan_wrapper/buffer.h"
 #include "vulkan_wrapper/descriptor_set_layout.h"
 #include "vulkan_wrapper/descriptor_pool.h"
-#include "vulkan_wrapper/descriptor_set.h"
 #include "vulkan_wrapper/image.h"
 #include "vulkan_wrapper/sampler.h"
+#include "vulkan_wrapper/upload_manager.h"
 #include "uniform_manager.h"
 #include "texture/texture.h"
+#include "texture/texture_loader.h"
+#include "texture/texture_cache.h"
+#include "vulkan_wrapper/sampler_cache.h"
+#include "vulkan_wrapper/bindless_table.h"
+#include "thread_pool.h"
+#include "profiler.h"
+#include <functional>
+#include <chrono>
 
 
 #include "model.h"
@@ -30,6 +45,18 @@ namespace FF {
 
 	class Application :public std::enable_shared_from_this<Application> {
 	public:
+		//ͬʱִе֡2֡ʱCPU¼һ֡GPUִеǰ֡صٶӳ
+		static constexpr uint32_t DEFAULT_FRAMES_IN_FLIGHT = 2;
+
+		//RenderPassGPUʱregion
+		static constexpr const char* MAIN_PASS_REGION = "MainPass";
+
+		//bindlessģʽƬԪshadershaders/compile.batlessonShaderBindless.fragõ
+		static constexpr const char* BINDLESS_FRAGMENT_SHADER = "shaders/fs_bindless.spv";
+
+		//ÿ֡ʼʱãframeNumber0ʼ
+		using FrameCallback = std::function<void(uint64_t frameNumber, Camera& camera)>;
+
 		Application() = default;
 
 		~Application() = default;
@@ -39,6 +66,72 @@ namespace FF {
 		void onMouseMove(double xpos, double ypos);
 
 		void onKeyDown(Camera::CAMERA_MOVE moveDirection);
+
+		//run֮ǰã豸֧descriptor indexingûBINDLESS_FRAGMENT_SHADERʱȻʹͨbinding
+		void setBindlessEnabled(bool enabled) { _bindlessRequested = enabled; }
+
+		//run֮ǰã뽻ͼƬ޹
+		void setFramesInFlight(uint32_t count) { _framesInFlight = std::max(count, 1u); }
+
+		//run֮ǰãģͰcountΣﵽPARALLEL_RECORD_MIN_DRAWSʱбָ¼̲߳¼
+		void setInstanceCount(uint32_t count) { _instanceCount = std::max(count, 1u); }
+
+		//run֮ǰã¼ÿregionGPUʱperDrawΪtrueʱÿƵʱ
+		//historySizeΪÿregion֡Ҫ֡ʱ
+		void setGpuProfilingEnabled(
+			bool enabled, 
+			bool perDraw = false, 
+			uint32_t historySize = Wrapper::GpuProfiler::DEFAULT_HISTORY_SIZE
+		) {
+			_gpuProfilingRequested = enabled;
+			_gpuProfileDraws = enabled && perDraw;
+			_gpuProfileHistorySize = historySize;
+		}
+
+		//GPUʱÿframes֡ڿ̨һθregionĺʱ0Ϊ(Ĭ)
+		void setGpuProfileReportInterval(uint64_t frames) { _gpuProfileReportInterval = frames; }
+
+		/*
+		* run֮ǰã¼CPU׶κʱ˳ʱΪChrome trace(chrome://tracingui.perfetto.dev)
+		* ͬʱGPUʱGPUregionУ׼ͬһʱᣬһ֡CPUGPUƿ
+		*/
+		void setCpuProfilingEnabled(bool enabled, const std::string& tracePath = "trace.json") {
+			_cpuProfilingRequested = enabled;
+			_tracePath = tracePath;
+			CpuProfiler::getInstance().setEnabled(enabled);
+		}
+
+		/*
+		* run֮ǰã޴ģʽglfwڡsurface뽻ȾͼƬûʾĻ
+		* 1 ȾframeCount֮֡˳
+		* 2 readbackPathΪʱһ֡ĽCPU˳ʱΪPPM
+		*/
+		void setHeadless(bool enabled, uint32_t width, uint32_t height, uint64_t frameCount, const std::string& readbackPath = "") {
+			_headless = enabled;
+			_width = width;
+			_height = height;
+			_frameLimit = frameCount;
+			_readbackPath = readbackPath;
+		}
+
+		//run֮ǰãȾcount֮֡˳0Ϊƣдʱرմͬ˳
+		void setFrameLimit(uint64_t count) { _frameLimit = count; }
+
+		//run֮ǰãstep0ʱģʱÿ֡ǰstep룬ʵʺʱ޹أ0Ϊʹʵʱ
+		void setFixedTimeStep(double step) { _fixedTimeStep = step; }
+
+		void setFrameCallback(const FrameCallback& callback) { _frameCallback = callback; }
+
+		//GPU豸֧ʱŲΪ
+		[[nodiscard]] Wrapper::GpuProfiler::Ptr getGpuProfiler() const { return _gpuProfiler; }
+
+		[[nodiscard]] uint64_t getFrameNumber() const { return _frameNumber; }
+
+		//ڶûύ֡ţСЩ֡ûGPUʱ
+		[[nodiscard]] const std::vector<uint64_t>& getSkippedFrames() const { return _skippedFrames; }
+
+		//bindlessʱΪtruerun֮Ч
+		[[nodiscard]] bool isBindlessActive() const { return _bindlessTable != nullptr; }
 	private:
 		void initWindow();
 
@@ -48,23 +141,65 @@ namespace FF {
 
 		void render();
 
+		//޴ģʽһ֡Ⱦһ֡ӦͼƬȡͼƬҲʾ
+		void renderHeadless();
+
 		void cleanUp();
 
+		[[nodiscard]] bool shouldExit() const;
+
+		//֡ʱ¼ƵǷΪһ֡
+		[[nodiscard]] bool isLastFrame() const;
+
+		//̶ʱ֡ŵõΪmainLoopʼʵʱ
+		[[nodiscard]] double getSimulationTime() const;
+
 	private:
 		void createPipeline();
 
 		void createRenderPass();
 
-		void createCommandBuffers();
+		//ÿ֡ãɺлΪµpipelineʧʱ׳
+		void updatePipeline();
+
+		//ÿ֡ؽбӦuniform
+		void buildDrawList();
 
-		void createSyncObjects();
+		//ÿ֡¼ƣһ֡descriptorSetȾimageIndexӦFrameBuffer
+		//㹻ʱбзֵ̣߳¼ƶCommandBuffer
+		void recordCommandBuffer(const Wrapper::FrameContext::Ptr& frame, uint32_t imageIndex);
 
-		//ؽڴС仯ʱ򣬽ҲҪ仯Frame View Pipeline RenderPass Sync
+		void recordRenderPass(
+			const Wrapper::CommandBuffer::Ptr& commandBuffer, 
+			const Wrapper::FrameContext::Ptr& frame, 
+			uint32_t imageIndex
+		);
+
+		//¼ƻб[first, last)Ļƣ干
+		void recordDraws(const Wrapper::CommandBuffer::Ptr& commandBuffer, uint32_t frameIndex, size_t first, size_t last);
+
+		void createFrameContexts();
+
+		//ȾĿΪͼƬ
+		[[nodiscard]] VkFormat getColorFormat() const;
+
+		[[nodiscard]] VkFramebuffer getFrameBuffer(uint32_t imageIndex) const;
+
+		[[nodiscard]] VkExtent2D getRenderExtent() const;
+
+		void printGpuProfile();
+
+		//ؽڴС仯ʱ򣬽ҲҪ仯Frame ViewԼǵCommandBuffer
+		//ӿڼΪ̬״̬Pipeline RenderPassֻڽʽ仯ʱؽ
+		//ɵĽµĽ֣ȴ豸УԴӳٶ
 		void reCreateSwapChain();
 
-		void cleanUpSwapChain();
+		void retireSwapChain(const Wrapper::SwapChain::Ptr& oldSwapChain);
 
 	private:
+		//Ļֱ¼ƣ̵ַ߳Ŀ
+		static constexpr size_t PARALLEL_RECORD_MIN_DRAWS = 512;
+
 		unsigned int _width{ 800 };
 		unsigned int _height{ 600 };
 
@@ -72,23 +207,85 @@ namespace FF {
 		Wrapper::Window::Ptr _window{ nullptr };
 		Wrapper::Instance::Ptr _instance{ nullptr };
 		Wrapper::Device::Ptr _device{ nullptr };
+
+		//Ⱦύ(֡ϴ)һtimelineCPUȴԴնֵΪ׼
+		Wrapper::SubmitScheduler::Ptr _graphicScheduler{ nullptr };
 		Wrapper::WindowSurface::Ptr _surface{ nullptr };
 		Wrapper::SwapChain::Ptr _swapChain{ nullptr };
+
+		//޴ģʽ´windowsurface뽻
+		bool _headless{ false };
+		std::string _readbackPath{};
+		Wrapper::OffscreenTarget::Ptr _offscreenTarget{ nullptr };
+
+		//ʹõpipeline֮ǰΪfallbackûfallbackʱΪգֻ֡
 		Wrapper::Pipeline::Ptr _pipeline{ nullptr };
+		Wrapper::PipelineHandle::Ptr _pipelineHandle{ nullptr };
+		Wrapper::PipelineCache::Ptr _pipelineCache{ nullptr };
+		Wrapper::PipelineRegistry::Ptr _pipelineRegistry{ nullptr };
+		Wrapper::PipelineCompiler::Ptr _pipelineCompiler{ nullptr };
 		Wrapper::RenderPass::Ptr _renderPass{ nullptr };
-		Wrapper::CommandPool::Ptr _commandPool{ nullptr };
+		Wrapper::UploadManager::Ptr _uploadManager{ nullptr };
+
+		//롢߱Ⱥ̨
+		ThreadPool::Ptr _threadPool{ nullptr };
 
-		std::vector<Wrapper::CommandBuffer::Ptr> _commandBuffers{};
+		//ֻڲ¼ƣÿ֡ȴɣں̨
+		ThreadPool::Ptr _recordThreadPool{ nullptr };
+		Wrapper::SamplerCache::Ptr _samplerCache{ nullptr };
+		TextureCache::Ptr _textureCache{ nullptr };
+		TextureLoader::Ptr _textureLoader{ nullptr };
+
+		uint32_t _framesInFlight{ DEFAULT_FRAMES_IN_FLIGHT };
+		std::vector<Wrapper::FrameContext::Ptr> _frames{};
 
 		int _currentFrame{ 0 };
 
-		std::vector<Wrapper::Fence::Ptr> _fences{};
-		std::vector<Wrapper::Semaphore::Ptr> _imageAvailableSemaphores{};
-		std::vector<Wrapper::Semaphore::Ptr> _renderFinishedSemaphores{};
+		//ʼȾ֡
+		uint64_t _frameNumber{ 0 };
+		uint64_t _frameLimit{ 0 };
+		std::vector<uint64_t> _skippedFrames{};
+
+		double _fixedTimeStep{ 0.0 };
+		std::chrono::steady_clock::time_point _startTime{};
+
+		FrameCallback _frameCallback{};
+
+		//ִܱе֡ʹõԴڶӦfenceͷ
+		Wrapper::DeletionQueue::Ptr _deletionQueue{ nullptr };
 
 		UniformManager::Ptr _uniformManager{ nullptr };
 
+		bool _bindlessRequested{ false };
+		Wrapper::BindlessTable::Ptr _bindlessTable{ nullptr };
+
+		bool _gpuProfilingRequested{ false };
+		bool _gpuProfileDraws{ false };
+		uint32_t _gpuProfileHistorySize{ Wrapper::GpuProfiler::DEFAULT_HISTORY_SIZE };
+		uint64_t _gpuProfileReportInterval{ 0 };
+		Wrapper::GpuProfiler::Ptr _gpuProfiler{ nullptr };
+
+		//regionԤȵǼǵţiʹ_drawRegionIds[i]
+		uint32_t _mainPassRegionId{ Wrapper::GpuProfiler::INVALID_REGION };
+		std::vector<uint32_t> _drawRegionIds{};
+
+		//һ֡ΪԤĵһregioniд_firstDrawRegion + i
+		uint32_t _firstDrawRegion{ Wrapper::GpuProfiler::INVALID_REGION };
+
+		bool _cpuProfilingRequested{ false };
+		std::string _tracePath{};
+
 		Model::Ptr _model{ nullptr };
+		uint32_t _instanceCount{ 1 };
+
+		//һλƣģͣԼڱ֡uniformе±
+		struct DrawCommand {
+			Model::Ptr mModel{ nullptr };
+			uint32_t mObjectIndex{ 0 };
+		};
+		std::vector<DrawCommand> _drawList{};
+		std::vector<ObjectUniform> _objectUniforms{};
+
 		VPMatrices _vpMatrices;
 		Camera _camera;
 	};
@@ -0,0 +1,147 @@
+#include "benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+
+namespace FF {
+
+	static void writeStats(std::ofstream& file, const FrameTimeStats& stats) {
+		file << "{\"samples\":" << stats.mSampleCount
+			<< ",\"minMs\":" << stats.mMinMs
+			<< ",\"avgMs\":" << stats.mAvgMs
+			<< ",\"p50Ms\":" << stats.mP50Ms
+			<< ",\"p95Ms\":" << stats.mP95Ms
+			<< ",\"p99Ms\":" << stats.mP99Ms
+			<< ",\"maxMs\":" << stats.mMaxMs << "}";
+	}
+
+	Benchmark::Benchmark(const BenchmarkConfig& config) {
+		_config = config;
+		_config.mFramesInFlight = std::max(_config.mFramesInFlight, 1u);
+	}
+
+	void Benchmark::run() {
+		_cpuFrameTimes.clear();
+		_cpuFrameTimes.reserve(_config.mFrameCount);
+		_renderedFrameCount = 0;
+
+		//һ֡GPUʱҪframeCount֮֡Ŷ
+		uint64_t totalFrames = _config.mWarmupFrames + _config.mFrameCount + _config.mFramesInFlight;
+
+		_application = std::make_shared<Application>();
+		_application->setHeadless(_config.mHeadless, _config.mWidth, _config.mHeight, totalFrames);
+		_application->setFramesInFlight(_config.mFramesInFlight);
+		_application->setInstanceCount(_config.mInstanceCount);
+		_application->setBindlessEnabled(_config.mBindless);
+		_application->setFixedTimeStep(_config.mFixedTimeStep);
+		_application->setGpuProfilingEnabled(true, false, static_cast<uint32_t>(totalFrames));
+		_application->setGpuProfileReportInterval(0);
+		if (!_config.mTracePath.empty()) {
+			_application->setCpuProfilingEnabled(true, _config.mTracePath);
+		}
+		_application->setFrameCallback([this](uint64_t frameNumber, Camera& camera) {
+			onFrame(frameNumber, camera);
+		});
+
+		_application->run();
+		_bindlessActive = _application->isBindlessActive();
+
+		//ǰرʱͳѾɵĲ
+		_cpuStats = FrameTimeStats::compute(_cpuFrameTimes);
+
+		auto gpuProfiler = _application->getGpuProfiler();
+		_hasGpuStats = gpuProfiler && gpuProfiler->isSupported();
+		if (_hasGpuStats) {
+			uint64_t first = _config.mWarmupFrames;
+			uint64_t last = _config.mWarmupFrames + _config.mFrameCount;
+
+			std::vector<double> samples{};
+			for (const auto& sample : gpuProfiler->getSamples(Application::MAIN_PASS_REGION)) {
+				if (sample.mFrameNumber >= first && sample.mFrameNumber < last) {
+					samples.push_back(sample.mMs);
+				}
+			}
+
+			//һ֡GPUʱͬһFrameContextһ¼ʱأҲ֮framesInFlightύ֡
+			//framesInFlightύ֡֡ûύҲûн
+			const auto& skipped = _application->getSkippedFrames();
+			uint64_t submittedCount = _renderedFrameCount - std::min<uint64_t>(skipped.size(), _renderedFrameCount);
+			uint64_t collectedCount = submittedCount > _config.mFramesInFlight ? submittedCount - _config.mFramesInFlight : 0;
+
+			uint64_t expected = 0;
+			uint64_t submittedIndex = 0;
+			for (uint64_t frameNumber = 0; frameNumber < _renderedFrameCount && submittedIndex < collectedCount; ++frameNumber) {
+				if (std::binary_search(skipped.begin(), skipped.end(), frameNumber)) {
+					continue;
+				}
+				if (frameNumber >= first && frameNumber < last) {
+					++expected;
+				}
+				++submittedIndex;
+			}
+
+			if (samples.size() != expected) {
+				throw std::runtime_error(
+					"Error: expected " + std::to_string(expected) + " GPU frame samples, got " + std::to_string(samples.size())
+				);
+			}
+			_gpuStats = FrameTimeStats::compute(samples);
+		}
+
+		_application.reset();
+	}
+
+	void Benchmark::onFrame(uint64_t frameNumber, Camera& camera) {
+		auto now = std::chrono::steady_clock::now();
+		_renderedFrameCount = frameNumber + 1;
+
+		//frameNumber֡ʼʱframeNumber - 1֡
+		uint64_t first = _config.mWarmupFrames;
+		uint64_t last = _config.mWarmupFrames + _config.mFrameCount;
+		if (frameNumber > first && frameNumber <= last) {
+			_cpuFrameTimes.push_back(std::chrono::duration<double, std::milli>(now - _lastFrameStart).count());
+		}
+		_lastFrameStart = now;
+
+		updateCamera(frameNumber, camera);
+	}
+
+	void Benchmark::updateCamera(uint64_t frameNumber, Camera& camera) {
+		float angle = 2.0f * glm::pi<float>() * static_cast<float>(frameNumber % CAMERA_PATH_FRAMES) / CAMERA_PATH_FRAMES;
+
+		//ģǰҡ°ڶǰʼտԭ
+		glm::vec3 position(0.8f * std::sin(angle), 0.5f * std::sin(2.0f * angle), 3.0f + 0.5f * std::cos(angle));
+		camera.lookAt(position, glm::normalize(-position), glm::vec3(0.0f, 1.0f, 0.0f));
+	}
+
+	bool Benchmark::writeReport(const std::string& path) const {
+		std::ofstream file(path, std::ios::out | std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+
+		file << "{\n";
+		file << "  \"frames\": " << _config.mFrameCount << ",\n";
+		file << "  \"warmupFrames\": " << _config.mWarmupFrames << ",\n";
+		file << "  \"width\": " << _config.mWidth << ",\n";
+		file << "  \"height\": " << _config.mHeight << ",\n";
+		file << "  \"headless\": " << (_config.mHeadless ? "true" : "false") << ",\n";
+		file << "  \"framesInFlight\": " << _config.mFramesInFlight << ",\n";
+		file << "  \"instances\": " << _config.mInstanceCount << ",\n";
+		file << "  \"bindless\": " << (_bindlessActive ? "true" : "false") << ",\n";
+		file << "  \"fixedTimeStep\": " << _config.mFixedTimeStep << ",\n";
+		file << "  \"cpuFrameTime\": ";
+		writeStats(file, _cpuStats);
+		file << ",\n";
+		file << "  \"gpuFrameTime\": ";
+		if (_hasGpuStats) {
+			writeStats(file, _gpuStats);
+		}
+		else {
+			file << "null";
+		}
+		file << "\n}" << std::endl;
+
+		return static_cast<bool>(file);
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "../base.h"
+#include "../application.h"
+#include "frame_time_stats.h"
+
+namespace FF {
+
+	struct BenchmarkConfig {
+		//ͳƵ֡
+		uint64_t mFrameCount{ 1000 };
+
+		//Ԥ֡ߡȶ֮ǰ֡ͳ
+		uint64_t mWarmupFrames{ 100 };
+
+		uint32_t mWidth{ 1280 };
+		uint32_t mHeight{ 720 };
+		bool mHeadless{ true };
+
+		//0ʱģͶʹù̶ÿȾĻȫͬ
+		double mFixedTimeStep{ 1.0 / 60.0 };
+
+		uint32_t mFramesInFlight{ Application::DEFAULT_FRAMES_IN_FLIGHT };
+
+		//ģ͵Ļƴʱ߳¼
+		uint32_t mInstanceCount{ 1 };
+
+		//bindlessʱ˻ͨbindingм¼ʵʹõģʽ
+		bool mBindless{ false };
+
+		std::string mReportPath{ "bench_report.json" };
+
+		//ΪʱͬʱCPU/GPUChrome trace
+		std::string mTracePath{};
+	};
+
+	/*
+	* ظȾ׼
+	* 1 ع̶·˶λֻ֡žϹ̶ÿеĳ뻭һ
+	* 2 CPU֡ʱΪ֡ʼ֮ļȴGPUʱ䣬Ҳʵʵ֡ʱ
+	* 3 GPUʱΪRenderPassʱGPUʱframesInFlight֡ӳ٣Ⱦ⼸֤֡ÿһ֡أ
+	*   ֡ɸѡģʽ½֡ԤڣصԤڲһʱrun׳쳣
+	* 4 GPUֻڽͳƣдӡ(ApplicationĬϹرprintGpuProfile)
+	* 5 дjsonͬ汾ֱ֮ӶԱ
+	*/
+	class Benchmark {
+	public:
+		using Ptr = std::shared_ptr<Benchmark>;
+
+		//·һڵ֡
+		static constexpr uint64_t CAMERA_PATH_FRAMES = 600;
+
+		static Ptr create(const BenchmarkConfig& config) {
+			return std::make_shared<Benchmark>(config);
+		}
+
+		Benchmark(const BenchmarkConfig& config);
+
+		~Benchmark() = default;
+
+		void run();
+
+		//ʧʱfalse
+		bool writeReport(const std::string& path) const;
+
+		[[nodiscard]] const FrameTimeStats& getCpuStats() const { return _cpuStats; }
+
+		[[nodiscard]] const FrameTimeStats& getGpuStats() const { return _gpuStats; }
+
+		[[nodiscard]] bool hasGpuStats() const { return _hasGpuStats; }
+
+	private:
+		void onFrame(uint64_t frameNumber, Camera& camera);
+
+		static void updateCamera(uint64_t frameNumber, Camera& camera);
+
+	private:
+		BenchmarkConfig _config{};
+		std::shared_ptr<Application> _application{ nullptr };
+
+		//ʵȾ֡ǰرʱСõ֡
+		uint64_t _renderedFrameCount{ 0 };
+
+		std::chrono::steady_clock::time_point _lastFrameStart{};
+		std::vector<double> _cpuFrameTimes{};
+
+		FrameTimeStats _cpuStats{};
+		FrameTimeStats _gpuStats{};
+		bool _hasGpuStats{ false };
+
+		bool _bindlessActive{ false };
+	};
+}
@@ -0,0 +1,36 @@
+#include "frame_time_stats.h"
+#include <algorithm>
+#include <cmath>
+
+namespace FF {
+
+	//ȷp[0, 1]֮
+	static double percentile(const std::vector<double>& sorted, double p) {
+		size_t index = static_cast<size_t>(std::ceil(p * sorted.size()));
+		index = std::min(std::max(index, static_cast<size_t>(1)), sorted.size()) - 1;
+		return sorted[index];
+	}
+
+	FrameTimeStats FrameTimeStats::compute(std::vector<double> samples) {
+		FrameTimeStats stats{};
+		if (samples.empty()) {
+			return stats;
+		}
+
+		std::sort(samples.begin(), samples.end());
+		stats.mSampleCount = samples.size();
+		stats.mMinMs = samples.front();
+		stats.mMaxMs = samples.back();
+
+		double sum = 0.0;
+		for (double sample : samples) {
+			sum += sample;
+		}
+		stats.mAvgMs = sum / samples.size();
+
+		stats.mP50Ms = percentile(samples, 0.50);
+		stats.mP95Ms = percentile(samples, 0.95);
+		stats.mP99Ms = percentile(samples, 0.99);
+		return stats;
+	}
+}
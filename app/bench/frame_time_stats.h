@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace FF {
+
+	//һ֡ʱͳƣλ
+	struct FrameTimeStats {
+		double mMinMs{ 0.0 };
+		double mAvgMs{ 0.0 };
+		double mP50Ms{ 0.0 };
+		double mP95Ms{ 0.0 };
+		double mP99Ms{ 0.0 };
+		double mMaxMs{ 0.0 };
+		uint64_t mSampleCount{ 0 };
+
+		//ٷλʹȷȡceil(p * n)
+		static FrameTimeStats compute(std::vector<double> samples);
+	};
+}
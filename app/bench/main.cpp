@@ -0,0 +1,81 @@
+#include <iostream>
+#include "benchmark.h"
+
+/*
+* bench [--frames N] [--warmup N] [--width W] [--height H] [--frames-in-flight N]
+*       [--instances N] [--bindless] [--windowed] [--realtime] [--report path] [--trace path]
+* Ĭ޴ڡ̶дbench_report.json
+*/
+static FF::BenchmarkConfig parseArguments(int argc, char** argv) {
+	FF::BenchmarkConfig config{};
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "--windowed") {
+			config.mHeadless = false;
+		}
+		else if (arg == "--bindless") {
+			config.mBindless = true;
+		}
+		else if (arg == "--realtime") {
+			config.mFixedTimeStep = 0.0;
+		}
+		else if (arg == "--frames" && hasValue) {
+			config.mFrameCount = std::stoull(argv[++i]);
+		}
+		else if (arg == "--warmup" && hasValue) {
+			config.mWarmupFrames = std::stoull(argv[++i]);
+		}
+		else if (arg == "--width" && hasValue) {
+			config.mWidth = static_cast<uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (arg == "--height" && hasValue) {
+			config.mHeight = static_cast<uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (arg == "--frames-in-flight" && hasValue) {
+			config.mFramesInFlight = static_cast<uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (arg == "--instances" && hasValue) {
+			config.mInstanceCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (arg == "--report" && hasValue) {
+			config.mReportPath = argv[++i];
+		}
+		else if (arg == "--trace" && hasValue) {
+			config.mTracePath = argv[++i];
+		}
+		else {
+			throw std::runtime_error("Error: unknown argument " + arg);
+		}
+	}
+	return config;
+}
+
+int main(int argc, char** argv) {
+	try {
+		auto config = parseArguments(argc, argv);
+		auto benchmark = FF::Benchmark::create(config);
+		benchmark->run();
+
+		if (!benchmark->writeReport(config.mReportPath)) {
+			std::cout << "Error: failed to write report " << config.mReportPath << std::endl;
+			return 1;
+		}
+
+		const auto& cpu = benchmark->getCpuStats();
+		std::cout << "CPU frame (ms)  p50 " << cpu.mP50Ms << "  p95 " << cpu.mP95Ms
+			<< "  p99 " << cpu.mP99Ms << "  max " << cpu.mMaxMs << std::endl;
+		if (benchmark->hasGpuStats()) {
+			const auto& gpu = benchmark->getGpuStats();
+			std::cout << "GPU frame (ms)  p50 " << gpu.mP50Ms << "  p95 " << gpu.mP95Ms
+				<< "  p99 " << gpu.mP99Ms << "  max " << gpu.mMaxMs << std::endl;
+		}
+	}
+	catch (const std::exception& e) {
+		std::cout << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
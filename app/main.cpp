@@ -1,8 +1,25 @@
 #include <iostream>
 #include "application.h"
 
-int main() {
+int main(int argc, char** argv) {
 	std::shared_ptr<FF::Application> app = std::make_shared<FF::Application>();
+
+	//--headlessڣȾ300֡һ֡Ϊheadless.ppm
+	//--instances NģͻNΣʱʹö߳¼
+	//--bindlessʹbindless豸ֻ֧ûбfs_bindless.spvʱʹͨbinding
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--headless") {
+			app->setHeadless(true, 800, 600, 300, "headless.ppm");
+		}
+		else if (arg == "--bindless") {
+			app->setBindlessEnabled(true);
+		}
+		else if (arg == "--instances" && i + 1 < argc) {
+			app->setInstanceCount(static_cast<uint32_t>(std::stoul(argv[++i])));
+		}
+	}
+
 	try {
 		app->run();
 	}
@@ -3,6 +3,7 @@
 #include "base.h"
 #include "vulkan_wrapper/buffer.h"
 #include "vulkan_wrapper/device.h"
+#include "vulkan_wrapper/upload_manager.h"
 
 namespace FF {
 
@@ -15,11 +16,11 @@ namespace FF {
 	class Model {
 	public:
 		using Ptr = std::shared_ptr<Model>;
-		static Ptr create(const Wrapper::Device::Ptr& device) { 
-			return std::make_shared<Model>(device);
+		static Ptr create(const Wrapper::Device::Ptr& device, const Wrapper::UploadManager::Ptr& uploadManager) { 
+			return std::make_shared<Model>(device, uploadManager);
 		}
 
-		Model(const Wrapper::Device::Ptr& device) {
+		Model(const Wrapper::Device::Ptr& device, const Wrapper::UploadManager::Ptr& uploadManager) {
 
 			/*mData = {
 				{{0.0f,-0.5f,0.0f},{1.0f,0.0f,0.0f}},
@@ -69,10 +70,10 @@ namespace FF {
 			};
 
 			//mVertexBuffer = Wrapper::Buffer::createVertexBuffer(device, mData.size() * sizeof(Vertex), mData.data());
-			mPositionBuffer = Wrapper::Buffer::createVertexBuffer(device, mPositions.size() * sizeof(glm::vec3), mPositions.data());
-			mColorBuffer = Wrapper::Buffer::createVertexBuffer(device, mColors.size() * sizeof(glm::vec3), mColors.data());
-			mIndexBuffer = Wrapper::Buffer::createIndexBuffer(device, mIndexData.size() * sizeof(float), mIndexData.data());
-			mUVBuffer = Wrapper::Buffer::createVertexBuffer(device, mUVs.size() * sizeof(glm::vec2), mUVs.data());
+			mPositionBuffer = Wrapper::Buffer::createVertexBuffer(device, uploadManager, mPositions.size() * sizeof(glm::vec3), mPositions.data());
+			mColorBuffer = Wrapper::Buffer::createVertexBuffer(device, uploadManager, mColors.size() * sizeof(glm::vec3), mColors.data());
+			mIndexBuffer = Wrapper::Buffer::createIndexBuffer(device, uploadManager, mIndexData.size() * sizeof(float), mIndexData.data());
+			mUVBuffer = Wrapper::Buffer::createVertexBuffer(device, uploadManager, mUVs.size() * sizeof(glm::vec2), mUVs.data());
 		}
 		~Model() {
 
@@ -128,9 +129,10 @@ namespace FF {
 
 		void setModelMatrix(const glm::mat4 matrix) { mUniform.mModelMatrix = matrix; }
 
-		void update() {
+		//timeΪģʱ()Application̶ʱÿеĽͬ
+		void update(double time) {
 			glm::mat4 rotateMatrix = glm::mat4(1.0f);
-			rotateMatrix = glm::rotate(rotateMatrix, float(glfwGetTime() / 3.14), glm::vec3(0.0f, 0.0f, 1.0f));
+			rotateMatrix = glm::rotate(rotateMatrix, float(time / 3.14), glm::vec3(0.0f, 0.0f, 1.0f));
 			mUniform.mModelMatrix = rotateMatrix;
 		}
 
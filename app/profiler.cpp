@@ -0,0 +1,132 @@
+#include "profiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+
+namespace FF {
+
+	static void writeJsonString(std::ofstream& file, const std::string& value) {
+		file << '"';
+		for (char c : value) {
+			if (c == '"' || c == '\\') {
+				file << '\\' << c;
+			}
+			else if (static_cast<unsigned char>(c) < 0x20) {
+				file << ' ';
+			}
+			else {
+				file << c;
+			}
+		}
+		file << '"';
+	}
+
+	//traceеʱ䵥λΪ΢룬밴λСdouble
+	static void writeMicroseconds(std::ofstream& file, uint64_t ns) {
+		file << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000;
+	}
+
+	static void writeCompleteEvent(std::ofstream& file, const std::string& name, uint64_t beginNs, uint64_t endNs, uint64_t epochNs, uint32_t pid, uint32_t tid) {
+		file << "{\"name\":";
+		writeJsonString(file, name);
+		file << ",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << tid << ",\"ts\":";
+		writeMicroseconds(file, beginNs - epochNs);
+		file << ",\"dur\":";
+		writeMicroseconds(file, endNs > beginNs ? endNs - beginNs : 0);
+		file << "}";
+	}
+
+	CpuProfiler& CpuProfiler::getInstance() {
+		static CpuProfiler instance;
+		return instance;
+	}
+
+	CpuProfiler::ThreadBuffer& CpuProfiler::getThreadBuffer() {
+		//߳˳󻺳ȻɷУʱʵѾͷŵڴ
+		thread_local std::shared_ptr<ThreadBuffer> buffer{ nullptr };
+		if (!buffer) {
+			buffer = std::make_shared<ThreadBuffer>();
+			buffer->mEvents.resize(RING_SIZE);
+
+			std::lock_guard<std::mutex> lock(_mutex);
+			buffer->mThreadId = static_cast<uint32_t>(_threadBuffers.size());
+			_threadBuffers.push_back(buffer);
+		}
+		return *buffer;
+	}
+
+	void CpuProfiler::record(const char* name, uint64_t beginNs, uint64_t endNs) {
+		auto& buffer = getThreadBuffer();
+		uint64_t head = buffer.mHead.load(std::memory_order_relaxed);
+
+		auto& event = buffer.mEvents[head % RING_SIZE];
+		event.mName = name;
+		event.mBeginNs = beginNs;
+		event.mEndNs = endNs;
+
+		buffer.mHead.store(head + 1, std::memory_order_release);
+	}
+
+	void CpuProfiler::addGpuEvent(const std::string& name, uint64_t beginNs, uint64_t endNs) {
+		if (!isEnabled()) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		GpuEvent event{};
+		event.mName = name;
+		event.mBeginNs = beginNs;
+		event.mEndNs = endNs;
+		_gpuEvents.push_back(event);
+		while (_gpuEvents.size() > MAX_GPU_EVENTS) {
+			_gpuEvents.pop_front();
+		}
+	}
+
+	void CpuProfiler::writeChromeTrace(const std::string& path) {
+		std::ofstream file(path, std::ios::out | std::ios::trunc);
+		if (!file) {
+			throw std::runtime_error("Error: failed to write trace " + path);
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		//¼Ϊtrace0
+		uint64_t epochNs = UINT64_MAX;
+		for (const auto& buffer : _threadBuffers) {
+			uint64_t head = buffer->mHead.load(std::memory_order_acquire);
+			uint64_t first = head > RING_SIZE ? head - RING_SIZE : 0;
+			for (uint64_t i = first; i < head; ++i) {
+				epochNs = std::min(epochNs, buffer->mEvents[i % RING_SIZE].mBeginNs);
+			}
+		}
+		for (const auto& event : _gpuEvents) {
+			epochNs = std::min(epochNs, event.mBeginNs);
+		}
+
+		//pid 1ΪCPUÿ߳һtidpid 2ΪGPU
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"CPU\"}},";
+		file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"args\":{\"name\":\"GPU\"}}";
+
+		for (const auto& buffer : _threadBuffers) {
+			uint64_t head = buffer->mHead.load(std::memory_order_acquire);
+			uint64_t first = head > RING_SIZE ? head - RING_SIZE : 0;
+			for (uint64_t i = first; i < head; ++i) {
+				const auto& event = buffer->mEvents[i % RING_SIZE];
+				file << ",";
+				writeCompleteEvent(file, event.mName, event.mBeginNs, event.mEndNs, epochNs, 1, buffer->mThreadId);
+			}
+		}
+
+		for (const auto& event : _gpuEvents) {
+			file << ",";
+			writeCompleteEvent(file, event.mName, event.mBeginNs, event.mEndNs, epochNs, 2, 0);
+		}
+
+		file << "]}" << std::endl;
+		if (!file) {
+			throw std::runtime_error("Error: failed to write trace " + path);
+		}
+	}
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <deque>
+
+namespace FF {
+
+	/*
+	* CPU˷ֶμʱChrome/PerfettoԴ򿪵json trace(chrome://tracing  ui.perfetto.dev)
+	* 1 ÿ߳һλ壬ֻб߳д룬д벻д󸲸¼
+	* 2 ̵߳һμ¼ʱԼĻǼǵֻһ
+	* 3 ʱʹsteady_clockλ룻δʱzoneֻȡһοأȡʱ
+	* 4 GPUregionʱУ׼㵽ͬһʱͨaddGpuEvent룬traceзڵGPU
+	* 5 ʱ߳̿д룬ڱǵ¼ܲ׼ȷֹͣȾ󵼳
+	* 6 ʱ¼Ϊ0㣬λ΢룬λСʱҲɿѧ
+	*/
+	class CpuProfiler {
+	public:
+		//ÿ̻߳λе¼
+		static constexpr size_t RING_SIZE = 1 << 16;
+
+		//GPU¼
+		static constexpr size_t MAX_GPU_EVENTS = 1 << 16;
+
+		static CpuProfiler& getInstance();
+
+		[[nodiscard]] static uint64_t now() {
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		void setEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+
+		[[nodiscard]] bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+		//nameҪַָֻ
+		void record(const char* name, uint64_t beginNs, uint64_t endNs);
+
+		//GPU¼ʱҪѾ㵽now()ʱ
+		void addGpuEvent(const std::string& name, uint64_t beginNs, uint64_t endNs);
+
+		//ΪChrome traceʽjsonļ޷дʱ׳쳣
+		void writeChromeTrace(const std::string& path);
+
+	private:
+		CpuProfiler() = default;
+
+		struct Event {
+			const char* mName{ nullptr };
+			uint64_t mBeginNs{ 0 };
+			uint64_t mEndNs{ 0 };
+		};
+
+		struct ThreadBuffer {
+			uint32_t mThreadId{ 0 };
+			std::vector<Event> mEvents{};
+
+			//Ѿд¼ֻȡģõλеλ
+			std::atomic<uint64_t> mHead{ 0 };
+		};
+
+		struct GpuEvent {
+			std::string mName{};
+			uint64_t mBeginNs{ 0 };
+			uint64_t mEndNs{ 0 };
+		};
+
+		ThreadBuffer& getThreadBuffer();
+
+	private:
+		std::atomic<bool> _enabled{ false };
+
+		//Ǽ̻߳GPU¼
+		std::mutex _mutex;
+		std::vector<std::shared_ptr<ThreadBuffer>> _threadBuffers{};
+		std::deque<GpuEvent> _gpuEvents{};
+	};
+
+	//ʱʱȡʼʱ䣬ʱ¼
+	class CpuZone {
+	public:
+		explicit CpuZone(const char* name) {
+			if (CpuProfiler::getInstance().isEnabled()) {
+				_name = name;
+				_beginNs = CpuProfiler::now();
+			}
+		}
+
+		~CpuZone() {
+			if (_name != nullptr) {
+				CpuProfiler::getInstance().record(_name, _beginNs, CpuProfiler::now());
+			}
+		}
+
+		CpuZone(const CpuZone&) = delete;
+		CpuZone& operator=(const CpuZone&) = delete;
+
+	private:
+		const char* _name{ nullptr };
+		uint64_t _beginNs{ 0 };
+	};
+}
+
+#define FF_PROFILE_CONCAT_INNER(a, b) a##b
+#define FF_PROFILE_CONCAT(a, b) FF_PROFILE_CONCAT_INNER(a, b)
+
+//ڵǰڼʱnameΪַ
+#define FF_PROFILE_ZONE(name) FF::CpuZone FF_PROFILE_CONCAT(_ffProfileZone, __LINE__)(name)
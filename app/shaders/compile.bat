@@ -1,4 +1,5 @@
 D:\Vulkan\Bin\glslangValidator.exe -V lessonShader.vert -o vs.spv
 D:\Vulkan\Bin\glslangValidator.exe -V lessonShader.frag -o fs.spv
+D:\Vulkan\Bin\glslangValidator.exe -V --target-env vulkan1.2 lessonShaderBindless.frag -o fs_bindless.spv
 
 pause
\ No newline at end of file
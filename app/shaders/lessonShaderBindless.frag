@@ -0,0 +1,33 @@
+#version 460 core
+
+#extension GL_ARB_separate_shader_objects:enable
+#extension GL_EXT_nonuniform_qualifier:enable
+
+layout(location=0) in vec3 inColor;
+layout(location=1) in vec2 inUV;
+
+layout(location=0) out vec4 outColor;
+
+//same layout as FF::Wrapper::MaterialRecord
+struct MaterialRecord{
+	uint mBaseColorTexture;
+	uint mPadding0;
+	uint mPadding1;
+	uint mPadding2;
+	vec4 mBaseColorFactor;
+};
+
+layout(std430,set=1,binding=0) readonly buffer Materials{
+	MaterialRecord records[];
+}materials;
+
+layout(set=1,binding=1) uniform sampler2D textures[];
+
+layout(push_constant) uniform PushConstants{
+	uint mMaterialIndex;
+}pc;
+
+void main(){
+	MaterialRecord material = materials.records[pc.mMaterialIndex];
+	outColor = texture(textures[nonuniformEXT(material.mBaseColorTexture)],inUV) * material.mBaseColorFactor;
+}
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include "ktx2.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace FF {
+
+	namespace {
+		struct Ktx2Header {
+			uint8_t mIdentifier[12];
+			uint32_t mVkFormat;
+			uint32_t mTypeSize;
+			uint32_t mPixelWidth;
+			uint32_t mPixelHeight;
+			uint32_t mPixelDepth;
+			uint32_t mLayerCount;
+			uint32_t mFaceCount;
+			uint32_t mLevelCount;
+			uint32_t mSupercompressionScheme;
+
+			//index
+			uint32_t mDfdByteOffset;
+			uint32_t mDfdByteLength;
+			uint32_t mKvdByteOffset;
+			uint32_t mKvdByteLength;
+			uint64_t mSgdByteOffset;
+			uint64_t mSgdByteLength;
+		};
+		static_assert(sizeof(Ktx2Header) == 80, "KTX2 header must be 80 bytes");
+
+		struct Ktx2LevelIndex {
+			uint64_t mByteOffset;
+			uint64_t mByteLength;
+			uint64_t mUncompressedByteLength;
+		};
+
+		//khr_df.hõĳ
+		constexpr uint8_t KHR_DF_MODEL_RGBSDA = 1;
+		constexpr uint8_t KHR_DF_MODEL_BC1A = 128;
+		constexpr uint8_t KHR_DF_MODEL_BC5 = 132;
+		constexpr uint8_t KHR_DF_MODEL_BC7 = 134;
+		constexpr uint8_t KHR_DF_PRIMARIES_BT709 = 1;
+		constexpr uint8_t KHR_DF_TRANSFER_LINEAR = 1;
+		constexpr uint8_t KHR_DF_TRANSFER_SRGB = 2;
+		constexpr uint8_t KHR_DF_CHANNEL_RED = 0;
+		constexpr uint8_t KHR_DF_CHANNEL_GREEN = 1;
+		constexpr uint8_t KHR_DF_CHANNEL_BLUE = 2;
+		constexpr uint8_t KHR_DF_CHANNEL_ALPHA = 15;
+		constexpr uint8_t KHR_DF_SAMPLE_DATATYPE_LINEAR = 0x10;
+
+		bool isSrgb(VkFormat format) {
+			return format == VK_FORMAT_BC1_RGB_SRGB_BLOCK ||
+				format == VK_FORMAT_BC1_RGBA_SRGB_BLOCK ||
+				format == VK_FORMAT_BC7_SRGB_BLOCK ||
+				format == VK_FORMAT_R8G8B8A8_SRGB;
+		}
+
+		template<typename T>
+		void append(std::vector<uint8_t>& out, T value) {
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+			out.insert(out.end(), bytes, bytes + sizeof(T));
+		}
+
+		size_t alignUp(size_t value, size_t alignment) {
+			return (value + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	bool Ktx2::isKtx2File(const std::string& path) {
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			return false;
+		}
+
+		uint8_t identifier[12]{};
+		file.read(reinterpret_cast<char*>(identifier), sizeof(identifier));
+		return file.gcount() == sizeof(identifier) && memcmp(identifier, IDENTIFIER, sizeof(identifier)) == 0;
+	}
+
+	Ktx2Image Ktx2::load(const std::string& path) {
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file) {
+			throw std::runtime_error("Error: failed to open ktx2 file " + path);
+		}
+		const uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+		file.seekg(0);
+
+		Ktx2Header header{};
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (file.gcount() != sizeof(header) || memcmp(header.mIdentifier, IDENTIFIER, sizeof(IDENTIFIER)) != 0) {
+			throw std::runtime_error("Error: invalid ktx2 identifier " + path);
+		}
+
+		if (header.mSupercompressionScheme != 0) {
+			throw std::runtime_error("Error: supercompressed ktx2 is not supported " + path);
+		}
+
+		if (header.mPixelDepth > 1 || header.mLayerCount > 1 || header.mFaceCount != 1) {
+			throw std::runtime_error("Error: only 2D ktx2 textures are supported " + path);
+		}
+
+		if (header.mVkFormat == VK_FORMAT_UNDEFINED || header.mLevelCount == 0) {
+			throw std::runtime_error("Error: ktx2 file needs a vkFormat and precomputed mipmaps " + path);
+		}
+
+		auto format = static_cast<VkFormat>(header.mVkFormat);
+		uint32_t blockBytes = getBlockBytes(format);
+		if (blockBytes == 0) {
+			throw std::runtime_error("Error: unsupported ktx2 format " + path);
+		}
+
+		if (header.mPixelWidth == 0) {
+			throw std::runtime_error("Error: invalid ktx2 size " + path);
+		}
+		uint32_t width = header.mPixelWidth;
+		uint32_t height = std::max(header.mPixelHeight, 1u);
+
+		//ܳmipmap߳levelCount - 1λ֮ȻΪ1
+		if (header.mLevelCount > 32 || (std::max(width, height) >> (header.mLevelCount - 1)) == 0) {
+			throw std::runtime_error("Error: invalid ktx2 level count " + path);
+		}
+
+		uint64_t indexEnd = sizeof(Ktx2Header) + sizeof(Ktx2LevelIndex) * static_cast<uint64_t>(header.mLevelCount);
+		if (indexEnd > fileSize) {
+			throw std::runtime_error("Error: truncated ktx2 level index " + path);
+		}
+
+		std::vector<Ktx2LevelIndex> levelIndices(header.mLevelCount);
+		file.read(reinterpret_cast<char*>(levelIndices.data()), sizeof(Ktx2LevelIndex) * levelIndices.size());
+		if (!file) {
+			throw std::runtime_error("Error: failed to read ktx2 level index " + path);
+		}
+
+		//ÿһǽеĿݣλlevel index֮ļ֮
+		uint32_t blockDimension = getBlockDimension(format);
+		for (uint32_t i = 0; i < header.mLevelCount; ++i) {
+			const auto& level = levelIndices[i];
+			uint64_t blocksX = (std::max(width >> i, 1u) + blockDimension - 1) / blockDimension;
+			uint64_t blocksY = (std::max(height >> i, 1u) + blockDimension - 1) / blockDimension;
+			if (level.mByteLength != blocksX * blocksY * blockBytes) {
+				throw std::runtime_error("Error: invalid ktx2 level size " + path);
+			}
+			if (level.mByteOffset < indexEnd || level.mByteOffset > fileSize || level.mByteLength > fileSize - level.mByteOffset) {
+				throw std::runtime_error("Error: ktx2 level data out of range " + path);
+			}
+		}
+
+		//мļһΣζ
+		uint64_t begin = UINT64_MAX;
+		uint64_t end = 0;
+		for (const auto& level : levelIndices) {
+			begin = std::min(begin, level.mByteOffset);
+			end = std::max(end, level.mByteOffset + level.mByteLength);
+		}
+
+		Ktx2Image image;
+		image.mFormat = format;
+		image.mWidth = width;
+		image.mHeight = height;
+		image.mData.resize(static_cast<size_t>(end - begin));
+
+		file.seekg(static_cast<std::streamoff>(begin));
+		file.read(reinterpret_cast<char*>(image.mData.data()), static_cast<std::streamsize>(image.mData.size()));
+		if (!file) {
+			throw std::runtime_error("Error: failed to read ktx2 level data " + path);
+		}
+
+		image.mLevels.resize(header.mLevelCount);
+		for (uint32_t i = 0; i < header.mLevelCount; ++i) {
+			image.mLevels[i].mOffset = static_cast<size_t>(levelIndices[i].mByteOffset - begin);
+			image.mLevels[i].mSize = static_cast<size_t>(levelIndices[i].mByteLength);
+		}
+
+		return image;
+	}
+
+	void Ktx2::save(const std::string& path, const Ktx2Image& image) {
+		uint32_t blockBytes = getBlockBytes(image.mFormat);
+		if (blockBytes == 0) {
+			throw std::runtime_error("Error: unsupported ktx2 format");
+		}
+
+		uint32_t levelCount = static_cast<uint32_t>(image.mLevels.size());
+		auto dfd = createDataFormatDescriptor(image.mFormat);
+
+		//KTXwriterǹ淶Ƽдļֵ
+		std::vector<uint8_t> kvd;
+		{
+			std::string key = "KTXwriter";
+			std::string value = "vulkanLearning texture_cooker";
+			uint32_t length = static_cast<uint32_t>(key.size() + 1 + value.size() + 1);
+			append(kvd, length);
+			kvd.insert(kvd.end(), key.begin(), key.end());
+			kvd.push_back(0);
+			kvd.insert(kvd.end(), value.begin(), value.end());
+			kvd.push_back(0);
+			kvd.resize(alignUp(kvd.size(), 4), 0);
+		}
+
+		Ktx2Header header{};
+		memcpy(header.mIdentifier, IDENTIFIER, sizeof(IDENTIFIER));
+		header.mVkFormat = image.mFormat;
+		//ѹʽ8bitķѹʽtypeSizeΪ1
+		header.mTypeSize = 1;
+		header.mPixelWidth = image.mWidth;
+		header.mPixelHeight = image.mHeight;
+		header.mPixelDepth = 0;
+		header.mLayerCount = 0;
+		header.mFaceCount = 1;
+		header.mLevelCount = levelCount;
+		header.mSupercompressionScheme = 0;
+
+		size_t offset = sizeof(Ktx2Header) + sizeof(Ktx2LevelIndex) * levelCount;
+		header.mDfdByteOffset = static_cast<uint32_t>(offset);
+		header.mDfdByteLength = static_cast<uint32_t>(dfd.size());
+		offset += dfd.size();
+
+		header.mKvdByteOffset = static_cast<uint32_t>(offset);
+		header.mKvdByteLength = static_cast<uint32_t>(kvd.size());
+		offset += kvd.size();
+
+		header.mSgdByteOffset = 0;
+		header.mSgdByteLength = 0;
+
+		//mipmapݴСһʼдÿһlcm(С, 4)
+		size_t levelAlignment = blockBytes % 4 == 0 ? blockBytes : blockBytes * 4;
+		std::vector<Ktx2LevelIndex> levelIndices(levelCount);
+		for (int i = static_cast<int>(levelCount) - 1; i >= 0; --i) {
+			offset = alignUp(offset, levelAlignment);
+			levelIndices[i].mByteOffset = offset;
+			levelIndices[i].mByteLength = image.mLevels[i].mSize;
+			levelIndices[i].mUncompressedByteLength = image.mLevels[i].mSize;
+			offset += image.mLevels[i].mSize;
+		}
+
+		std::ofstream file(path, std::ios::binary);
+		if (!file) {
+			throw std::runtime_error("Error: failed to create ktx2 file " + path);
+		}
+
+		auto writeAt = [&file](size_t position, const void* data, size_t size) {
+			size_t current = static_cast<size_t>(file.tellp());
+			if (current < position) {
+				std::vector<char> padding(position - current, 0);
+				file.write(padding.data(), padding.size());
+			}
+			file.write(reinterpret_cast<const char*>(data), size);
+		};
+
+		writeAt(0, &header, sizeof(header));
+		writeAt(sizeof(header), levelIndices.data(), sizeof(Ktx2LevelIndex) * levelCount);
+		writeAt(header.mDfdByteOffset, dfd.data(), dfd.size());
+		writeAt(header.mKvdByteOffset, kvd.data(), kvd.size());
+		for (int i = static_cast<int>(levelCount) - 1; i >= 0; --i) {
+			writeAt(static_cast<size_t>(levelIndices[i].mByteOffset), image.mData.data() + image.mLevels[i].mOffset, image.mLevels[i].mSize);
+		}
+
+		if (!file) {
+			throw std::runtime_error("Error: failed to write ktx2 file " + path);
+		}
+	}
+
+	uint32_t Ktx2::getBlockBytes(VkFormat format) {
+		switch (format) {
+		case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+		case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+		case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+		case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+			return 8;
+		case VK_FORMAT_BC5_UNORM_BLOCK:
+		case VK_FORMAT_BC7_UNORM_BLOCK:
+		case VK_FORMAT_BC7_SRGB_BLOCK:
+			return 16;
+		case VK_FORMAT_R8G8B8A8_UNORM:
+		case VK_FORMAT_R8G8B8A8_SRGB:
+			return 4;
+		default:
+			return 0;
+		}
+	}
+
+	uint32_t Ktx2::getBlockDimension(VkFormat format) {
+		return (format == VK_FORMAT_R8G8B8A8_UNORM || format == VK_FORMAT_R8G8B8A8_SRGB) ? 1 : 4;
+	}
+
+	std::vector<uint8_t> Ktx2::createDataFormatDescriptor(VkFormat format) {
+		struct Sample {
+			uint16_t mBitOffset;
+			uint8_t mBitLength;
+			uint8_t mChannel;
+			uint32_t mUpper;
+		};
+
+		uint8_t model = 0;
+		std::vector<Sample> samples;
+		switch (format) {
+		case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+		case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+		case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+		case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+			model = KHR_DF_MODEL_BC1A;
+			samples.push_back({ 0, 63, 0, UINT32_MAX });
+			break;
+		case VK_FORMAT_BC5_UNORM_BLOCK:
+			model = KHR_DF_MODEL_BC5;
+			samples.push_back({ 0, 63, KHR_DF_CHANNEL_RED, UINT32_MAX });
+			samples.push_back({ 64, 63, KHR_DF_CHANNEL_GREEN, UINT32_MAX });
+			break;
+		case VK_FORMAT_BC7_UNORM_BLOCK:
+		case VK_FORMAT_BC7_SRGB_BLOCK:
+			model = KHR_DF_MODEL_BC7;
+			samples.push_back({ 0, 127, 0, UINT32_MAX });
+			break;
+		case VK_FORMAT_R8G8B8A8_UNORM:
+		case VK_FORMAT_R8G8B8A8_SRGB:
+			model = KHR_DF_MODEL_RGBSDA;
+			samples.push_back({ 0, 7, KHR_DF_CHANNEL_RED, 255 });
+			samples.push_back({ 8, 7, KHR_DF_CHANNEL_GREEN, 255 });
+			samples.push_back({ 16, 7, KHR_DF_CHANNEL_BLUE, 255 });
+			samples.push_back({ 24, 7, KHR_DF_CHANNEL_ALPHA | KHR_DF_SAMPLE_DATATYPE_LINEAR, 255 });
+			break;
+		default:
+			throw std::runtime_error("Error: unsupported ktx2 format");
+		}
+
+		uint32_t blockDimension = getBlockDimension(format);
+		uint16_t blockSize = static_cast<uint16_t>(24 + 16 * samples.size());
+
+		std::vector<uint8_t> dfd;
+		append<uint32_t>(dfd, 4u + blockSize);//dfdTotalSize
+
+		append<uint32_t>(dfd, 0);//vendorId = KHRONOS, descriptorType = BASICFORMAT
+		append<uint16_t>(dfd, 2);//versionNumber
+		append<uint16_t>(dfd, blockSize);
+		append<uint8_t>(dfd, model);
+		append<uint8_t>(dfd, KHR_DF_PRIMARIES_BT709);
+		append<uint8_t>(dfd, isSrgb(format) ? KHR_DF_TRANSFER_SRGB : KHR_DF_TRANSFER_LINEAR);
+		append<uint8_t>(dfd, 0);//flags: straight alpha
+
+		//texelBlockDimension洢Ǳ߳-1
+		append<uint8_t>(dfd, static_cast<uint8_t>(blockDimension - 1));
+		append<uint8_t>(dfd, static_cast<uint8_t>(blockDimension - 1));
+		append<uint8_t>(dfd, 0);
+		append<uint8_t>(dfd, 0);
+
+		//bytesPlane0-7
+		append<uint8_t>(dfd, static_cast<uint8_t>(getBlockBytes(format)));
+		for (int i = 0; i < 7; ++i) {
+			append<uint8_t>(dfd, 0);
+		}
+
+		for (const auto& sample : samples) {
+			append<uint16_t>(dfd, sample.mBitOffset);
+			append<uint8_t>(dfd, sample.mBitLength);
+			append<uint8_t>(dfd, sample.mChannel);
+			append<uint32_t>(dfd, 0);//samplePosition0-3
+			append<uint32_t>(dfd, 0);//sampleLower
+			append<uint32_t>(dfd, sample.mUpper);
+		}
+
+		return dfd;
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace FF {
+
+	/*
+	* KTX2Ķдֱֻ֧õӼ
+	* 1 2Dlayerfacesupercompression
+	* 2 ļеmipmapݰմСУlevel indexе0һ
+	* 3 дʱɶӦʽBasic Data Format DescriptorȡʱDFDֻvkFormat
+	* 4 ȡʱlevelCountÿһƫ볤ȶͼƬСļСУ飬𻵵ļ׳쳣Խȡ
+	* ʽο https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+	*/
+
+	struct Ktx2Level {
+		//Ktx2Image::mDataеƫ
+		size_t mOffset{ 0 };
+		size_t mSize{ 0 };
+	};
+
+	struct Ktx2Image {
+		VkFormat mFormat{ VK_FORMAT_UNDEFINED };
+		uint32_t mWidth{ 0 };
+		uint32_t mHeight{ 0 };
+
+		//±0Ϊһ
+		std::vector<Ktx2Level> mLevels{};
+
+		//мݣȡʱļе˳һ£ֱϴ
+		std::vector<uint8_t> mData{};
+	};
+
+	class Ktx2 {
+	public:
+		//ļʶ "\xABKTX 20\xBB\r\n\x1A\n"
+		static constexpr uint8_t IDENTIFIER[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+		static bool isKtx2File(const std::string& path);
+
+		//ȡʧʱ׳쳣
+		static Ktx2Image load(const std::string& path);
+
+		static void save(const std::string& path, const Ktx2Image& image);
+
+		//һѹ(һ)ֵֽ֧ĸʽ0
+		static uint32_t getBlockBytes(VkFormat format);
+
+		//ѹʽĿ߳Ϊ4ѹΪ1
+		static uint32_t getBlockDimension(VkFormat format);
+
+	private:
+		static std::vector<uint8_t> createDataFormatDescriptor(VkFormat format);
+	};
+}
@@ -0,0 +1,93 @@
+#include "mip_generator.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FF_MIP_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace FF {
+
+	std::vector<uint8_t> MipGenerator::generate(
+		const uint8_t* pixels,
+		uint32_t width,
+		uint32_t height,
+		uint32_t levelCount,
+		std::vector<MipLevelInfo>& levels
+	) {
+		levels.resize(levelCount);
+
+		size_t totalSize = 0;
+		uint32_t w = width;
+		uint32_t h = height;
+		for (uint32_t i = 0; i < levelCount; ++i) {
+			levels[i].mWidth = w;
+			levels[i].mHeight = h;
+			levels[i].mOffset = totalSize;
+			levels[i].mSize = static_cast<size_t>(w) * h * 4;
+			totalSize += levels[i].mSize;
+
+			w = w > 1 ? w / 2 : 1;
+			h = h > 1 ? h / 2 : 1;
+		}
+
+		std::vector<uint8_t> data(totalSize);
+		memcpy(data.data(), pixels, levels[0].mSize);
+
+		for (uint32_t i = 1; i < levelCount; ++i) {
+			downsample(
+				data.data() + levels[i - 1].mOffset,
+				levels[i - 1].mWidth, levels[i - 1].mHeight,
+				data.data() + levels[i].mOffset
+			);
+		}
+
+		return data;
+	}
+
+	void MipGenerator::downsample(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, uint8_t* dst) {
+		uint32_t dstWidth = srcWidth > 1 ? srcWidth / 2 : 1;
+		uint32_t dstHeight = srcHeight > 1 ? srcHeight / 2 : 1;
+		size_t srcPitch = static_cast<size_t>(srcWidth) * 4;
+
+		for (uint32_t y = 0; y < dstHeight; ++y) {
+			//߳Ϊ1ʱȡͬһ
+			const uint8_t* row0 = src + std::min(y * 2, srcHeight - 1) * srcPitch;
+			const uint8_t* row1 = src + std::min(y * 2 + 1, srcHeight - 1) * srcPitch;
+			uint8_t* out = dst + static_cast<size_t>(y) * dstWidth * 4;
+
+			uint32_t x = 0;
+
+#ifdef FF_MIP_SSE2
+			//ÿζȡи8أƽٰڵż/ƽõ4
+			if (srcWidth >= 2) {
+				for (; x + 4 <= dstWidth && (x + 4) * 2 <= srcWidth; x += 4) {
+					const __m128i* p0 = reinterpret_cast<const __m128i*>(row0 + x * 8);
+					const __m128i* p1 = reinterpret_cast<const __m128i*>(row1 + x * 8);
+
+					__m128i a = _mm_avg_epu8(_mm_loadu_si128(p0), _mm_loadu_si128(p1));
+					__m128i b = _mm_avg_epu8(_mm_loadu_si128(p0 + 1), _mm_loadu_si128(p1 + 1));
+
+					__m128 af = _mm_castsi128_ps(a);
+					__m128 bf = _mm_castsi128_ps(b);
+					__m128i even = _mm_castps_si128(_mm_shuffle_ps(af, bf, _MM_SHUFFLE(2, 0, 2, 0)));
+					__m128i odd = _mm_castps_si128(_mm_shuffle_ps(af, bf, _MM_SHUFFLE(3, 1, 3, 1)));
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), _mm_avg_epu8(even, odd));
+				}
+			}
+#endif
+
+			for (; x < dstWidth; ++x) {
+				uint32_t x0 = std::min(x * 2, srcWidth - 1);
+				uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1);
+				for (uint32_t c = 0; c < 4; ++c) {
+					uint32_t sum = 
+						row0[x0 * 4 + c] + row0[x1 * 4 + c] + 
+						row1[x0 * 4 + c] + row1[x1 * 4 + c];
+					out[x * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+				}
+			}
+		}
+	}
+}
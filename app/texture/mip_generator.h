@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../base.h"
+
+namespace FF {
+
+	/*
+	* CPU˵mipmapɣڸʽ֧blit
+	* 1 ֻRGBA8ÿһһ2x2box filterõ߳ʱһ/ƽ
+	* 2 x86SSE2һδ4أƽ̨߱汾
+	* 3 ֱӶԴ洢ֵƽsRGBʽ»΢ƫblitΪһ
+	*/
+
+	struct MipLevelInfo {
+		uint32_t mWidth{ 0 };
+		uint32_t mHeight{ 0 };
+
+		//mipmapеƫ
+		size_t mOffset{ 0 };
+		size_t mSize{ 0 };
+	};
+
+	class MipGenerator {
+	public:
+		//pixelsΪRGBA8ĵ0ȫlevelCountβݣlevelsм¼ÿһλ
+		//ļWrapper::Image::calculateMipLevelsõ
+		static std::vector<uint8_t> generate(
+			const uint8_t* pixels,
+			uint32_t width,
+			uint32_t height,
+			uint32_t levelCount,
+			std::vector<MipLevelInfo>& levels
+		);
+
+		//src(srcWidth x srcHeight)Сһдdst
+		static void downsample(const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, uint8_t* dst);
+	};
+}
@@ -1,67 +1,276 @@
 #include "texture.h"
+#include "mip_generator.h"
+#include "ktx2.h"
+#include "../profiler.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "../stb_image.h"
 
 namespace FF {
+	Texture::Ptr Texture::createPlaceholder(
+		const Wrapper::Device::Ptr& device,
+		const Wrapper::UploadManager::Ptr& uploadManager,
+		const Wrapper::SamplerCache::Ptr& samplerCache,
+		const glm::u8vec4& color
+	) {
+		TextureData data;
+		data.mPath = "placeholder";
+		data.mWidth = 1;
+		data.mHeight = 1;
+		data.mPixels = { color.r, color.g, color.b, color.a };
+		data.mContentDigest = computeDigest(data);
+		return Texture::create(device, uploadManager, data, samplerCache);
+	}
+
+	TextureData Texture::decode(const std::string& imageFilePath, bool cpuMipmaps) {
+		FF_PROFILE_ZONE("Texture::decode");
+		TextureData data;
+		data.mPath = imageFilePath;
+
+		//к決õKTX2ʱʹãֱϴѹ飬ٽͼƬmipmap
+		std::string cookedPath = findCookedPath(imageFilePath);
+		if (!cookedPath.empty()) {
+			data.mPath = cookedPath;
+			data.mKtx2 = Ktx2::load(cookedPath);
+			data.mContentDigest = computeDigest(data);
+			return data;
+		}
+
+		int texWidth, texHeight, texChannels;
+		stbi_uc* pixels = stbi_load(imageFilePath.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+		if (!pixels) {
+			throw std::runtime_error("Error: failed to read image data " + imageFilePath);
+		}
+
+		data.mWidth = static_cast<uint32_t>(texWidth);
+		data.mHeight = static_cast<uint32_t>(texHeight);
+
+		if (cpuMipmaps) {
+			//ʽ֧blitCPUmipmapһϴ
+			uint32_t mipLevels = Wrapper::Image::calculateMipLevels(data.mWidth, data.mHeight);
+			data.mPixels = MipGenerator::generate(pixels, data.mWidth, data.mHeight, mipLevels, data.mLevels);
+		}
+		else {
+			data.mPixels.assign(pixels, pixels + static_cast<size_t>(texWidth) * texHeight * 4);
+		}
+
+		stbi_image_free(pixels);
+
+		data.mContentDigest = computeDigest(data);
+
+		return data;
+	}
+
 	Texture::Texture(
 		const Wrapper::Device::Ptr& device, 
-		const Wrapper::CommandPool::Ptr& commandPool, 
+		const Wrapper::UploadManager::Ptr& uploadManager, 
 		const std::string& imageFilePath
+	) : Texture(
+		device, uploadManager, 
+		decode(imageFilePath, !Wrapper::Image::isLinearBlitSupported(device, VK_FORMAT_R8G8B8A8_SRGB))
+	) {
+	}
+
+	Texture::Texture(
+		const Wrapper::Device::Ptr& device,
+		const Wrapper::UploadManager::Ptr& uploadManager,
+		const TextureData& data,
+		const Wrapper::SamplerCache::Ptr& samplerCache
 	) {
 		_device = device;
 
-		int texWidth, texHeight, texChannels;
+		uint32_t mipLevels = data.isKtx2() ? 
+			uploadKtx2(uploadManager, data.mKtx2, data.mPath) : 
+			uploadPixels(uploadManager, data);
 
-		stbi_uc* pixels = stbi_load(imageFilePath.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
-		if (!pixels) {
-			throw std::runtime_error("Error: failed to read image data");
+		_sampler = samplerCache ? samplerCache->getDefaultSampler() : Wrapper::Sampler::create(_device, mipLevels);
+
+		_imageInfo.imageLayout = _image->getLayout();
+		_imageInfo.imageView = _image->getImageView();
+		_imageInfo.sampler = _sampler->getSamper();
+	}
+
+	Texture::~Texture() {
+
+	}
+
+	std::string Texture::findCookedPath(const std::string& imageFilePath) {
+		auto dot = imageFilePath.find_last_of('.');
+		std::string extension = dot == std::string::npos ? "" : imageFilePath.substr(dot);
+		if (extension == ".ktx2") {
+			return imageFilePath;
+		}
+
+		std::string cookedPath = imageFilePath.substr(0, dot) + ".ktx2";
+		return Ktx2::isKtx2File(cookedPath) ? cookedPath : "";
+	}
+
+	uint32_t Texture::uploadKtx2(const Wrapper::UploadManager::Ptr& uploadManager, const Ktx2Image& ktx, const std::string& path) {
+		VkFormatProperties props;
+		vkGetPhysicalDeviceFormatProperties(_device->getPhysicalDevice(), ktx.mFormat, &props);
+		if (!(props.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT)) {
+			throw std::runtime_error("Error: ktx2 format is not supported by device " + path);
 		}
 
+		uint32_t mipLevels = static_cast<uint32_t>(ktx.mLevels.size());
+
 		_image = Wrapper::Image::create(
-			_device, texWidth, texHeight,
-			VK_FORMAT_R8G8B8A8_SRGB,
+			_device, ktx.mWidth, ktx.mHeight,
+			ktx.mFormat,
 			VK_IMAGE_TYPE_2D,
 			VK_IMAGE_TILING_OPTIMAL,
 			VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
 			VK_SAMPLE_COUNT_1_BIT,
-			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,//ֻGPU˱ʹ
-			VK_IMAGE_ASPECT_COLOR_BIT
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			VK_IMAGE_ASPECT_COLOR_BIT,
+			mipLevels
 		);
 
-
 		VkImageSubresourceRange region{};
 		region.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 		region.baseArrayLayer = 0;
 		region.layerCount = 1;
 		region.baseMipLevel = 0;
-		region.levelCount = 1;
+		region.levelCount = mipLevels;
 
-		_image->setImageLayout(
-			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-			VK_PIPELINE_STAGE_TRANSFER_BIT,
-			VK_PIPELINE_STAGE_TRANSFER_BIT,
-			region, commandPool
+		//ÿһһregionimageExtentΪüʵʳߴ磬һĲ
+		std::vector<VkBufferImageCopy> copyRegions;
+		for (uint32_t i = 0; i < mipLevels; ++i) {
+			copyRegions.push_back(makeCopyRegion(
+				i, ktx.mLevels[i].mOffset,
+				std::max(ktx.mWidth >> i, 1u),
+				std::max(ktx.mHeight >> i, 1u)
+			));
+		}
+
+		uploadManager->uploadImage(
+			_image, ktx.mData.data(), ktx.mData.size(),
+			copyRegions,
+			region,
+			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			false
 		);
-		size_t texSize = texWidth * texHeight * sizeof(int);
-		_image->fillImageData(commandPool, texSize, (void*)pixels);
 
-		_image->setImageLayout(
+		return mipLevels;
+	}
+
+	uint32_t Texture::uploadPixels(const Wrapper::UploadManager::Ptr& uploadManager, const TextureData& data) {
+		VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
+
+		//mLevelsΪʱֻе0༶GPUblit
+		bool gpuMipmaps = data.mLevels.empty();
+		uint32_t mipLevels = gpuMipmaps ? 
+			Wrapper::Image::calculateMipLevels(data.mWidth, data.mHeight) : 
+			static_cast<uint32_t>(data.mLevels.size());
+
+		_image = Wrapper::Image::create(
+			_device, data.mWidth, data.mHeight,
+			format,
+			VK_IMAGE_TYPE_2D,
+			VK_IMAGE_TILING_OPTIMAL,
+			//mipmapʱÿһҪΪblitԴ
+			VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+			VK_SAMPLE_COUNT_1_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,//ֻGPU˱ʹ
+			VK_IMAGE_ASPECT_COLOR_BIT,
+			mipLevels
+		);
+
+		VkImageSubresourceRange region{};
+		region.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.baseArrayLayer = 0;
+		region.layerCount = 1;
+		region.baseMipLevel = 0;
+		region.levelCount = mipLevels;
+
+		std::vector<VkBufferImageCopy> copyRegions;
+		if (gpuMipmaps) {
+			copyRegions.push_back(makeCopyRegion(0, 0, data.mWidth, data.mHeight));
+		}
+		else {
+			for (uint32_t i = 0; i < mipLevels; ++i) {
+				copyRegions.push_back(makeCopyRegion(i, data.mLevels[i].mOffset, data.mLevels[i].mWidth, data.mLevels[i].mHeight));
+			}
+		}
+
+		//layoutת뿽¼ƽUploadManagerĵǰΣѾstagingͷ
+		uploadManager->uploadImage(
+			_image, data.mPixels.data(), data.mPixels.size(),
+			copyRegions,
+			region,
 			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-			VK_PIPELINE_STAGE_TRANSFER_BIT,
 			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-			region, commandPool
+			gpuMipmaps
 		);
 
-		stbi_image_free(pixels);
+		return mipLevels;
+	}
 
-		_sampler = Wrapper::Sampler::create(_device);
+	TextureDigest Texture::computeDigest(const TextureData& data) {
+		//ÿλ8ֽڣ·64λϣһ·FNV-1aһ·˷ѭλ(murmur˼·)
+		//MBڹֻ߳Ҫ
+		TextureDigest digest{};
+		digest.mHash0 = 0xcbf29ce484222325ull;
+		digest.mHash1 = 0x9e3779b97f4a7c15ull;
+		auto mix = [&digest](uint64_t value) {
+			digest.mHash0 ^= value;
+			digest.mHash0 *= 0x100000001b3ull;
 
-		_imageInfo.imageLayout = _image->getLayout();
-		_imageInfo.imageView = _image->getImageView();
-		_imageInfo.sampler = _sampler->getSamper();
+			uint64_t k = value * 0x87c37b91114253d5ull;
+			k = (k << 31) | (k >> 33);
+			digest.mHash1 ^= k * 0x4cf5ad432745937full;
+			digest.mHash1 = ((digest.mHash1 << 27) | (digest.mHash1 >> 37)) * 5 + 0x52dce729;
+		};
+
+		auto mixBytes = [&mix, &digest](const uint8_t* bytes, size_t size) {
+			size_t i = 0;
+			for (; i + 8 <= size; i += 8) {
+				uint64_t word;
+				memcpy(&word, bytes + i, sizeof(word));
+				mix(word);
+			}
+			for (; i < size; ++i) {
+				mix(bytes[i]);
+			}
+			mix(size);
+			digest.mSize += size;
+		};
+
+		if (data.isKtx2()) {
+			mix(data.mKtx2.mFormat);
+			mix(data.mKtx2.mWidth);
+			mix(data.mKtx2.mHeight);
+			mix(data.mKtx2.mLevels.size());
+			mixBytes(data.mKtx2.mData.data(), data.mKtx2.mData.size());
+		}
+		else {
+			//CPUǷmipmapӰͼƬֻĵ0
+			mix(VK_FORMAT_R8G8B8A8_SRGB);
+			mix(data.mWidth);
+			mix(data.mHeight);
+			size_t level0Size = static_cast<size_t>(data.mWidth) * data.mHeight * 4;
+			mixBytes(data.mPixels.data(), std::min(level0Size, data.mPixels.size()));
+		}
+
+		return digest;
 	}
-	Texture::~Texture() {
 
+	VkBufferImageCopy Texture::makeCopyRegion(uint32_t mipLevel, VkDeviceSize bufferOffset, uint32_t width, uint32_t height) {
+		VkBufferImageCopy region{};
+		region.bufferOffset = bufferOffset;
+
+		//Ϊ0Ҫpadding
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = mipLevel;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+		region.imageOffset = { 0,0,0 };
+		region.imageExtent = { width, height, 1 };
+
+		return region;
 	}
 }
\ No newline at end of file
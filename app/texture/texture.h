@@ -3,27 +3,101 @@
 #include "../base.h"
 #include "../vulkan_wrapper/image.h"
 #include "../vulkan_wrapper/sampler.h"
+#include "../vulkan_wrapper/sampler_cache.h"
+#include "../vulkan_wrapper/upload_manager.h"
+#include "ktx2.h"
+#include "mip_generator.h"
 
 namespace FF {
 
+	/*
+	* ݵժҪжϲͬ·Ƿͬ
+	* 1 ·㷨ͬ64λϣΪ128λײĸʿԺ
+	* 2 ͬʱȽϲϣֽСͬݲᱻͬ
+	*/
+	struct TextureDigest {
+		uint64_t mHash0{ 0 };
+		uint64_t mHash1{ 0 };
+		uint64_t mSize{ 0 };
+
+		bool operator==(const TextureDigest& other) const {
+			return mHash0 == other.mHash0 && mHash1 == other.mHash1 && mSize == other.mSize;
+		}
+	};
+
+	/*
+	* ɡδϴݣֻCPU˵ݣڹ߳
+	* 1 к決õKTX2ʱmKtx2Чֱϴѹ
+	* 2 ΪRGBA8أmLevelsǿʱmPixelsаCPUɺõȫmipmapΪʱֻе0ϴʱGPUblit
+	*/
+	struct TextureData {
+		std::string mPath{};
+
+		Ktx2Image mKtx2{};
+
+		uint32_t mWidth{ 0 };
+		uint32_t mHeight{ 0 };
+		std::vector<uint8_t> mPixels{};
+		std::vector<MipLevelInfo> mLevels{};
+
+		//ʽߴȫݵժҪdecodeм㣬ڲͬ·ͬ
+		TextureDigest mContentDigest{};
+
+		[[nodiscard]] bool isKtx2() const { return mKtx2.mFormat != VK_FORMAT_UNDEFINED; }
+	};
+
 	class Texture {
 	public:
 		using Ptr = std::shared_ptr<Texture>;
 
 		static Ptr create(
 			const Wrapper::Device::Ptr& device, 
-			const Wrapper::CommandPool::Ptr& commandPool, 
+			const Wrapper::UploadManager::Ptr& uploadManager, 
 			const std::string& imageFilePath
 		) {
-			return std::make_shared<Texture>(device, commandPool, imageFilePath);
+			return std::make_shared<Texture>(device, uploadManager, imageFilePath);
+		}
+
+		//samplerCacheΪʱsampler
+		static Ptr create(
+			const Wrapper::Device::Ptr& device,
+			const Wrapper::UploadManager::Ptr& uploadManager,
+			const TextureData& data,
+			const Wrapper::SamplerCache::Ptr& samplerCache = nullptr
+		) {
+			return std::make_shared<Texture>(device, uploadManager, data, samplerCache);
 		}
 
+		//1x1Ĵɫ첽֮ǰ
+		static Ptr createPlaceholder(
+			const Wrapper::Device::Ptr& device,
+			const Wrapper::UploadManager::Ptr& uploadManager,
+			const Wrapper::SamplerCache::Ptr& samplerCache = nullptr,
+			const glm::u8vec4& color = glm::u8vec4(128, 128, 128, 255)
+		);
+
+		/*
+		* ȡļ룬κvulkan󣬿ڹ߳е
+		* cpuMipmapsΪtrueʱCPUȫmipmap(ʽ֧blitʱ)
+		* ʧʱ׳쳣
+		*/
+		static TextureData decode(const std::string& imageFilePath, bool cpuMipmaps);
+
+		//ͬأȼdecode֮TextureData
 		Texture(
 			const Wrapper::Device::Ptr& device,
-			const Wrapper::CommandPool::Ptr& commandPool,
+			const Wrapper::UploadManager::Ptr& uploadManager,
 			const std::string& imageFilePath
 		);
 
+		//ͼƬϴ¼ƽuploadManagerĵǰ
+		Texture(
+			const Wrapper::Device::Ptr& device,
+			const Wrapper::UploadManager::Ptr& uploadManager,
+			const TextureData& data,
+			const Wrapper::SamplerCache::Ptr& samplerCache = nullptr
+		);
+
 		~Texture();
 
 		[[nodiscard]] Wrapper::Image::Ptr getImage() const { return _image; }
@@ -32,10 +106,23 @@ namespace FF {
 
 		[[nodiscard]] const VkDescriptorImageInfo& getImageInfo() { return _imageInfo; }
 
+	private:
+		//imageFilePath.ktx2ͬĿ¼ͬ.ktx2ʱ·򷵻ؿ
+		static std::string findCookedPath(const std::string& imageFilePath);
+
+		//_image¼ϴmipmap
+		uint32_t uploadKtx2(const Wrapper::UploadManager::Ptr& uploadManager, const Ktx2Image& ktx, const std::string& path);
+
+		uint32_t uploadPixels(const Wrapper::UploadManager::Ptr& uploadManager, const TextureData& data);
+
+		static TextureDigest computeDigest(const TextureData& data);
+
+		static VkBufferImageCopy makeCopyRegion(uint32_t mipLevel, VkDeviceSize bufferOffset, uint32_t width, uint32_t height);
+
 	private:
 		Wrapper::Device::Ptr _device{ nullptr };
 		Wrapper::Image::Ptr _image{ nullptr };
 		Wrapper::Sampler::Ptr _sampler{ nullptr };
 		VkDescriptorImageInfo _imageInfo{};
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,87 @@
+#include "texture_cache.h"
+
+namespace FF {
+
+	TextureCache::TextureCache(
+		const Wrapper::Device::Ptr& device,
+		const Wrapper::UploadManager::Ptr& uploadManager,
+		const Wrapper::SamplerCache::Ptr& samplerCache
+	) {
+		_device = device;
+		_uploadManager = uploadManager;
+		_samplerCache = samplerCache;
+		_cpuMipmaps = !Wrapper::Image::isLinearBlitSupported(_device, VK_FORMAT_R8G8B8A8_SRGB);
+	}
+
+	TextureCache::~TextureCache() {
+		_texturesByPath.clear();
+		_texturesByDigest.clear();
+	}
+
+	Texture::Ptr TextureCache::getTexture(const std::string& path) {
+		auto texture = findTexture(path);
+		if (texture) {
+			return texture;
+		}
+
+		return getTexture(Texture::decode(path, _cpuMipmaps));
+	}
+
+	Texture::Ptr TextureCache::getTexture(const TextureData& data) {
+		Texture::Ptr texture{ nullptr };
+
+		auto iter = _texturesByDigest.find(data.mContentDigest);
+		if (iter != _texturesByDigest.end()) {
+			texture = iter->second;
+		}
+		else {
+			texture = Texture::create(_device, _uploadManager, data, _samplerCache);
+			_texturesByDigest[data.mContentDigest] = texture;
+		}
+
+		if (!data.mPath.empty()) {
+			_texturesByPath[data.mPath] = texture;
+		}
+
+		return texture;
+	}
+
+	Texture::Ptr TextureCache::findTexture(const std::string& path) const {
+		auto iter = _texturesByPath.find(path);
+		return iter == _texturesByPath.end() ? nullptr : iter->second;
+	}
+
+	size_t TextureCache::purgeUnused() {
+		//ͬһͬʱ·ժҪãȫԻʱͷ
+		std::unordered_map<Texture*, long> cacheRefs;
+		for (const auto& [path, texture] : _texturesByPath) {
+			++cacheRefs[texture.get()];
+		}
+		for (const auto& [digest, texture] : _texturesByDigest) {
+			++cacheRefs[texture.get()];
+		}
+
+		//ÿժҪǡóһ
+		std::set<Texture*> unused;
+		for (const auto& [digest, texture] : _texturesByDigest) {
+			if (texture.use_count() == cacheRefs[texture.get()]) {
+				unused.insert(texture.get());
+			}
+		}
+
+		auto eraseUnused = [&unused](auto& textures) {
+			for (auto iter = textures.begin(); iter != textures.end();) {
+				if (unused.count(iter->second.get()) > 0) {
+					iter = textures.erase(iter);
+				}
+				else {
+					++iter;
+				}
+			}
+		};
+		eraseUnused(_texturesByPath);
+		eraseUnused(_texturesByDigest);
+
+		return unused.size();
+	}
+}
\ No newline at end of file
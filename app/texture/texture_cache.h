@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../base.h"
+#include "../vulkan_wrapper/sampler_cache.h"
+#include "texture.h"
+#include <unordered_map>
+
+namespace FF {
+
+	/*
+	* 
+	* 1 ·Ϊͬһ·ֻ롢ϴһ
+	* 2 ժҪ(128λϣݴС)Ϊͬ·ͬ(縴ƳĲͼ)ͬһImage
+	* 3 samplerͬһSamplerCache
+	* 4 ãpurgeUnusedͷֻлõǰ豣֤GPUʹ
+	*/
+	class TextureCache {
+	public:
+		using Ptr = std::shared_ptr<TextureCache>;
+
+		static Ptr create(
+			const Wrapper::Device::Ptr& device,
+			const Wrapper::UploadManager::Ptr& uploadManager,
+			const Wrapper::SamplerCache::Ptr& samplerCache
+		) {
+			return std::make_shared<TextureCache>(device, uploadManager, samplerCache);
+		}
+
+		TextureCache(
+			const Wrapper::Device::Ptr& device,
+			const Wrapper::UploadManager::Ptr& uploadManager,
+			const Wrapper::SamplerCache::Ptr& samplerCache
+		);
+
+		~TextureCache();
+
+		//ͬأ·ʱȡļ
+		Texture::Ptr getTexture(const std::string& path);
+
+		//ѾݣժҪʱֱӷеϴ
+		Texture::Ptr getTexture(const TextureData& data);
+
+		//ֻѯ
+		Texture::Ptr findTexture(const std::string& path) const;
+
+		//ͷֻõͷŵ
+		size_t purgeUnused();
+
+		[[nodiscard]] size_t getTextureCount() const { return _texturesByDigest.size(); }
+
+		[[nodiscard]] Wrapper::Device::Ptr getDevice() const { return _device; }
+
+		[[nodiscard]] Wrapper::UploadManager::Ptr getUploadManager() const { return _uploadManager; }
+
+		[[nodiscard]] Wrapper::SamplerCache::Ptr getSamplerCache() const { return _samplerCache; }
+
+		//RGBA8 sRGB֧blitʱҪdecodemipmap
+		[[nodiscard]] bool needCpuMipmaps() const { return _cpuMipmaps; }
+
+	private:
+		struct DigestHash {
+			size_t operator()(const TextureDigest& digest) const { return static_cast<size_t>(digest.mHash0); }
+		};
+
+	private:
+		Wrapper::Device::Ptr _device{ nullptr };
+		Wrapper::UploadManager::Ptr _uploadManager{ nullptr };
+		Wrapper::SamplerCache::Ptr _samplerCache{ nullptr };
+		bool _cpuMipmaps{ false };
+
+		std::unordered_map<std::string, Texture::Ptr> _texturesByPath{};
+		std::unordered_map<TextureDigest, Texture::Ptr, DigestHash> _texturesByDigest{};
+	};
+}
@@ -0,0 +1,94 @@
+#include "texture_loader.h"
+#include "../profiler.h"
+
+namespace FF {
+
+	TextureLoader::TextureLoader(const TextureCache::Ptr& textureCache, const ThreadPool::Ptr& threadPool) {
+		_textureCache = textureCache;
+		_threadPool = threadPool;
+
+		_placeholder = Texture::createPlaceholder(
+			_textureCache->getDevice(), 
+			_textureCache->getUploadManager(), 
+			_textureCache->getSamplerCache()
+		);
+	}
+
+	TextureLoader::~TextureLoader() {
+		//߳еֻԼݣȴ
+		for (auto& load : _pendingLoads) {
+			if (load.mFuture.valid()) {
+				load.mFuture.wait();
+			}
+		}
+	}
+
+	TextureHandle::Ptr TextureLoader::load(const std::string& path) {
+		auto iter = _handles.find(path);
+		if (iter != _handles.end()) {
+			return iter->second;
+		}
+
+		auto handle = TextureHandle::create(path, _placeholder);
+		_handles[path] = handle;
+
+		//Ѿͬعٽ룬ϴܻûɣͬȵǰִл
+		auto cached = _textureCache->findTexture(path);
+		if (cached) {
+			switchAfterUpload(handle, cached);
+			return handle;
+		}
+
+		PendingLoad load;
+		load.mHandle = handle;
+		load.mFuture = _threadPool->submit(&Texture::decode, path, _textureCache->needCpuMipmaps());
+		_pendingLoads.push_back(std::move(load));
+
+		return handle;
+	}
+
+	void TextureLoader::update() {
+		for (auto iter = _pendingLoads.begin(); iter != _pendingLoads.end();) {
+			if (iter->mFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+				++iter;
+				continue;
+			}
+
+			finishLoad(*iter);
+			iter = _pendingLoads.erase(iter);
+		}
+	}
+
+	void TextureLoader::waitDecoded() {
+		for (auto& load : _pendingLoads) {
+			finishLoad(load);
+		}
+		_pendingLoads.clear();
+	}
+
+	void TextureLoader::finishLoad(PendingLoad& load) {
+		FF_PROFILE_ZONE("TextureLoader::finishLoad");
+		TextureData data;
+		try {
+			data = load.mFuture.get();
+		}
+		catch (const std::exception& e) {
+			//ʧʱռλ
+			std::cout << e.what() << std::endl;
+			return;
+		}
+
+		auto texture = _textureCache->getTexture(data);
+		switchAfterUpload(load.mHandle, texture);
+	}
+
+	void TextureLoader::switchAfterUpload(const TextureHandle::Ptr& handle, const Texture::Ptr& texture) {
+		//ΰ˳ɣǰִʱ֮ǰеϴҲһ
+		auto uploadingCount = _uploadingCount;
+		++(*uploadingCount);
+		_textureCache->getUploadManager()->addCompletionCallback([handle, texture, uploadingCount]() {
+			handle->setTexture(texture);
+			--(*uploadingCount);
+		});
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "../base.h"
+#include "../thread_pool.h"
+#include "texture.h"
+#include "texture_cache.h"
+
+namespace FF {
+
+	/*
+	* 첽ص
+	* ʱָռλϴ֮лΪversion֮һ
+	* ֻ߳жд
+	*/
+	class TextureHandle {
+	public:
+		using Ptr = std::shared_ptr<TextureHandle>;
+
+		static Ptr create(const std::string& path, const Texture::Ptr& placeholder) {
+			return std::make_shared<TextureHandle>(path, placeholder);
+		}
+
+		TextureHandle(const std::string& path, const Texture::Ptr& placeholder) : _path(path), _texture(placeholder) {}
+
+		~TextureHandle() = default;
+
+		[[nodiscard]] Texture::Ptr getTexture() const { return _texture; }
+
+		[[nodiscard]] const std::string& getPath() const { return _path; }
+
+		[[nodiscard]] bool isReady() const { return _ready; }
+
+		//ÿлʱӣʹ߾ݴжǷҪдdescriptor
+		[[nodiscard]] uint32_t getVersion() const { return _version; }
+
+	private:
+		friend class TextureLoader;
+
+		void setTexture(const Texture::Ptr& texture) {
+			_texture = texture;
+			_ready = true;
+			++_version;
+		}
+
+	private:
+		std::string _path{};
+		Texture::Ptr _texture{ nullptr };
+		bool _ready{ false };
+		uint32_t _version{ 0 };
+	};
+
+	/*
+	* 첽
+	* 1 loadذռλľļȡ(ԼҪʱCPU˵mipmap)ύ̳߳
+	* 2 update߳ÿ֡ãѽɵݴΪTextureϴ¼ƽUploadManagerĵǰ
+	* 3 ϴGPUִϺ(UploadManagerɻص)лΪ֤δɵͼƬ
+	* 4 ͬһ·ظloadͬһ󾭹TextureCacheͬͬһImage
+	*/
+	class TextureLoader {
+	public:
+		using Ptr = std::shared_ptr<TextureLoader>;
+
+		static Ptr create(const TextureCache::Ptr& textureCache, const ThreadPool::Ptr& threadPool) {
+			return std::make_shared<TextureLoader>(textureCache, threadPool);
+		}
+
+		TextureLoader(const TextureCache::Ptr& textureCache, const ThreadPool::Ptr& threadPool);
+
+		~TextureLoader();
+
+		TextureHandle::Ptr load(const std::string& path);
+
+		//߳ÿ֡
+		void update();
+
+		//ֱѾύϲ¼ϴϴUploadManagerύ
+		void waitDecoded();
+
+		[[nodiscard]] bool hasPendingLoads() const { return !_pendingLoads.empty() || *_uploadingCount > 0; }
+
+		[[nodiscard]] Texture::Ptr getPlaceholder() const { return _placeholder; }
+
+	private:
+		struct PendingLoad {
+			TextureHandle::Ptr mHandle{ nullptr };
+			std::future<TextureData> mFuture{};
+		};
+
+		void finishLoad(PendingLoad& load);
+
+		//ǰϴִϺѾлΪtexture
+		void switchAfterUpload(const TextureHandle::Ptr& handle, const Texture::Ptr& texture);
+
+	private:
+		TextureCache::Ptr _textureCache{ nullptr };
+		ThreadPool::Ptr _threadPool{ nullptr };
+
+		Texture::Ptr _placeholder{ nullptr };
+
+		std::map<std::string, TextureHandle::Ptr> _handles{};
+		std::vector<PendingLoad> _pendingLoads{};
+
+		//Ѿ¼ϴȴGPUִϵɻصڼԵ
+		std::shared_ptr<uint32_t> _uploadingCount{ std::make_shared<uint32_t>(0) };
+	};
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "base.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <queue>
+
+namespace FF {
+
+	/*
+	* ̶̵̳߳߳
+	* 1 submitstd::future׳쳣future.get()ʱ׳
+	* 2 ύ˳ȡִУʱȴѾύȫ
+	* 3 вҪҪⲿͬvulkan(СCommandPool)ֻCPU˵Ĺ
+	*   ǲ¼ƣÿռһCommandPool(FrameContextе¼Ʋλ)
+	*/
+	class ThreadPool {
+	public:
+		using Ptr = std::shared_ptr<ThreadPool>;
+
+		static Ptr create(uint32_t threadCount = getDefaultThreadCount()) { 
+			return std::make_shared<ThreadPool>(threadCount); 
+		}
+
+		//һĸ߳
+		static uint32_t getDefaultThreadCount() {
+			uint32_t count = std::thread::hardware_concurrency();
+			return count > 1 ? count - 1 : 1;
+		}
+
+		ThreadPool(uint32_t threadCount = getDefaultThreadCount()) {
+			for (uint32_t i = 0; i < std::max(threadCount, 1u); ++i) {
+				_workers.emplace_back([this]() { workerLoop(); });
+			}
+		}
+
+		~ThreadPool() {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stop = true;
+			}
+			_condition.notify_all();
+			for (auto& worker : _workers) {
+				worker.join();
+			}
+		}
+
+		template<typename F, typename... Args>
+		auto submit(F&& func, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+			using Result = std::invoke_result_t<F, Args...>;
+
+			auto task = std::make_shared<std::packaged_task<Result()>>(
+				std::bind(std::forward<F>(func), std::forward<Args>(args)...)
+			);
+			auto future = task->get_future();
+
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (_stop) {
+					throw std::runtime_error("Error: submit to a stopped thread pool");
+				}
+				_tasks.emplace([task]() { (*task)(); });
+			}
+			_condition.notify_one();
+
+			return future;
+		}
+
+		[[nodiscard]] uint32_t getThreadCount() const { return static_cast<uint32_t>(_workers.size()); }
+
+	private:
+		void workerLoop() {
+			while (true) {
+				std::function<void()> task;
+				{
+					std::unique_lock<std::mutex> lock(_mutex);
+					_condition.wait(lock, [this]() { return _stop || !_tasks.empty(); });
+					if (_stop && _tasks.empty()) {
+						return;
+					}
+					task = std::move(_tasks.front());
+					_tasks.pop();
+				}
+				task();
+			}
+		}
+
+	private:
+		std::vector<std::thread> _workers{};
+		std::queue<std::function<void()>> _tasks{};
+
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		bool _stop{ false };
+	};
+}
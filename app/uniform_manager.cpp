@@ -1,4 +1,5 @@
 #include "uniform_manager.h"
+#include "profiler.h"
 
 UniformManager::UniformManager(){
 
@@ -8,9 +9,29 @@ UniformManager::~UniformManager(){
 
 }
 
-void UniformManager::init(const FF::Wrapper::Device::Ptr& device,const FF::Wrapper::CommandPool::Ptr& commandPool,int frameCount) {
+void UniformManager::init(
+	const FF::Wrapper::Device::Ptr& device, 
+	const FF::TextureLoader::Ptr& textureLoader, 
+	int frameCount, 
+	uint32_t maxObjectCount,
+	const FF::Wrapper::BindlessTable::Ptr& bindlessTable
+) {
 	
 	_device = device;
+	_bindlessTable = bindlessTable;
+	_maxObjectCount = maxObjectCount;
+
+	//dynamic offsetminUniformBufferOffsetAlignment
+	VkPhysicalDeviceProperties props;
+	vkGetPhysicalDeviceProperties(device->getPhysicalDevice(), &props);
+	VkDeviceSize alignment = std::max<VkDeviceSize>(props.limits.minUniformBufferOffsetAlignment, 1);
+	_objectStride = (sizeof(ObjectUniform) + alignment - 1) / alignment * alignment;
+
+	_uniformRing = FF::Wrapper::UniformRingBuffer::create(
+		device, 
+		UNIFORM_REGION_SIZE + _objectStride * maxObjectCount, 
+		frameCount
+	);
 
 	//descriptor
 	auto vpParam = FF::Wrapper::UniformParameter::create();
@@ -20,52 +41,106 @@ void UniformManager::init(const FF::Wrapper::Device::Ptr& device,const FF::Wrapp
 	vpParam->mSize = sizeof(VPMatrices);
 	vpParam->mStage = VK_SHADER_STAGE_VERTEX_BIT;
 
-	for (int i = 0; i < frameCount; ++i) {
-		auto buffer = FF::Wrapper::Buffer::createUniformBuffer(device, vpParam->mSize, nullptr);
-		vpParam->mBuffers.push_back(buffer);
-	}
-
 	_uniformParams.push_back(vpParam);
 
 	auto objectParam = FF::Wrapper::UniformParameter::create();
 	objectParam->mBinding = 1;
 	objectParam->mCount = 1;
-	objectParam->mDescriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	objectParam->mDescriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 	objectParam->mSize = sizeof(ObjectUniform);
 	objectParam->mStage = VK_SHADER_STAGE_VERTEX_BIT;
 
+	_uniformParams.push_back(objectParam);
+
+	//ÿһ֡regionԤгvpobjectλãupdateʱͬ˳pushõoffsetһ
 	for (int i = 0; i < frameCount; ++i) {
-		auto buffer = FF::Wrapper::Buffer::createUniformBuffer(device, objectParam->mSize, nullptr);
-		objectParam->mBuffers.push_back(buffer);
-	}
+		_uniformRing->beginFrame(i);
 
-	_uniformParams.push_back(objectParam);
+		VkDeviceSize vpOffset{ 0 };
+		_uniformRing->allocate(vpParam->mSize, vpOffset);
+		vpParam->mBufferInfos.push_back({ _uniformRing->getBuffer()->getBuffer(), vpOffset, vpParam->mSize });
+
+		//descriptorֻһķΧΪ㣬һdynamic offset
+		VkDeviceSize objectOffset{ 0 };
+		_uniformRing->allocate(_objectStride * maxObjectCount, objectOffset);
+		objectParam->mBufferInfos.push_back({ _uniformRing->getBuffer()->getBuffer(), objectOffset, objectParam->mSize });
+	}
 
 	auto textureParam = FF::Wrapper::UniformParameter::create();
 	textureParam->mBinding = 2;
 	textureParam->mCount = 1;
 	textureParam->mDescriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 	textureParam->mStage = VK_SHADER_STAGE_FRAGMENT_BIT;
-	textureParam->mTexture = FF::Texture::create(_device, commandPool, "assets/asuka_langley.jpg");
+
+	//ȰռλϴɺapplyTextureUpdates滻
+	auto textureHandle = textureLoader->load("assets/asuka_langley.jpg");
+	textureParam->mTexture = textureHandle->getTexture();
 
 	_uniformParams.push_back(textureParam);
 
+	TextureBinding textureBinding{ textureParam, textureHandle, textureHandle->getVersion() };
+	if (_bindlessTable) {
+		textureBinding.mMaterial.mBaseColorTexture = _bindlessTable->addTexture(textureHandle->getTexture());
+		textureBinding.mMaterialIndex = _bindlessTable->addMaterial(textureBinding.mMaterial);
+	}
+	_textureBindings.push_back(textureBinding);
+
 	_descriptorSetLayout = FF::Wrapper::DescriptorSetLayout::create(device);
 	_descriptorSetLayout->build(_uniformParams);
 
-	_descriptorPool = FF::Wrapper::DescriptorPool::create(device);
-	_descriptorPool->build(_uniformParams, frameCount);
-
-	_descrptorSet = FF::Wrapper::DescriptorSet::create(
-		device, _uniformParams,
-		_descriptorSetLayout,
-		_descriptorPool, frameCount
-	);
+	_descriptorSetCache = FF::Wrapper::DescriptorSetCache::create(device);
+	for (int i = 0; i < frameCount; ++i) {
+		_descriptorSets.push_back(_descriptorSetCache->getDescriptorSet(_descriptorSetLayout, i));
+	}
 }
 
-void UniformManager::update(const VPMatrices& vpMatrices, const ObjectUniform& objUnifom, int frameCount) {
+void UniformManager::update(const VPMatrices& vpMatrices, const std::vector<ObjectUniform>& objects, int frameCount) {
+	FF_PROFILE_ZONE("UniformManager::update");
+	if (objects.size() > _maxObjectCount) {
+		throw std::runtime_error("Error: too many objects for uniform manager");
+	}
+
+	_uniformRing->beginFrame(frameCount);
 	//update VP Matrices
-	_uniformParams[0]->mBuffers[frameCount]->updateBufferByMap((void*)(&vpMatrices), sizeof(VPMatrices));
-	//update Obj uniform
-	_uniformParams[1]->mBuffers[frameCount]->updateBufferByMap((void*)(&objUnifom), sizeof(ObjectUniform));
-}
\ No newline at end of file
+	_uniformRing->push(&vpMatrices, sizeof(VPMatrices));
+	//update Obj uniformsstrideд
+	if (!objects.empty()) {
+		VkDeviceSize objectOffset{ 0 };
+		auto objectData = static_cast<uint8_t*>(_uniformRing->allocate(_objectStride * objects.size(), objectOffset));
+		for (size_t i = 0; i < objects.size(); ++i) {
+			memcpy(objectData + _objectStride * i, &objects[i], sizeof(ObjectUniform));
+		}
+	}
+	_uniformRing->endFrame();
+}
+
+bool UniformManager::hasTextureUpdates() const {
+	for (const auto& binding : _textureBindings) {
+		if (binding.mHandle->getVersion() != binding.mVersion) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void UniformManager::applyTextureUpdates() {
+	for (auto& binding : _textureBindings) {
+		if (binding.mHandle->getVersion() == binding.mVersion) {
+			continue;
+		}
+
+		binding.mParam->mTexture = binding.mHandle->getTexture();
+		binding.mVersion = binding.mHandle->getVersion();
+
+		//ռλ±걻ʹãɵĲʼ¼ܻڱGPUȡʶǼµ±꣬Ǹдɵ
+		if (_bindlessTable) {
+			binding.mMaterial.mBaseColorTexture = _bindlessTable->addTexture(binding.mParam->mTexture);
+			binding.mMaterialIndex = _bindlessTable->addMaterial(binding.mMaterial);
+		}
+	}
+
+	//paramsеѾ滻ͬݵdescriptorSetֱӴӻȡ
+	for (size_t i = 0; i < _descriptorSets.size(); ++i) {
+		_descriptorSets[i] = _descriptorSetCache->getDescriptorSet(_descriptorSetLayout, static_cast<int>(i));
+	}
+}
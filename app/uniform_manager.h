@@ -3,16 +3,25 @@
 #include "vulkan_wrapper/device.h"
 #include "vulkan_wrapper/swap_chain.h"
 #include "vulkan_wrapper/buffer.h"
+#include "vulkan_wrapper/uniform_ring_buffer.h"
 #include "vulkan_wrapper/descriptor_set_layout.h"
-#include "vulkan_wrapper/descriptor_pool.h"
-#include "vulkan_wrapper/descriptor_set.h"
+#include "vulkan_wrapper/descriptor_set_cache.h"
 #include "vulkan_wrapper/descriptor.h"
+#include "vulkan_wrapper/bindless_table.h"
 #include "vulkan_wrapper/device.h"
 #include "vulkan_wrapper/command_pool.h"
+#include "vulkan_wrapper/upload_manager.h"
+#include "texture/texture_loader.h"
 #include "base.h"
 
 class UniformManager {
 public:
+	//ÿһ֡ڻλУȥ֮⣬ÿ֡ĴС
+	static constexpr VkDeviceSize UNIFORM_REGION_SIZE = 64 * 1024;
+
+	//Ĭһ֡
+	static constexpr uint32_t DEFAULT_MAX_OBJECT_COUNT = 1024;
+
 	using Ptr = std::shared_ptr<UniformManager>;
 	static Ptr create() { return std::make_shared<UniformManager>(); }
 
@@ -20,27 +29,74 @@ public:
 
 	~UniformManager();
 
+	//bindlessTableΪʱͬʱǼbindlessУshaderͨ±
 	void init(
 		const FF::Wrapper::Device::Ptr& device, 
-		const FF::Wrapper::CommandPool::Ptr& commandPool, 
-		int frameCount
+		const FF::TextureLoader::Ptr& textureLoader,
+		int frameCount,
+		uint32_t maxObjectCount = DEFAULT_MAX_OBJECT_COUNT,
+		const FF::Wrapper::BindlessTable::Ptr& bindlessTable = nullptr
 	);
 
-	void update(const VPMatrices& vpMatrices, const ObjectUniform& objUnifom, int frameCount);
+	//objectsеiݣڻʱͨgetObjectDynamicOffset(i)Ϊdynamic offsetȡ
+	void update(const VPMatrices& vpMatrices, const std::vector<ObjectUniform>& objects, int frameCount);
+
+	//첽صѾdescriptorҪд
+	[[nodiscard]] bool hasTextureUpdates() const;
+
+	/*
+	* þӻȡÿһ֡descriptorSetɵdescriptorSetᱻд
+	* úҪ¼CommandBufferܰµdescriptorSet
+	* bindlessģʽдbindless±겢ǼһµĲʼ¼getMaterialIndexµ±꣬
+	* ɵļ¼ֲ䣬ִе֡Ӱ
+	*/
+	void applyTextureUpdates();
+
+	[[nodiscard]] uint32_t getObjectDynamicOffset(uint32_t objectIndex) const { 
+		return static_cast<uint32_t>(_objectStride * objectIndex); 
+	}
+
+	[[nodiscard]] uint32_t getMaxObjectCount() const { return _maxObjectCount; }
+
+	//bindlessģʽʹõĲ±꣬ʱͨpush constantshader
+	[[nodiscard]] uint32_t getMaterialIndex() const { return _textureBindings.front().mMaterialIndex; }
 
 	[[nodiscard]] FF::Wrapper::DescriptorSetLayout::Ptr getDescriptorSetLayout() const { return _descriptorSetLayout; }
-	
-	[[nodiscard]] FF::Wrapper::DescriptorPool::Ptr getDescriptorPool() const { return _descriptorPool; }
 
-	[[nodiscard]] const VkDescriptorSet& getDescriptorSet(int frameCount) const { return _descrptorSet->getDescriptorSet(frameCount); }
+	[[nodiscard]] const VkDescriptorSet& getDescriptorSet(int frameCount) const { return _descriptorSets.at(frameCount); }
+
+	[[nodiscard]] FF::Wrapper::UniformRingBuffer::Ptr getUniformRingBuffer() const { return _uniformRing; }
 
 private:
 
 	std::vector<FF::Wrapper::UniformParameter::Ptr> _uniformParams;
 
+	//첽صbindingmVersionΪдdescriptorʱİ汾
+	struct TextureBinding {
+		FF::Wrapper::UniformParameter::Ptr mParam{ nullptr };
+		FF::TextureHandle::Ptr mHandle{ nullptr };
+		uint32_t mVersion{ 0 };
+
+		//bindlessģʽĲ
+		uint32_t mMaterialIndex{ 0 };
+		FF::Wrapper::MaterialRecord mMaterial{};
+	};
+	std::vector<TextureBinding> _textureBindings{};
+
+	//ÿ֡仯uniformз֣ÿuniformÿ֡һBuffer
+	FF::Wrapper::UniformRingBuffer::Ptr _uniformRing{ nullptr };
+
+	//ObjectUniformÿ֡regionһУʹUNIFORM_BUFFER_DYNAMICƫ
+	VkDeviceSize _objectStride{ 0 };
+	uint32_t _maxObjectCount{ 0 };
+
 	FF::Wrapper::DescriptorSetLayout::Ptr _descriptorSetLayout{ nullptr };
-	FF::Wrapper::DescriptorPool::Ptr _descriptorPool{ nullptr };
-	FF::Wrapper::DescriptorSet::Ptr _descrptorSet{ nullptr };
+	FF::Wrapper::DescriptorSetCache::Ptr _descriptorSetCache{ nullptr };
+
+	//ǰÿһ֡ʹõdescriptorSet_descriptorSetCache
+	std::vector<VkDescriptorSet> _descriptorSets{};
+
+	FF::Wrapper::BindlessTable::Ptr _bindlessTable{ nullptr };
 
 	FF::Wrapper::Device::Ptr _device{ nullptr };
 };
\ No newline at end of file
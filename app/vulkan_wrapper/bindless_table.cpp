@@ -0,0 +1,142 @@
+#include "bindless_table.h"
+#include <cstring>
+
+namespace FF::Wrapper {
+
+	BindlessTable::BindlessTable(const Device::Ptr& device, uint32_t maxTextureCount, uint32_t maxMaterialCount) {
+		_device = device;
+
+		if (!_device->isBindlessSupported()) {
+			throw std::runtime_error("Error: descriptor indexing is not supported");
+		}
+
+		_maxTextureCount = std::min(maxTextureCount, _device->getMaxBindlessTextureCount());
+		_maxMaterialCount = maxMaterialCount;
+
+		createLayout();
+
+		//update after bindDescriptorSetӴUPDATE_AFTER_BIND־poolз
+		_pool = DescriptorPool::create(
+			_device, 1,
+			{
+				{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1.0f },
+				{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, static_cast<float>(_maxTextureCount) }
+			},
+			VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT
+		);
+
+		std::vector<VkDescriptorSet> descriptorSets{};
+		if (_pool->allocate({ _layout }, descriptorSets) != VK_SUCCESS) {
+			throw std::runtime_error("Error: failed to allocate bindless descriptor set");
+		}
+		_descriptorSet = descriptorSets[0];
+
+		_materialBuffer = Buffer::create(
+			_device,
+			sizeof(MaterialRecord) * _maxMaterialCount,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+		);
+
+		VkWriteDescriptorSet descriptorSetWrite{};
+		descriptorSetWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorSetWrite.dstSet = _descriptorSet;
+		descriptorSetWrite.dstBinding = 0;
+		descriptorSetWrite.dstArrayElement = 0;
+		descriptorSetWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		descriptorSetWrite.descriptorCount = 1;
+		descriptorSetWrite.pBufferInfo = &_materialBuffer->getDescriptorBufferInfo();
+
+		vkUpdateDescriptorSets(_device->getDevice(), 1, &descriptorSetWrite, 0, nullptr);
+	}
+
+	BindlessTable::~BindlessTable() {
+		_pool.reset();
+		if (_layout != VK_NULL_HANDLE) {
+			vkDestroyDescriptorSetLayout(_device->getDevice(), _layout, nullptr);
+		}
+	}
+
+	void BindlessTable::createLayout() {
+		std::array<VkDescriptorSetLayoutBinding, 2> layoutBindings{};
+
+		layoutBindings[0].binding = 0;
+		layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		layoutBindings[0].descriptorCount = 1;
+		layoutBindings[0].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+		layoutBindings[1].binding = 1;
+		layoutBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		layoutBindings[1].descriptorCount = _maxTextureCount;
+		layoutBindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+		//bufferֻڰ֮ǰдһΣҪı־
+		std::array<VkDescriptorBindingFlags, 2> bindingFlags{
+			0,
+			VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+			VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+			VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT
+		};
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+		bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+		bindingFlagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+		bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+		VkDescriptorSetLayoutCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		createInfo.pNext = &bindingFlagsInfo;
+		createInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+		createInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+		createInfo.pBindings = layoutBindings.data();
+
+		StateKeyWriter keyWriter;
+		keyWriter.writeSetLayout(createInfo);
+		_layoutKey = keyWriter.getBytes();
+
+		if (vkCreateDescriptorSetLayout(_device->getDevice(), &createInfo, nullptr, &_layout) != VK_SUCCESS) {
+			throw std::runtime_error("Error: failed to create bindless descriptor set layout");
+		}
+	}
+
+	uint32_t BindlessTable::addTexture(const Texture::Ptr& texture) {
+		auto iter = _textureIndices.find(texture.get());
+		if (iter != _textureIndices.end()) {
+			return iter->second;
+		}
+
+		if (_textures.size() >= _maxTextureCount) {
+			throw std::runtime_error("Error: bindless texture table is full");
+		}
+
+		auto index = static_cast<uint32_t>(_textures.size());
+		_textures.push_back(texture);
+		_textureIndices[texture.get()] = index;
+		writeTexture(index);
+		return index;
+	}
+
+	void BindlessTable::writeTexture(uint32_t index) {
+		VkWriteDescriptorSet descriptorSetWrite{};
+		descriptorSetWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorSetWrite.dstSet = _descriptorSet;
+		descriptorSetWrite.dstBinding = 1;
+		descriptorSetWrite.dstArrayElement = index;
+		descriptorSetWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorSetWrite.descriptorCount = 1;
+		descriptorSetWrite.pImageInfo = &_textures[index]->getImageInfo();
+
+		vkUpdateDescriptorSets(_device->getDevice(), 1, &descriptorSetWrite, 0, nullptr);
+	}
+
+	uint32_t BindlessTable::addMaterial(const MaterialRecord& material) {
+		if (_materialCount >= _maxMaterialCount) {
+			throw std::runtime_error("Error: bindless material table is full");
+		}
+
+		auto index = _materialCount++;
+		auto data = static_cast<uint8_t*>(_materialBuffer->getMappedData());
+		memcpy(data + sizeof(MaterialRecord) * index, &material, sizeof(MaterialRecord));
+		return index;
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../base.h"
+#include <unordered_map>
+#include "device.h"
+#include "buffer.h"
+#include "descriptor_pool.h"
+#include "pipeline_state_key.h"
+#include "../texture/texture.h"
+
+namespace FF::Wrapper {
+
+	//shaderstd430ŲMaterialRecordһ£textureΪBindlessTableе±
+	struct MaterialRecord {
+		uint32_t mBaseColorTexture{ 0 };
+		uint32_t mPadding[3]{ 0, 0, 0 };
+		glm::vec4 mBaseColorFactor{ 1.0f };
+	};
+
+	/*
+	* bindlessʱ
+	* 1 binding 0Ϊʼ¼storage bufferbinding 1ΪһܴCOMBINED_IMAGE_SAMPLER飬shader±
+	* 2 partially boundģûд±ֻҪshaderʾͺϷ
+	* 3 update after bindģдµ±겻ʹѾ¼˰󶨵CommandBufferʧЧ
+	*   ͬʵʱֻҪлpush constantеĲ±꣬лDescriptorSet
+	* 4 ±ʼ¼ֻӲдռλܱʹãɵĲʼ¼ܻڱִе֡ȡ
+	*   ʱ仯ʱǼһµļ¼лpush constantе±꣬ҪȴGPU
+	*/
+	class BindlessTable {
+	public:
+		static constexpr uint32_t DEFAULT_MAX_TEXTURE_COUNT = 4096;
+		static constexpr uint32_t DEFAULT_MAX_MATERIAL_COUNT = 4096;
+
+		using Ptr = std::shared_ptr<BindlessTable>;
+		static Ptr create(
+			const Device::Ptr& device,
+			uint32_t maxTextureCount = DEFAULT_MAX_TEXTURE_COUNT,
+			uint32_t maxMaterialCount = DEFAULT_MAX_MATERIAL_COUNT
+		) {
+			return std::make_shared<BindlessTable>(device, maxTextureCount, maxMaterialCount);
+		}
+
+		BindlessTable(
+			const Device::Ptr& device,
+			uint32_t maxTextureCount = DEFAULT_MAX_TEXTURE_COUNT,
+			uint32_t maxMaterialCount = DEFAULT_MAX_MATERIAL_COUNT
+		);
+
+		~BindlessTable();
+
+		//ͬһTextureֻռһ±
+		uint32_t addTexture(const Texture::Ptr& texture);
+
+		uint32_t addMaterial(const MaterialRecord& material);
+
+		[[nodiscard]] VkDescriptorSetLayout getLayout() const { return _layout; }
+
+		[[nodiscard]] const std::vector<uint8_t>& getLayoutKey() const { return _layoutKey; }
+
+		[[nodiscard]] VkDescriptorSet getDescriptorSet() const { return _descriptorSet; }
+
+		[[nodiscard]] uint32_t getTextureCount() const { return static_cast<uint32_t>(_textures.size()); }
+
+		[[nodiscard]] uint32_t getMaterialCount() const { return _materialCount; }
+
+	private:
+		void createLayout();
+
+		void writeTexture(uint32_t index);
+
+	private:
+		Device::Ptr _device{ nullptr };
+
+		uint32_t _maxTextureCount{ 0 };
+		uint32_t _maxMaterialCount{ 0 };
+
+		VkDescriptorSetLayout _layout{ VK_NULL_HANDLE };
+		std::vector<uint8_t> _layoutKey{};
+		DescriptorPool::Ptr _pool{ nullptr };
+		VkDescriptorSet _descriptorSet{ VK_NULL_HANDLE };
+
+		//±꼴еλã֤ڱڼ䲻
+		std::vector<Texture::Ptr> _textures{};
+		std::unordered_map<Texture*, uint32_t> _textureIndices{};
+
+		//HostVisibleʼ¼ֱдӳڴ
+		Buffer::Ptr _materialBuffer{ nullptr };
+		uint32_t _materialCount{ 0 };
+	};
+}
@@ -1,6 +1,5 @@
 #include "buffer.h"
-#include "command_buffer.h"
-#include "command_pool.h"
+#include "upload_manager.h"
 
 namespace FF::Wrapper {
 
@@ -17,22 +16,13 @@ namespace FF::Wrapper {
 			throw std::runtime_error("Error: failed to create buffer");
 		}
 
-		//Դռ
+		//Դռ䣬Deviceķгһ
 		VkMemoryRequirements memReq{};
 		vkGetBufferMemoryRequirements(_device->getDevice(), _buffer, &memReq);
 
-		VkMemoryAllocateInfo allocInfo{};
-		allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-		allocInfo.allocationSize = memReq.size;
+		_allocation = _device->getAllocator()->allocate(memReq, properties, true);
 
-		//bufferڴ͵ID
-		allocInfo.memoryTypeIndex = findMemoryType(memReq.memoryTypeBits, properties);
-
-		if (vkAllocateMemory(_device->getDevice(), &allocInfo, nullptr, &_bufferMemory) != VK_SUCCESS) {
-			throw std::runtime_error("Error: failed to allocate memory");
-		}
-
-		vkBindBufferMemory(_device->getDevice(), _buffer, _bufferMemory, 0);
+		vkBindBufferMemory(_device->getDevice(), _buffer, _allocation.mMemory, _allocation.mOffset);
 
 		_bufferInfo.buffer = _buffer;
 		_bufferInfo.offset = 0;
@@ -43,72 +33,50 @@ namespace FF::Wrapper {
 		if (_buffer != VK_NULL_HANDLE) {
 			vkDestroyBuffer(_device->getDevice(), _buffer, nullptr);
 		}
-		if (_bufferMemory != VK_NULL_HANDLE) {
-			vkFreeMemory(_device->getDevice(), _bufferMemory, nullptr);
-		}
-
-	}
-
-	uint32_t Buffer::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-		VkPhysicalDeviceMemoryProperties memProps;
-		vkGetPhysicalDeviceMemoryProperties(_device->getPhysicalDevice(), &memProps);
-
-		// typeFilter=0x0001|0x0100 i==0ʱ (typeFilter & (1 << i) Ϊ棬
-		//typeFilterΪ±Ļֻ±Ϊ 1<<i
-
-		for (uint32_t i = 0; i < memProps.memoryTypeCount; ++i) {
-			if ((typeFilter & (1 << i)) && ((memProps.memoryTypes[i].propertyFlags & properties) == properties)) {
-				return i;
-			}
-		}
-		throw std::runtime_error("Error: failed to find the property memory type");
+		_device->getAllocator()->free(_allocation);
 	}
 
 	void Buffer::updateBufferByMap(void* data, size_t size) {
-		void* memPtr = nullptr;
-		vkMapMemory(_device->getDevice(), _bufferMemory, 0, size, 0, &memPtr);
-		memcpy(memPtr, data, size);
-		vkUnmapMemory(_device->getDevice(), _bufferMemory);
-	}
-
-	void Buffer::updateBufferByStage(void* data, size_t size) {
-		auto stageBuffer = Buffer::create(
-			_device, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, 
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-		);
-
-		stageBuffer->updateBufferByMap(data, size);
-		copyBuffer(stageBuffer->getBuffer(), _buffer, static_cast<VkDeviceSize>(size));
+		//ڴѾפӳ䣬Ҫÿmap/unmap
+		if (_allocation.mMappedData == nullptr) {
+			throw std::runtime_error("Error: buffer memory is not host visible");
+		}
+		memcpy(_allocation.mMappedData, data, size);
+		_device->getAllocator()->flush(_allocation, 0, size);
 	}
 
-	void Buffer::copyBuffer(const VkBuffer& srcBuffer, const VkBuffer& dstBuffer, VkDeviceSize size) {
-		auto commandPool = CommandPool::create(_device);
-		auto commandBuffer = CommandBuffer::create(_device, commandPool);
-		commandBuffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-		VkBufferCopy copyInfo{};
-		copyInfo.size = size;
-		commandBuffer->copyBufferToBuffer(srcBuffer, dstBuffer, 1, { copyInfo });
-		commandBuffer->end();
-		commandBuffer->submitSync(_device->getGraphicQueue(), VK_NULL_HANDLE);
+	void Buffer::updateBufferByStage(const std::shared_ptr<UploadManager>& uploadManager, void* data, size_t size) {
+		//ȿUploadManagerstagingָ浱ǰһύ
+		uploadManager->uploadBuffer(shared_from_this(), data, static_cast<VkDeviceSize>(size));
 	}
 
-	Buffer::Ptr Buffer::createVertexBuffer(const Device::Ptr& device, VkDeviceSize size, void* data) {
+	Buffer::Ptr Buffer::createVertexBuffer(
+		const Device::Ptr& device, 
+		const std::shared_ptr<UploadManager>& uploadManager, 
+		VkDeviceSize size, 
+		void* data
+	) {
 		auto buffer = Buffer::create(
 			device, size,
 			VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
 			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
 		);
-		buffer->updateBufferByStage(data, size);
+		buffer->updateBufferByStage(uploadManager, data, size);
 		return buffer;
 	}
 
-	Buffer::Ptr Buffer::createIndexBuffer(const Device::Ptr& device, VkDeviceSize size, void* data) {
+	Buffer::Ptr Buffer::createIndexBuffer(
+		const Device::Ptr& device, 
+		const std::shared_ptr<UploadManager>& uploadManager, 
+		VkDeviceSize size, 
+		void* data
+	) {
 		auto buffer = Buffer::create(
 			device, size,
 			VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
 			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
 		);
-		buffer->updateBufferByStage(data, size);
+		buffer->updateBufferByStage(uploadManager, data, size);
 		return buffer;
 	}
 
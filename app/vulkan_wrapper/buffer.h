@@ -4,7 +4,9 @@
 #include "device.h"
 
 namespace FF::Wrapper {
-	class Buffer {
+	class UploadManager;
+
+	class Buffer :public std::enable_shared_from_this<Buffer> {
 	public:
 		using Ptr = std::shared_ptr<Buffer>;
 		static Ptr create(
@@ -22,35 +24,47 @@ namespace FF::Wrapper {
 		/*
 		* Bufferķ
 		* 1 ͨڴMappingʽֱӶڴиģHostVisible(CPUɼ)͵ڴ
-		* 2 ڴLocalOptimal(GPUɼ)ô봴мStageBufferȸƵStageBufferٿ뵽ĿBuffer
+		* 2 ڴLocalOptimal(GPUɼ)ô뾭StageBufferȸƵStageBufferٿ뵽ĿBuffer
+		*   һUploadManager¼Ʋ첽ύ
 		*/
 
 		void updateBufferByMap(void* data, size_t size);
 
-		void updateBufferByStage(void* data, size_t size);
-
-		void copyBuffer(const VkBuffer& srcBuffer, const VkBuffer& dstBuffer, VkDeviceSize size);
+		void updateBufferByStage(const std::shared_ptr<UploadManager>& uploadManager, void* data, size_t size);
 
 	public:
 
 		[[nodiscard]] VkBuffer getBuffer() const { return _buffer; }
 
 		[[nodiscard]] const VkDescriptorBufferInfo& getDescriptorBufferInfo() const { return _bufferInfo; }
+
+		//HostVisibleBufferפӳ䣬෵nullptr
+		[[nodiscard]] void* getMappedData() const { return _allocation.mMappedData; }
+
+		[[nodiscard]] const MemoryAllocation& getAllocation() const { return _allocation; }
 	public:
 
-		static Ptr createVertexBuffer(const Device::Ptr& device, VkDeviceSize size, void* data);
+		static Ptr createVertexBuffer(
+			const Device::Ptr& device, 
+			const std::shared_ptr<UploadManager>& uploadManager, 
+			VkDeviceSize size, 
+			void* data
+		);
 
-		static Ptr createIndexBuffer(const Device::Ptr& device, VkDeviceSize size, void* data);
+		static Ptr createIndexBuffer(
+			const Device::Ptr& device, 
+			const std::shared_ptr<UploadManager>& uploadManager, 
+			VkDeviceSize size, 
+			void* data
+		);
 
 		static Ptr createUniformBuffer(const Device::Ptr& device, VkDeviceSize size, void* data = nullptr);
 
 		static Ptr createStageBuffer(const Device::Ptr& device, VkDeviceSize size, void* data = nullptr);
 
-	private:
-		uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags);
 	private:
 		VkBuffer _buffer{ VK_NULL_HANDLE };
-		VkDeviceMemory _bufferMemory{ VK_NULL_HANDLE };
+		MemoryAllocation _allocation{};
 		Device::Ptr _device{ nullptr };
 		VkDescriptorBufferInfo _bufferInfo{};
 	};
@@ -40,6 +40,8 @@ namespace FF::Wrapper {
 		const VkRenderPassBeginInfo& renderPassBeginInfo, 
 		const VkSubpassContents& subPassContents
 	) {
+		//renderPassڲbarrier
+		flushBarriers();
 		vkCmdBeginRenderPass(_commandBuffer, &renderPassBeginInfo, subPassContents);
 	}
 
@@ -60,15 +62,51 @@ namespace FF::Wrapper {
 		vkCmdBindIndexBuffer(_commandBuffer, buffer, 0, VK_INDEX_TYPE_UINT32);
 	}
 
-	void CommandBuffer::bindDescriptorSet(const VkPipelineLayout& layout, const VkDescriptorSet& descriptorSet) {
-		vkCmdBindDescriptorSets(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet, 0, nullptr);
+	void CommandBuffer::bindDescriptorSet(const VkPipelineLayout& layout, const VkDescriptorSet& descriptorSet, const std::vector<uint32_t>& dynamicOffsets) {
+		vkCmdBindDescriptorSets(
+			_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet,
+			static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data()
+		);
+	}
+
+	void CommandBuffer::bindDescriptorSets(
+		const VkPipelineLayout& layout,
+		uint32_t firstSet,
+		const std::vector<VkDescriptorSet>& descriptorSets,
+		const std::vector<uint32_t>& dynamicOffsets
+	) {
+		vkCmdBindDescriptorSets(
+			_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, firstSet,
+			static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(),
+			static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data()
+		);
+	}
+
+	void CommandBuffer::pushConstants(
+		const VkPipelineLayout& layout,
+		VkShaderStageFlags stageFlags,
+		uint32_t offset,
+		uint32_t size,
+		const void* data
+	) {
+		vkCmdPushConstants(_commandBuffer, layout, stageFlags, offset, size, data);
+	}
+
+	void CommandBuffer::setViewport(const VkViewport& viewport) {
+		vkCmdSetViewport(_commandBuffer, 0, 1, &viewport);
+	}
+
+	void CommandBuffer::setScissor(const VkRect2D& scissor) {
+		vkCmdSetScissor(_commandBuffer, 0, 1, &scissor);
 	}
 
 	void CommandBuffer::draw(size_t vertexCount) {
+		flushBarriers();
 		vkCmdDraw(_commandBuffer, vertexCount, 1, 0, 0);
 	}
 
 	void CommandBuffer::drawIndex(size_t indexCount) {
+		flushBarriers();
 		vkCmdDrawIndexed(_commandBuffer, indexCount, 1, 0, 0, 0);
 	}
 
@@ -76,13 +114,28 @@ namespace FF::Wrapper {
 		vkCmdEndRenderPass(_commandBuffer);
 	}
 
+	void CommandBuffer::executeCommands(const std::vector<VkCommandBuffer>& commandBuffers) {
+		flushBarriers();
+		vkCmdExecuteCommands(_commandBuffer, static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+	}
+
+	void CommandBuffer::resetQueryPool(VkQueryPool queryPool, uint32_t firstQuery, uint32_t queryCount) {
+		vkCmdResetQueryPool(_commandBuffer, queryPool, firstQuery, queryCount);
+	}
+
+	void CommandBuffer::writeTimestamp(VkPipelineStageFlagBits stage, VkQueryPool queryPool, uint32_t query) {
+		vkCmdWriteTimestamp(_commandBuffer, stage, queryPool, query);
+	}
+
 	void CommandBuffer::end() {
+		flushBarriers();
 		if (vkEndCommandBuffer(_commandBuffer) != VK_SUCCESS) {
 			throw std::runtime_error("Error: failed to end command buffer");
 		}
 	}
 
 	void CommandBuffer::copyBufferToBuffer(VkBuffer srcBuffer, VkBuffer destBuffer, uint32_t copyInfoCount, const std::vector<VkBufferCopy>& copyInfos) {
+		flushBarriers();
 		vkCmdCopyBuffer(_commandBuffer, srcBuffer, destBuffer, copyInfoCount, copyInfos.data());
 	}
 
@@ -101,9 +154,50 @@ namespace FF::Wrapper {
 		region.imageOffset = { 0,0,0 };
 		region.imageExtent = { width,height,1 };
 
+		flushBarriers();
 		vkCmdCopyBufferToImage(_commandBuffer, srcBuffer, dstImage, dstImageLayout, 1, &region);
 	}
 
+	void CommandBuffer::copyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, VkImageLayout dstImageLayout, const std::vector<VkBufferImageCopy>& regions) {
+		flushBarriers();
+		vkCmdCopyBufferToImage(_commandBuffer, srcBuffer, dstImage, dstImageLayout, static_cast<uint32_t>(regions.size()), regions.data());
+	}
+
+	void CommandBuffer::copyImageToBuffer(VkImage srcImage, VkImageLayout srcImageLayout, VkBuffer dstBuffer, uint32_t width, uint32_t height) {
+		VkBufferImageCopy region{};
+		region.bufferOffset = 0;
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = 0;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+		region.imageOffset = { 0,0,0 };
+		region.imageExtent = { width,height,1 };
+
+		flushBarriers();
+		vkCmdCopyImageToBuffer(_commandBuffer, srcImage, srcImageLayout, dstBuffer, 1, &region);
+	}
+
+	void CommandBuffer::blitImage(
+		VkImage srcImage,
+		VkImageLayout srcImageLayout,
+		VkImage dstImage,
+		VkImageLayout dstImageLayout,
+		const std::vector<VkImageBlit>& regions,
+		VkFilter filter
+	) {
+		flushBarriers();
+		vkCmdBlitImage(
+			_commandBuffer,
+			srcImage, srcImageLayout,
+			dstImage, dstImageLayout,
+			static_cast<uint32_t>(regions.size()), regions.data(),
+			filter
+		);
+	}
+
 	void CommandBuffer::submitSync(VkQueue queue, VkFence fence) {
 		VkSubmitInfo submitInfo{};
 		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -115,19 +209,190 @@ namespace FF::Wrapper {
 		vkQueueWaitIdle(queue);
 	}
 
-	void CommandBuffer::transferImageLayout(
-		const VkImageMemoryBarrier& imageMemoryBarrier,
-		const VkPipelineStageFlags& srcStageMask,
-		const VkPipelineStageFlags& dstStageMask) {
+	void CommandBuffer::submit(
+		VkQueue queue, 
+		VkFence fence,
+		const std::vector<VkSemaphore>& waitSemaphores,
+		const std::vector<VkPipelineStageFlags>& waitStages,
+		const std::vector<VkSemaphore>& signalSemaphores
+	) {
+		assert(waitSemaphores.size() == waitStages.size());
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &_commandBuffer;
+
+		submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+		submitInfo.pWaitSemaphores = waitSemaphores.data();
+		submitInfo.pWaitDstStageMask = waitStages.data();
+
+		submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+		submitInfo.pSignalSemaphores = signalSemaphores.data();
+
+		if (vkQueueSubmit(queue, 1, &submitInfo, fence) != VK_SUCCESS) {
+			throw std::runtime_error("Error: failed to submit command buffer");
+		}
+	}
+
+	void CommandBuffer::memoryBarrier(
+		VkPipelineStageFlags srcStageMask, 
+		VkPipelineStageFlags dstStageMask, 
+		VkAccessFlags srcAccessMask, 
+		VkAccessFlags dstAccessMask
+	) {
+		VkMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask = srcAccessMask;
+		barrier.dstAccessMask = dstAccessMask;
+
+		addMemoryBarrier(barrier, srcStageMask, dstStageMask);
+	}
+
+	void CommandBuffer::releaseBufferOwnership(
+		VkBuffer buffer,
+		uint32_t srcQueueFamily,
+		uint32_t dstQueueFamily,
+		VkPipelineStageFlags srcStageMask,
+		VkAccessFlags srcAccessMask
+	) {
+		VkBufferMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		barrier.srcAccessMask = srcAccessMask;
+		//releaseһdstAccessMaskᱻ
+		barrier.dstAccessMask = 0;
+		barrier.srcQueueFamilyIndex = srcQueueFamily;
+		barrier.dstQueueFamilyIndex = dstQueueFamily;
+		barrier.buffer = buffer;
+		barrier.offset = 0;
+		barrier.size = VK_WHOLE_SIZE;
+
+		addBufferBarrier(barrier, srcStageMask, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+	}
+
+	void CommandBuffer::acquireBufferOwnership(
+		VkBuffer buffer,
+		uint32_t srcQueueFamily,
+		uint32_t dstQueueFamily,
+		VkPipelineStageFlags dstStageMask,
+		VkAccessFlags dstAccessMask
+	) {
+		VkBufferMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		//acquireһsrcAccessMaskᱻ
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = dstAccessMask;
+		barrier.srcQueueFamilyIndex = srcQueueFamily;
+		barrier.dstQueueFamilyIndex = dstQueueFamily;
+		barrier.buffer = buffer;
+		barrier.offset = 0;
+		barrier.size = VK_WHOLE_SIZE;
+
+		addBufferBarrier(barrier, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStageMask);
+	}
+
+	void CommandBuffer::releaseImageOwnership(
+		VkImage image,
+		const VkImageSubresourceRange& subresourceRange,
+		VkImageLayout oldLayout,
+		VkImageLayout newLayout,
+		uint32_t srcQueueFamily,
+		uint32_t dstQueueFamily,
+		VkPipelineStageFlags srcStageMask,
+		VkAccessFlags srcAccessMask
+	) {
+		VkImageMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcAccessMask = srcAccessMask;
+		barrier.dstAccessMask = 0;
+		barrier.oldLayout = oldLayout;
+		barrier.newLayout = newLayout;
+		barrier.srcQueueFamilyIndex = srcQueueFamily;
+		barrier.dstQueueFamilyIndex = dstQueueFamily;
+		barrier.image = image;
+		barrier.subresourceRange = subresourceRange;
+
+		addImageBarrier(barrier, srcStageMask, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+	}
+
+	void CommandBuffer::acquireImageOwnership(
+		VkImage image,
+		const VkImageSubresourceRange& subresourceRange,
+		VkImageLayout oldLayout,
+		VkImageLayout newLayout,
+		uint32_t srcQueueFamily,
+		uint32_t dstQueueFamily,
+		VkPipelineStageFlags dstStageMask,
+		VkAccessFlags dstAccessMask
+	) {
+		VkImageMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcAccessMask = 0;
+		barrier.dstAccessMask = dstAccessMask;
+		barrier.oldLayout = oldLayout;
+		barrier.newLayout = newLayout;
+		barrier.srcQueueFamilyIndex = srcQueueFamily;
+		barrier.dstQueueFamilyIndex = dstQueueFamily;
+		barrier.image = image;
+		barrier.subresourceRange = subresourceRange;
+
+		addImageBarrier(barrier, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStageMask);
+	}
+
+	void CommandBuffer::addImageBarrier(const VkImageMemoryBarrier& barrier, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask) {
+		auto overlap = [](uint32_t baseA, uint32_t countA, uint32_t baseB, uint32_t countB) {
+			uint64_t endA = countA == VK_REMAINING_MIP_LEVELS ? UINT64_MAX : static_cast<uint64_t>(baseA) + countA;
+			uint64_t endB = countB == VK_REMAINING_MIP_LEVELS ? UINT64_MAX : static_cast<uint64_t>(baseB) + countB;
+			return baseA < endB && baseB < endA;
+		};
+
+		for (const auto& pending : _pendingImageBarriers) {
+			const auto& a = pending.subresourceRange;
+			const auto& b = barrier.subresourceRange;
+			if (pending.image == barrier.image &&
+				overlap(a.baseMipLevel, a.levelCount, b.baseMipLevel, b.levelCount) &&
+				overlap(a.baseArrayLayer, a.layerCount, b.baseArrayLayer, b.layerCount)) {
+				flushBarriers();
+				break;
+			}
+		}
+
+		_pendingImageBarriers.push_back(barrier);
+		_pendingSrcStageMask |= srcStageMask;
+		_pendingDstStageMask |= dstStageMask;
+	}
+
+	void CommandBuffer::addBufferBarrier(const VkBufferMemoryBarrier& barrier, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask) {
+		_pendingBufferBarriers.push_back(barrier);
+		_pendingSrcStageMask |= srcStageMask;
+		_pendingDstStageMask |= dstStageMask;
+	}
+
+	void CommandBuffer::addMemoryBarrier(const VkMemoryBarrier& barrier, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask) {
+		_pendingMemoryBarriers.push_back(barrier);
+		_pendingSrcStageMask |= srcStageMask;
+		_pendingDstStageMask |= dstStageMask;
+	}
+
+	void CommandBuffer::flushBarriers() {
+		if (!hasPendingBarriers()) {
+			return;
+		}
 
 		vkCmdPipelineBarrier(
 			_commandBuffer,
-			srcStageMask,
-			dstStageMask,
+			_pendingSrcStageMask,
+			_pendingDstStageMask,
 			0,
-			0, nullptr,//memory barrier
-			0, nullptr,//buffer memory barrier
-			1, &imageMemoryBarrier//image memory barrier
+			static_cast<uint32_t>(_pendingMemoryBarriers.size()), _pendingMemoryBarriers.data(),
+			static_cast<uint32_t>(_pendingBufferBarriers.size()), _pendingBufferBarriers.data(),
+			static_cast<uint32_t>(_pendingImageBarriers.size()), _pendingImageBarriers.data()
 		);
+
+		_pendingMemoryBarriers.clear();
+		_pendingBufferBarriers.clear();
+		_pendingImageBarriers.clear();
+		_pendingSrcStageMask = 0;
+		_pendingDstStageMask = 0;
 	}
 }
\ No newline at end of file
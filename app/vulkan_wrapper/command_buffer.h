@@ -54,7 +54,33 @@ namespace FF::Wrapper {
 
 		void bindIndexBuffer(const VkBuffer& buffer);
 
-		void bindDescriptorSet(const VkPipelineLayout& layout, const VkDescriptorSet& descriptorSet);
+		//dynamicOffsetsbinding˳ΪÿһDYNAMIC͵uniformṩһƫ
+		void bindDescriptorSet(
+			const VkPipelineLayout& layout, 
+			const VkDescriptorSet& descriptorSet, 
+			const std::vector<uint32_t>& dynamicOffsets = {}
+		);
+
+		//firstSetʼ󶨶DescriptorSetset 0Ϊÿ֡uniformset 1Ϊbindless
+		void bindDescriptorSets(
+			const VkPipelineLayout& layout,
+			uint32_t firstSet,
+			const std::vector<VkDescriptorSet>& descriptorSets,
+			const std::vector<uint32_t>& dynamicOffsets = {}
+		);
+
+		void pushConstants(
+			const VkPipelineLayout& layout, 
+			VkShaderStageFlags stageFlags, 
+			uint32_t offset, 
+			uint32_t size, 
+			const void* data
+		);
+
+		//pipelineжӦ״̬Ϊ̬ʱʹ
+		void setViewport(const VkViewport& viewport);
+
+		void setScissor(const VkRect2D& scissor);
 
 		void draw(size_t vertexCount);
 
@@ -62,15 +88,120 @@ namespace FF::Wrapper {
 
 		void endRenderPass();
 
+		//ִж壬RenderPassҪVK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERSʼ
+		void executeCommands(const std::vector<VkCommandBuffer>& commandBuffers);
+
+		//òѯеһqueryҪRenderPass֮¼
+		void resetQueryPool(VkQueryPool queryPool, uint32_t firstQuery, uint32_t queryCount);
+
+		//֮ǰִָеstage׶ʱGPUʱдquery
+		void writeTimestamp(VkPipelineStageFlagBits stage, VkQueryPool queryPool, uint32_t query);
+
 		void end();
 
 		void copyBufferToBuffer(VkBuffer srcBuffer, VkBuffer destBuffer, uint32_t copyInfoCount, const std::vector<VkBufferCopy>& copyInfos);
 
 		void copyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, VkImageLayout dstImageLayout, uint32_t width, uint32_t height);
 
+		//regionsеbufferOffsetָstaging bufferеλ
+		void copyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, VkImageLayout dstImageLayout, const std::vector<VkBufferImageCopy>& regions);
+
+		//ͼƬ0ſеbufferУڶ
+		void copyImageToBuffer(VkImage srcImage, VkImageLayout srcImageLayout, VkBuffer dstBuffer, uint32_t width, uint32_t height);
+
+		//srcImagedstImageͬһͼƬĲͬmipmap
+		void blitImage(
+			VkImage srcImage, 
+			VkImageLayout srcImageLayout, 
+			VkImage dstImage, 
+			VkImageLayout dstImageLayout, 
+			const std::vector<VkImageBlit>& regions, 
+			VkFilter filter
+		);
+
+		//ύ֮ȴп
 		void submitSync(VkQueue queue, VkFence fence = VK_NULL_HANDLE);
 
-		void transferImageLayout(const VkImageMemoryBarrier& imageMemoryBarrier, const VkPipelineStageFlags& srcStageMask, const VkPipelineStageFlags& dstStageMask);
+		//ֻύȴͨfenceִ֪
+		void submit(
+			VkQueue queue, 
+			VkFence fence = VK_NULL_HANDLE,
+			const std::vector<VkSemaphore>& waitSemaphores = {},
+			const std::vector<VkPipelineStageFlags>& waitStages = {},
+			const std::vector<VkSemaphore>& signalSemaphores = {}
+		);
+
+		//ȫֵڴbarrierͬbarrier
+		void memoryBarrier(
+			VkPipelineStageFlags srcStageMask, 
+			VkPipelineStageFlags dstStageMask, 
+			VkAccessFlags srcAccessMask, 
+			VkAccessFlags dstAccessMask
+		);
+
+		/*
+		* barrier¼
+		* 1 add*Barrierֻǰbarrierռstage maskȡ
+		* 2 flushBarriersʱһvkCmdPipelineBarrierȫ¼ƣ
+		*   drawblitexecuteCommandsbeginRenderPassendȻԶflush֮ǰռbarrierһЩָ֮ǰЧ
+		* 3 ͬһͼƬԴΧصbarrierʱȰ֮ǰռflush֤layoutת˳
+		*/
+		void addImageBarrier(const VkImageMemoryBarrier& barrier, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask);
+
+		void addBufferBarrier(const VkBufferMemoryBarrier& barrier, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask);
+
+		void addMemoryBarrier(const VkMemoryBarrier& barrier, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask);
+
+		void flushBarriers();
+
+		[[nodiscard]] bool hasPendingBarriers() const {
+			return !_pendingImageBarriers.empty() || !_pendingBufferBarriers.empty() || !_pendingMemoryBarriers.empty();
+		}
+
+		/*
+		* ֮Ȩת
+		* 1 release¼ԭCommandBufferУacquire¼ĿCommandBufferУߵĲһ
+		* 2 ύ֮Ҫsemaphore֤acquirereleaseִ֮
+		* 3 ͼƬlayoutת˳һbarrierɣoldLayout/newLayout߶Ҫд
+		* 4 ⼸ֻbarrierbarrierУԴrelease/acquireendʱϲһvkCmdPipelineBarrier
+		*/
+		void releaseBufferOwnership(
+			VkBuffer buffer,
+			uint32_t srcQueueFamily,
+			uint32_t dstQueueFamily,
+			VkPipelineStageFlags srcStageMask,
+			VkAccessFlags srcAccessMask
+		);
+
+		void acquireBufferOwnership(
+			VkBuffer buffer,
+			uint32_t srcQueueFamily,
+			uint32_t dstQueueFamily,
+			VkPipelineStageFlags dstStageMask,
+			VkAccessFlags dstAccessMask
+		);
+
+		void releaseImageOwnership(
+			VkImage image,
+			const VkImageSubresourceRange& subresourceRange,
+			VkImageLayout oldLayout,
+			VkImageLayout newLayout,
+			uint32_t srcQueueFamily,
+			uint32_t dstQueueFamily,
+			VkPipelineStageFlags srcStageMask,
+			VkAccessFlags srcAccessMask
+		);
+
+		void acquireImageOwnership(
+			VkImage image,
+			const VkImageSubresourceRange& subresourceRange,
+			VkImageLayout oldLayout,
+			VkImageLayout newLayout,
+			uint32_t srcQueueFamily,
+			uint32_t dstQueueFamily,
+			VkPipelineStageFlags dstStageMask,
+			VkAccessFlags dstAccessMask
+		);
 
 	public:
 
@@ -80,5 +211,12 @@ namespace FF::Wrapper {
 		VkCommandBuffer _commandBuffer{ VK_NULL_HANDLE };
 		Device::Ptr _device{ nullptr };
 		CommandPool::Ptr _commandPool{ nullptr };
+
+		//δ¼Ƶbarrier
+		std::vector<VkImageMemoryBarrier> _pendingImageBarriers{};
+		std::vector<VkBufferMemoryBarrier> _pendingBufferBarriers{};
+		std::vector<VkMemoryBarrier> _pendingMemoryBarriers{};
+		VkPipelineStageFlags _pendingSrcStageMask{ 0 };
+		VkPipelineStageFlags _pendingDstStageMask{ 0 };
 	};
 }
\ No newline at end of file
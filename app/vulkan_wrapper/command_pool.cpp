@@ -1,11 +1,13 @@
 #include "command_pool.h"
 
 namespace FF::Wrapper {
-	CommandPool::CommandPool(const Device::Ptr& device, VkCommandPoolCreateFlagBits flag) {
+	CommandPool::CommandPool(const Device::Ptr& device, VkCommandPoolCreateFlagBits flag, std::optional<uint32_t> queueFamily) {
 		_device = device;
+		_queueFamily = queueFamily.has_value() ? queueFamily.value() : device->getGraphicQueueFamily().value();
+
 		VkCommandPoolCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-		createInfo.queueFamilyIndex = device->getGraphicQueueFamily().value();
+		createInfo.queueFamilyIndex = _queueFamily;
 
 		//ָ޸ĵԣָصڴ
 		//VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT:CommandBufferԵ£
@@ -21,4 +23,8 @@ namespace FF::Wrapper {
 			vkDestroyCommandPool(_device->getDevice(), _commandPool, nullptr);
 		}
 	}
+
+	void CommandPool::reset() {
+		vkResetCommandPool(_device->getDevice(), _commandPool, 0);
+	}
 }
\ No newline at end of file
@@ -8,21 +8,30 @@ namespace FF::Wrapper {
 	class CommandPool {
 	public:
 		using Ptr = std::shared_ptr<CommandPool>;
+		//queueFamilyΪʱʹȾ壬CommandBufferֻύöĶ
 		static Ptr create(
 			const Device::Ptr& device,
-			VkCommandPoolCreateFlagBits flag = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
+			VkCommandPoolCreateFlagBits flag = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+			std::optional<uint32_t> queueFamily = std::nullopt
 		) {
-			return std::make_shared<CommandPool>(device, flag);
+			return std::make_shared<CommandPool>(device, flag, queueFamily);
 		}
 
 		CommandPool(
 			const Device::Ptr& device,
-			VkCommandPoolCreateFlagBits flag = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
+			VkCommandPoolCreateFlagBits flag = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+			std::optional<uint32_t> queueFamily = std::nullopt
 		);
 		~CommandPool();
 
+		//зCommandBufferǰҪ֤ǶѾִ
+		void reset();
+
 		[[nodiscard]] VkCommandPool getCommandPool() const { return _commandPool; }
+
+		[[nodiscard]] uint32_t getQueueFamily() const { return _queueFamily; }
 	private:
+		uint32_t _queueFamily{ 0 };
 		VkCommandPool _commandPool{ VK_NULL_HANDLE };
 		Device::Ptr _device{ nullptr };
 	};
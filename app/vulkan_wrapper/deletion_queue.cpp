@@ -0,0 +1,38 @@
+#include "deletion_queue.h"
+
+namespace FF::Wrapper {
+
+	DeletionQueue::DeletionQueue(const SubmitScheduler::Ptr& scheduler) {
+		_scheduler = scheduler;
+	}
+
+	DeletionQueue::~DeletionQueue() {
+		flush();
+	}
+
+	void DeletionQueue::push(const std::shared_ptr<void>& resource) {
+		if (!resource) {
+			return;
+		}
+
+		Entry entry{};
+		entry.mSubmitValue = _scheduler->getSubmittedValue();
+		entry.mResource = resource;
+		_entries.push_back(entry);
+	}
+
+	void DeletionQueue::update() {
+		if (_entries.empty()) {
+			return;
+		}
+
+		uint64_t completedValue = _scheduler->getCompletedValue();
+		while (!_entries.empty() && _entries.front().mSubmitValue <= completedValue) {
+			_entries.pop_front();
+		}
+	}
+
+	void DeletionQueue::flush() {
+		_entries.clear();
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../base.h"
+#include "submit_scheduler.h"
+#include <deque>
+
+namespace FF::Wrapper {
+
+	/*
+	* ӳٶУGPUʹõԴȷŽУʹǵ֡ȫִϺͷ
+	* 1 Դshared_ptrУͷżɸWrapperٶӦVulkan
+	* 2 ʱ¼һύֵtimelineֵ֮ǰпʹύѾִ
+	* 3 ؽʱɵĽFrameBufferŽҪvkDeviceWaitIdle
+	*/
+	class DeletionQueue {
+	public:
+		using Ptr = std::shared_ptr<DeletionQueue>;
+
+		static Ptr create(const SubmitScheduler::Ptr& scheduler) {
+			return std::make_shared<DeletionQueue>(scheduler);
+		}
+
+		DeletionQueue(const SubmitScheduler::Ptr& scheduler);
+
+		~DeletionQueue();
+
+		//֮ǰύִϺͷ
+		void push(const std::shared_ptr<void>& resource);
+
+		//ÿ֡ãͷѾȫԴ
+		void update();
+
+		//ͷԴǰҪ֤豸
+		void flush();
+
+		[[nodiscard]] size_t getPendingCount() const { return _entries.size(); }
+
+	private:
+		struct Entry {
+			uint64_t mSubmitValue{ 0 };
+			std::shared_ptr<void> mResource{ nullptr };
+		};
+
+		SubmitScheduler::Ptr _scheduler{ nullptr };
+
+		//շʱύֵ
+		std::deque<Entry> _entries{};
+	};
+}
@@ -17,6 +17,9 @@ namespace FF::Wrapper {
 		VkShaderStageFlagBits mStage;
 
 		std::vector<Buffer::Ptr> mBuffers{};
+
+		//uniformUniformRingBufferӷ䣬ÿһ֡Ӧbuffer/offset/rangeǿʱmBuffers
+		std::vector<VkDescriptorBufferInfo> mBufferInfos{};
 		Texture::Ptr mTexture{ nullptr };
 	};
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "descriptor_allocator.h"
+#include <algorithm>
+
+namespace FF::Wrapper {
+
+	DescriptorAllocator::DescriptorAllocator(
+		const Device::Ptr& device,
+		const std::vector<DescriptorPoolSizeRatio>& ratios,
+		uint32_t initialSetsPerPool
+	) {
+		_device = device;
+		_ratios = ratios;
+		_setsPerPool = std::max(initialSetsPerPool, 1u);
+	}
+
+	DescriptorAllocator::~DescriptorAllocator() {
+		_usedPools.clear();
+		_freePools.clear();
+	}
+
+	std::vector<DescriptorPoolSizeRatio> DescriptorAllocator::getDefaultRatios() {
+		return {
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2.0f },
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f },
+			{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1.0f }
+		};
+	}
+
+	VkDescriptorSet DescriptorAllocator::allocate(const DescriptorSetLayout::Ptr& layout) {
+		return allocate(std::vector<DescriptorSetLayout::Ptr>{ layout }).front();
+	}
+
+	std::vector<VkDescriptorSet> DescriptorAllocator::allocate(const std::vector<DescriptorSetLayout::Ptr>& layouts) {
+		std::vector<VkDescriptorSet> descriptorSets{};
+		if (layouts.empty()) {
+			return descriptorSets;
+		}
+
+		//ͳηһҪĸdescriptor
+		std::vector<VkDescriptorSetLayout> vkLayouts{};
+		std::vector<VkDescriptorPoolSize> poolSizes{};
+		for (const auto& layout : layouts) {
+			vkLayouts.push_back(layout->getLayout());
+
+			for (const auto& layoutSize : layout->getPoolSizes()) {
+				auto iter = std::find_if(poolSizes.begin(), poolSizes.end(), [&](const VkDescriptorPoolSize& poolSize) {
+					return poolSize.type == layoutSize.type;
+				});
+
+				if (iter == poolSizes.end()) {
+					poolSizes.push_back(layoutSize);
+				}
+				else {
+					iter->descriptorCount += layoutSize.descriptorCount;
+				}
+			}
+		}
+		uint32_t setCount = static_cast<uint32_t>(layouts.size());
+
+		//ǰpoolʹǿյҲŲ£ֱӻһŵµpool
+		if (_usedPools.empty() || !_usedPools.back()->canHold(setCount, poolSizes)) {
+			_usedPools.push_back(acquirePool(setCount, poolSizes));
+		}
+
+		VkResult result = _usedPools.back()->allocate(vkLayouts, descriptorSets);
+
+		//ǰpoolһµpoolһ
+		if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+			_usedPools.push_back(acquirePool(setCount, poolSizes));
+			result = _usedPools.back()->allocate(vkLayouts, descriptorSets);
+		}
+
+		//ηҪѡ½ĿpoolҲŲ
+		if (result != VK_SUCCESS) {
+			throw std::runtime_error("Error: failed to allocate descriptor sets");
+		}
+
+		_allocatedSetCount += static_cast<uint32_t>(descriptorSets.size());
+		return descriptorSets;
+	}
+
+	void DescriptorAllocator::reset() {
+		for (auto& pool : _usedPools) {
+			pool->reset();
+			_freePools.push_back(pool);
+		}
+		_usedPools.clear();
+		_allocatedSetCount = 0;
+	}
+
+	DescriptorPool::Ptr DescriptorAllocator::acquirePool(uint32_t setCount, const std::vector<VkDescriptorPoolSize>& poolSizes) {
+		//̫СĿpoolڿбУ֮Сķʹ
+		for (auto iter = _freePools.rbegin(); iter != _freePools.rend(); ++iter) {
+			if ((*iter)->canHold(setCount, poolSizes)) {
+				auto pool = *iter;
+				_freePools.erase(std::next(iter).base());
+				return pool;
+			}
+		}
+
+		//õʱmaxSetsdescriptorηҪӴ
+		auto pool = DescriptorPool::create(_device, std::max(_setsPerPool, setCount), _ratios, 0, poolSizes);
+		_setsPerPool = std::min(_setsPerPool * 2, MAX_SETS_PER_POOL);
+		return pool;
+	}
+}
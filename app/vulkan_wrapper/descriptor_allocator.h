@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+#include "descriptor_pool.h"
+#include "descriptor_set_layout.h"
+
+namespace FF::Wrapper {
+
+	/*
+	* DescriptorSet
+	* 1 һDescriptorPoolǰpoolOUT_OF_POOL_MEMORY/FRAGMENTED_POOLʱһpool
+	* 2 ½poolmaxSetsֱMAX_SETS_PER_POOLpoolиdescriptorҪֹ
+	* 3 һηҪsetĳdescriptorõʱ½poolηҪӴ
+	* 4 DescriptorSetͷţresetʱpoolգպpoolŻؿбУ
+	*   ֻŵηĿpoolŻᱻ
+	*/
+	class DescriptorAllocator {
+	public:
+		static constexpr uint32_t DEFAULT_SETS_PER_POOL = 64;
+		static constexpr uint32_t MAX_SETS_PER_POOL = 4096;
+
+		using Ptr = std::shared_ptr<DescriptorAllocator>;
+		static Ptr create(
+			const Device::Ptr& device,
+			const std::vector<DescriptorPoolSizeRatio>& ratios = getDefaultRatios(),
+			uint32_t initialSetsPerPool = DEFAULT_SETS_PER_POOL
+		) {
+			return std::make_shared<DescriptorAllocator>(device, ratios, initialSetsPerPool);
+		}
+
+		DescriptorAllocator(
+			const Device::Ptr& device,
+			const std::vector<DescriptorPoolSizeRatio>& ratios = getDefaultRatios(),
+			uint32_t initialSetsPerPool = DEFAULT_SETS_PER_POOL
+		);
+
+		~DescriptorAllocator();
+
+		VkDescriptorSet allocate(const DescriptorSetLayout::Ptr& layout);
+
+		//layoutsеÿһlayoutһDescriptorSetȫͬһpool
+		std::vector<VkDescriptorSet> allocate(const std::vector<DescriptorSetLayout::Ptr>& layouts);
+
+		//DescriptorSetǰҪ֤ûбGPUʹ
+		void reset();
+
+		//ÿDescriptorSetƽҪĸdescriptor
+		[[nodiscard]] static std::vector<DescriptorPoolSizeRatio> getDefaultRatios();
+
+		[[nodiscard]] uint32_t getPoolCount() const { return static_cast<uint32_t>(_usedPools.size() + _freePools.size()); }
+
+		[[nodiscard]] uint32_t getAllocatedSetCount() const { return _allocatedSetCount; }
+
+	private:
+		//ȡһŵηĿpoolû½һ
+		DescriptorPool::Ptr acquirePool(uint32_t setCount, const std::vector<VkDescriptorPoolSize>& poolSizes);
+
+	private:
+		Device::Ptr _device{ nullptr };
+		std::vector<DescriptorPoolSizeRatio> _ratios{};
+
+		//һ½poolʱmaxSets
+		uint32_t _setsPerPool{ DEFAULT_SETS_PER_POOL };
+
+		//_usedPoolsһǵǰõpool
+		std::vector<DescriptorPool::Ptr> _usedPools{};
+		std::vector<DescriptorPool::Ptr> _freePools{};
+
+		uint32_t _allocatedSetCount{ 0 };
+	};
+}
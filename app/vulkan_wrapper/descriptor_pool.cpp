@@ -1,56 +1,102 @@
 #include "descriptor_pool.h"
+#include <algorithm>
 
 namespace FF::Wrapper {
 
-	DescriptorPool::DescriptorPool(const Device::Ptr& device) {
+	DescriptorPool::DescriptorPool(
+		const Device::Ptr& device,
+		uint32_t maxSets,
+		const std::vector<DescriptorPoolSizeRatio>& ratios,
+		VkDescriptorPoolCreateFlags flags,
+		const std::vector<VkDescriptorPoolSize>& minPoolSizes
+	) {
 		_device = device;
-	}
+		_maxSets = maxSets;
 
-	DescriptorPool::~DescriptorPool() {
-		if (_pool != VK_NULL_HANDLE) {
-			vkDestroyDescriptorPool(_device->getDevice(), _pool, nullptr);
+		//ÿһuniformж٣ߵsizeָжٸdescriptorǶٸDescriptorSet
+		std::vector<VkDescriptorPoolSize> poolSizes{};
+		for (const auto& ratio : ratios) {
+			VkDescriptorPoolSize poolSize{};
+			poolSize.type = ratio.mType;
+			poolSize.descriptorCount = static_cast<uint32_t>(ratio.mRatio * static_cast<float>(maxSets));
+			poolSizes.push_back(poolSize);
 		}
-	}
 
-	void DescriptorPool::build(std::vector<UniformParameter::Ptr>& params, const int frameCount) {
-		
-		
-		int uniformBufferCount = 0;
-		int textureCount = 0;
-		
-		for (const auto& param : params) {
-			if (param->mDescriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
-				++uniformBufferCount;
-			}
+		for (const auto& minPoolSize : minPoolSizes) {
+			auto iter = std::find_if(poolSizes.begin(), poolSizes.end(), [&](const VkDescriptorPoolSize& poolSize) {
+				return poolSize.type == minPoolSize.type;
+			});
 
-			if (param->mDescriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) {
-				++textureCount;
+			if (iter == poolSizes.end()) {
+				poolSizes.push_back(minPoolSize);
+			}
+			else {
+				iter->descriptorCount = std::max(iter->descriptorCount, minPoolSize.descriptorCount);
 			}
 		}
 
-		//ÿһuniformж
-		std::vector<VkDescriptorPoolSize> poolSizes{};
-
-		VkDescriptorPoolSize uniformBufferSize{};
-		uniformBufferSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-		uniformBufferSize.descriptorCount = uniformBufferCount * frameCount;
-		poolSizes.push_back(uniformBufferSize);
+		//descriptorCountΪ0
+		poolSizes.erase(std::remove_if(poolSizes.begin(), poolSizes.end(), [](const VkDescriptorPoolSize& poolSize) {
+			return poolSize.descriptorCount == 0;
+		}), poolSizes.end());
+		_poolSizes = poolSizes;
 
-		VkDescriptorPoolSize textureSize{};
-		textureSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-		textureSize.descriptorCount = textureCount * frameCount;//ߵsizeָжٸdescriptor
-		poolSizes.push_back(textureSize);
+		if (poolSizes.empty()) {
+			throw std::runtime_error("Error: descriptor pool has no descriptor");
+		}
 
 		//pool
 		VkDescriptorPoolCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		createInfo.flags = flags;
 		createInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
 		createInfo.pPoolSizes = poolSizes.data();
-		createInfo.maxSets = static_cast<uint32_t>(frameCount);
+		createInfo.maxSets = maxSets;
 
 		if (vkCreateDescriptorPool(_device->getDevice(), &createInfo, nullptr, &_pool) != VK_SUCCESS) {
 			throw std::runtime_error("Error: failed to create descriptor pool");
 		}
 	}
 
-}
\ No newline at end of file
+	DescriptorPool::~DescriptorPool() {
+		if (_pool != VK_NULL_HANDLE) {
+			vkDestroyDescriptorPool(_device->getDevice(), _pool, nullptr);
+		}
+	}
+
+	VkResult DescriptorPool::allocate(const std::vector<VkDescriptorSetLayout>& layouts, std::vector<VkDescriptorSet>& descriptorSets) {
+		VkDescriptorSetAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorPool = _pool;
+		allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+		allocInfo.pSetLayouts = layouts.data();
+
+		descriptorSets.resize(layouts.size());
+		return vkAllocateDescriptorSets(_device->getDevice(), &allocInfo, descriptorSets.data());
+	}
+
+	void DescriptorPool::reset() {
+		vkResetDescriptorPool(_device->getDevice(), _pool, 0);
+	}
+
+	bool DescriptorPool::canHold(uint32_t setCount, const std::vector<VkDescriptorPoolSize>& poolSizes) const {
+		if (setCount > _maxSets) {
+			return false;
+		}
+
+		for (const auto& required : poolSizes) {
+			uint32_t capacity = 0;
+			for (const auto& poolSize : _poolSizes) {
+				if (poolSize.type == required.type) {
+					capacity += poolSize.descriptorCount;
+				}
+			}
+
+			if (required.descriptorCount > capacity) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+}
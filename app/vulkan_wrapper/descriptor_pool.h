@@ -6,25 +6,55 @@
 
 namespace FF::Wrapper {
 
+	//poolÿһdescriptorΪ  * maxSets
+	struct DescriptorPoolSizeRatio {
+		VkDescriptorType mType{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER };
+		float mRatio{ 1.0f };
+	};
+
 	class DescriptorPool {
 	public:
 		using Ptr = std::shared_ptr<DescriptorPool>;
-		static Ptr create(const Device::Ptr& device) {
-			return std::make_shared<DescriptorPool>(device);
+		static Ptr create(
+			const Device::Ptr& device,
+			uint32_t maxSets,
+			const std::vector<DescriptorPoolSizeRatio>& ratios,
+			VkDescriptorPoolCreateFlags flags = 0,
+			const std::vector<VkDescriptorPoolSize>& minPoolSizes = {}
+		) {
+			return std::make_shared<DescriptorPool>(device, maxSets, ratios, flags, minPoolSizes);
 		}
 
-		DescriptorPool(const Device::Ptr& device);
+		//minPoolSizesиͣΪֵûеҲpool
+		DescriptorPool(
+			const Device::Ptr& device,
+			uint32_t maxSets,
+			const std::vector<DescriptorPoolSizeRatio>& ratios,
+			VkDescriptorPoolCreateFlags flags = 0,
+			const std::vector<VkDescriptorPoolSize>& minPoolSizes = {}
+		);
 
 		~DescriptorPool();
 
-		//frameCount ָж֡л(Ϊеÿһͼ񶼴uniformsֹݳͻ
-		//ǰһ֡ύʱ֡ڻƣuniformbufferڱȡȻcpuһѭ
-		//ݽ޸ģأ)
-		void build(std::vector<UniformParameter::Ptr>& params, const int frameCount);
+		//pool˷VK_ERROR_OUT_OF_POOL_MEMORYVK_ERROR_FRAGMENTED_POOLɵ߻һpool
+		VkResult allocate(const std::vector<VkDescriptorSetLayout>& layouts, std::vector<VkDescriptorSet>& descriptorSets);
+
+		//poolзDescriptorSetһգǰҪ֤ûбGPUʹ
+		void reset();
 
 		[[nodiscard]] VkDescriptorPool getPool() const { return _pool; }
+
+		[[nodiscard]] uint32_t getMaxSets() const { return _maxSets; }
+
+		[[nodiscard]] const std::vector<VkDescriptorPoolSize>& getPoolSizes() const { return _poolSizes; }
+
+		//poolжϣյpoolܷһηsetCountDescriptorSetҪpoolSizesdescriptor
+		[[nodiscard]] bool canHold(uint32_t setCount, const std::vector<VkDescriptorPoolSize>& poolSizes) const;
+
 	private:
 		VkDescriptorPool _pool{ VK_NULL_HANDLE };
 		Device::Ptr _device{ nullptr };
+		uint32_t _maxSets{ 0 };
+		std::vector<VkDescriptorPoolSize> _poolSizes{};
 	};
-}
\ No newline at end of file
+}
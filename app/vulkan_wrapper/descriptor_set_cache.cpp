@@ -0,0 +1,71 @@
+#include "descriptor_set_cache.h"
+#include <cstring>
+
+namespace FF::Wrapper {
+
+	//ģݵֽڶ0ֱӰֽڱȽ
+	bool DescriptorSetCache::Key::operator==(const Key& other) const {
+		return mLayout == other.mLayout &&
+			mData.size() == other.mData.size() &&
+			memcmp(mData.data(), other.mData.data(), sizeof(DescriptorTemplateData) * mData.size()) == 0;
+	}
+
+	size_t DescriptorSetCache::KeyHash::operator()(const Key& key) const {
+		size_t seed = std::hash<VkDescriptorSetLayout>()(key.mLayout);
+
+		auto bytes = reinterpret_cast<const uint8_t*>(key.mData.data());
+		size_t byteCount = sizeof(DescriptorTemplateData) * key.mData.size();
+
+		//DescriptorTemplateDataĴС8ֽڵ
+		for (size_t offset = 0; offset + sizeof(uint64_t) <= byteCount; offset += sizeof(uint64_t)) {
+			uint64_t word = 0;
+			memcpy(&word, bytes + offset, sizeof(uint64_t));
+			seed ^= static_cast<size_t>(word) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+		}
+		return seed;
+	}
+
+	DescriptorSetCache::DescriptorSetCache(const Device::Ptr& device) {
+		_device = device;
+		_allocator = DescriptorAllocator::create(_device);
+	}
+
+	DescriptorSetCache::~DescriptorSetCache() {
+		_descriptorSets.clear();
+	}
+
+	VkDescriptorSet DescriptorSetCache::getDescriptorSet(const DescriptorSetLayout::Ptr& layout, int frameIndex) {
+		return getDescriptorSet(layout, layout->getParams(), frameIndex);
+	}
+
+	VkDescriptorSet DescriptorSetCache::getDescriptorSet(
+		const DescriptorSetLayout::Ptr& layout,
+		const std::vector<UniformParameter::Ptr>& params,
+		int frameIndex
+	) {
+		return getDescriptorSet(layout, DescriptorUpdateTemplate::packData(params, frameIndex));
+	}
+
+	VkDescriptorSet DescriptorSetCache::getDescriptorSet(
+		const DescriptorSetLayout::Ptr& layout, 
+		const std::vector<DescriptorTemplateData>& data
+	) {
+		Key key{ layout->getLayout(), data };
+
+		auto iter = _descriptorSets.find(key);
+		if (iter != _descriptorSets.end()) {
+			return iter->second;
+		}
+
+		auto descriptorSet = _allocator->allocate(layout);
+		layout->getUpdateTemplate()->update(descriptorSet, data);
+
+		_descriptorSets.emplace(std::move(key), descriptorSet);
+		return descriptorSet;
+	}
+
+	void DescriptorSetCache::clear() {
+		_descriptorSets.clear();
+		_allocator->reset();
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+#include "descriptor_set_layout.h"
+#include "descriptor_allocator.h"
+#include "descriptor_update_template.h"
+#include <unordered_map>
+
+namespace FF::Wrapper {
+
+	/*
+	* layoutеbuffer/imageݻDescriptorSet
+	* 1 ͬlayoutͬbuffer(offset/range)image(view/sampler/layout)󷵻ͬһDescriptorSet
+	* 2 µϴӷз䣬layoutupdate templateд룬֮ٸдѾCommandBufferһֱЧ
+	* 3 ݱ仯(绻)һkeyɵDescriptorSetڻУclearʱ
+	*/
+	class DescriptorSetCache {
+	public:
+		using Ptr = std::shared_ptr<DescriptorSetCache>;
+		static Ptr create(const Device::Ptr& device) { return std::make_shared<DescriptorSetCache>(device); }
+
+		DescriptorSetCache(const Device::Ptr& device);
+
+		~DescriptorSetCache();
+
+		//layoutparamsframeIndexһ֡
+		VkDescriptorSet getDescriptorSet(const DescriptorSetLayout::Ptr& layout, int frameIndex);
+
+		VkDescriptorSet getDescriptorSet(
+			const DescriptorSetLayout::Ptr& layout, 
+			const std::vector<UniformParameter::Ptr>& params, 
+			int frameIndex
+		);
+
+		VkDescriptorSet getDescriptorSet(const DescriptorSetLayout::Ptr& layout, const std::vector<DescriptorTemplateData>& data);
+
+		//DescriptorSetǰҪ֤ûбGPUʹ
+		void clear();
+
+		[[nodiscard]] size_t getDescriptorSetCount() const { return _descriptorSets.size(); }
+
+	private:
+		struct Key {
+			VkDescriptorSetLayout mLayout{ VK_NULL_HANDLE };
+			std::vector<DescriptorTemplateData> mData{};
+
+			bool operator==(const Key& other) const;
+		};
+
+		struct KeyHash {
+			size_t operator()(const Key& key) const;
+		};
+
+	private:
+		Device::Ptr _device{ nullptr };
+		//ռclearʱreset
+		DescriptorAllocator::Ptr _allocator{ nullptr };
+		std::unordered_map<Key, VkDescriptorSet, KeyHash> _descriptorSets{};
+	};
+}
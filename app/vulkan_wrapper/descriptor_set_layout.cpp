@@ -1,4 +1,5 @@
 #include "descriptor_set_layout.h"
+#include <algorithm>
 
 namespace FF::Wrapper {
 	DescriptorSetLayout::DescriptorSetLayout(const Device::Ptr& device) {
@@ -6,16 +7,19 @@ namespace FF::Wrapper {
 	}
 
 	DescriptorSetLayout::~DescriptorSetLayout() {
+		_updateTemplate.reset();
 		if (_layout != VK_NULL_HANDLE) {
 			vkDestroyDescriptorSetLayout(_device->getDevice(), _layout, nullptr);
 		}
 	}
 
 	void DescriptorSetLayout::build(const std::vector<UniformParameter::Ptr>& params) {
+		_updateTemplate.reset();
 		if (_layout != VK_NULL_HANDLE) {
 			vkDestroyDescriptorSetLayout(_device->getDevice(), _layout, nullptr);
 		}
 		_params = params;
+		_poolSizes.clear();
 		std::vector<VkDescriptorSetLayoutBinding> layoutBindings{};
 
 		for (const auto& param : _params) {
@@ -25,6 +29,18 @@ namespace FF::Wrapper {
 			layoutBinding.stageFlags = param->mStage;
 			layoutBinding.descriptorCount = param->mCount;
 			layoutBindings.push_back(layoutBinding);
+
+			//ͬһ͵bindingϲ
+			auto iter = std::find_if(_poolSizes.begin(), _poolSizes.end(), [&](const VkDescriptorPoolSize& poolSize) {
+				return poolSize.type == param->mDescriptorType;
+			});
+
+			if (iter == _poolSizes.end()) {
+				_poolSizes.push_back({ param->mDescriptorType, param->mCount });
+			}
+			else {
+				iter->descriptorCount += param->mCount;
+			}
 		}
 
 		VkDescriptorSetLayoutCreateInfo createInfo{};
@@ -32,8 +48,14 @@ namespace FF::Wrapper {
 		createInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
 		createInfo.pBindings = layoutBindings.data();
 
+		StateKeyWriter keyWriter;
+		keyWriter.writeSetLayout(createInfo);
+		_layoutKey = keyWriter.getBytes();
+
 		if (vkCreateDescriptorSetLayout(_device->getDevice(), &createInfo, nullptr, &_layout) != VK_SUCCESS) {
 			throw std::runtime_error("Error: failed to create descriptor set layout");
 		}
+
+		_updateTemplate = DescriptorUpdateTemplate::create(_device, _layout, _params);
 	}
 }
\ No newline at end of file
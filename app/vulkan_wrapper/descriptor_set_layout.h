@@ -3,6 +3,8 @@
 #include "../base.h"
 #include "device.h"
 #include "descriptor.h"
+#include "descriptor_update_template.h"
+#include "pipeline_state_key.h"
 
 namespace FF::Wrapper {
 
@@ -22,9 +24,23 @@ namespace FF::Wrapper {
 
 		[[nodiscard]] auto getLayout() const { return _layout; }
 
+		//buildʱͬһparamsɣдlayoutDescriptorSet
+		[[nodiscard]] DescriptorUpdateTemplate::Ptr getUpdateTemplate() const { return _updateTemplate; }
+
+		[[nodiscard]] const std::vector<UniformParameter::Ptr>& getParams() const { return _params; }
+
+		//layoutһDescriptorSetʱÿһdescriptorҪ
+		[[nodiscard]] const std::vector<VkDescriptorPoolSize>& getPoolSizes() const { return _poolSizes; }
+
+		//layoutϢݣͬlayoutõͬkey
+		[[nodiscard]] const std::vector<uint8_t>& getLayoutKey() const { return _layoutKey; }
+
 	private:
 		VkDescriptorSetLayout _layout{ VK_NULL_HANDLE };
 		Device::Ptr _device{ nullptr };
 		std::vector<UniformParameter::Ptr> _params{};
+		DescriptorUpdateTemplate::Ptr _updateTemplate{ nullptr };
+		std::vector<uint8_t> _layoutKey{};
+		std::vector<VkDescriptorPoolSize> _poolSizes{};
 	};
 }
\ No newline at end of file
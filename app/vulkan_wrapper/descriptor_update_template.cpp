@@ -0,0 +1,92 @@
+#include "descriptor_update_template.h"
+#include <cstring>
+
+namespace FF::Wrapper {
+
+	DescriptorUpdateTemplate::DescriptorUpdateTemplate(
+		const Device::Ptr& device,
+		VkDescriptorSetLayout layout,
+		const std::vector<UniformParameter::Ptr>& params
+	) {
+		_device = device;
+
+		std::vector<VkDescriptorUpdateTemplateEntry> entries{};
+		for (const auto& param : params) {
+			VkDescriptorUpdateTemplateEntry entry{};
+			entry.dstBinding = param->mBinding;
+			entry.dstArrayElement = 0;
+			entry.descriptorCount = param->mCount;
+			entry.descriptorType = param->mDescriptorType;
+			entry.offset = sizeof(DescriptorTemplateData) * _dataCount;
+			entry.stride = sizeof(DescriptorTemplateData);
+			entries.push_back(entry);
+
+			_dataCount += param->mCount;
+		}
+
+		VkDescriptorUpdateTemplateCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+		createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+		createInfo.pDescriptorUpdateEntries = entries.data();
+		createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+		createInfo.descriptorSetLayout = layout;
+
+		if (vkCreateDescriptorUpdateTemplate(_device->getDevice(), &createInfo, nullptr, &_template) != VK_SUCCESS) {
+			throw std::runtime_error("Error: failed to create descriptor update template");
+		}
+	}
+
+	DescriptorUpdateTemplate::~DescriptorUpdateTemplate() {
+		if (_template != VK_NULL_HANDLE) {
+			vkDestroyDescriptorUpdateTemplate(_device->getDevice(), _template, nullptr);
+		}
+	}
+
+	std::vector<DescriptorTemplateData> DescriptorUpdateTemplate::packData(
+		const std::vector<UniformParameter::Ptr>& params, 
+		int frameIndex
+	) {
+		size_t count = 0;
+		for (const auto& param : params) {
+			count += param->mCount;
+		}
+
+		//㣬ֶθֵ֤ṹеֽҲ0
+		std::vector<DescriptorTemplateData> data(count);
+		memset(data.data(), 0, sizeof(DescriptorTemplateData) * count);
+
+		size_t index = 0;
+		for (const auto& param : params) {
+			//еÿһԪʹͬһдVkWriteDescriptorSetʱһ
+			for (uint32_t i = 0; i < param->mCount; ++i, ++index) {
+				auto& item = data[index];
+
+				if (param->mDescriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER ||
+					param->mDescriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) {
+					const auto& bufferInfo = param->mBufferInfos.empty() ?
+						param->mBuffers[frameIndex]->getDescriptorBufferInfo() : param->mBufferInfos[frameIndex];
+					item.mBufferInfo.buffer = bufferInfo.buffer;
+					item.mBufferInfo.offset = bufferInfo.offset;
+					item.mBufferInfo.range = bufferInfo.range;
+				}
+
+				if (param->mDescriptorType == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) {
+					const auto& imageInfo = param->mTexture->getImageInfo();
+					item.mImageInfo.sampler = imageInfo.sampler;
+					item.mImageInfo.imageView = imageInfo.imageView;
+					item.mImageInfo.imageLayout = imageInfo.imageLayout;
+				}
+			}
+		}
+
+		return data;
+	}
+
+	void DescriptorUpdateTemplate::update(VkDescriptorSet descriptorSet, const std::vector<DescriptorTemplateData>& data) {
+		if (data.size() != _dataCount) {
+			throw std::runtime_error("Error: descriptor template data does not match the template");
+		}
+
+		vkUpdateDescriptorSetWithTemplate(_device->getDevice(), descriptorSet, _template, data.data());
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+#include "descriptor.h"
+
+namespace FF::Wrapper {
+
+	//ģеһbufferimageͬһλ
+	union DescriptorTemplateData {
+		VkDescriptorBufferInfo mBufferInfo;
+		VkDescriptorImageInfo mImageInfo;
+	};
+
+	/*
+	* UniformParameterбɵVkDescriptorUpdateTemplate
+	* 1 ÿһdescriptorģռһDescriptorTemplateDataparams˳
+	* 2 дһDescriptorSetֻҪһvkUpdateDescriptorSetWithTemplateдVkWriteDescriptorSet
+	* 3 update template1.1ʼǺĹ
+	*/
+	class DescriptorUpdateTemplate {
+	public:
+		using Ptr = std::shared_ptr<DescriptorUpdateTemplate>;
+		static Ptr create(
+			const Device::Ptr& device,
+			VkDescriptorSetLayout layout,
+			const std::vector<UniformParameter::Ptr>& params
+		) {
+			return std::make_shared<DescriptorUpdateTemplate>(device, layout, params);
+		}
+
+		DescriptorUpdateTemplate(
+			const Device::Ptr& device,
+			VkDescriptorSetLayout layout,
+			const std::vector<UniformParameter::Ptr>& params
+		);
+
+		~DescriptorUpdateTemplate();
+
+		//paramsframeIndexһ֡buffer/imageΪģݣûõֽΪ0ֱӰֽڱȽ
+		[[nodiscard]] static std::vector<DescriptorTemplateData> packData(
+			const std::vector<UniformParameter::Ptr>& params, 
+			int frameIndex
+		);
+
+		void update(VkDescriptorSet descriptorSet, const std::vector<DescriptorTemplateData>& data);
+
+		[[nodiscard]] VkDescriptorUpdateTemplate getTemplate() const { return _template; }
+
+	private:
+		VkDescriptorUpdateTemplate _template{ VK_NULL_HANDLE };
+		Device::Ptr _device{ nullptr };
+
+		//ģӦе
+		size_t _dataCount{ 0 };
+	};
+}
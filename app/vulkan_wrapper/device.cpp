@@ -1,4 +1,5 @@
 #include "device.h"
+#include <algorithm>
 
 namespace FF::Wrapper {
 	Device::Device(Instance::Ptr instance, WindowSurface::Ptr surface) {
@@ -6,10 +7,14 @@ namespace FF::Wrapper {
 		_surface = surface;
 		pickPhysicalDevice();
 		initQueueFamilies(_physicalDevice);
+		queryBindlessSupport(_physicalDevice);
+		queryTimelineSemaphoreSupport(_physicalDevice);
 		createLogicalDevice();
+		_allocator = MemoryAllocator::create(_physicalDevice, _device);
 	}
 
 	Device::~Device() {
+		_allocator.reset();
 		vkDestroyDevice(_device, nullptr);
 	}
 
@@ -29,10 +34,11 @@ namespace FF::Wrapper {
 			int score = rateDevice(device);
 			candidates.insert(std::make_pair(score, device));
 		}
-		while (!candidates.empty() && _physicalDevice == VK_NULL_HANDLE) {
-			if (candidates.rbegin()->first > 0 && isDeviceSuitable(candidates.rbegin()->second)) {
-				_physicalDevice = candidates.rbegin()->second;
-				candidates.erase(candidates.rbegin()->first);
+		//ߵĿʼҪ
+		for (auto iter = candidates.rbegin(); iter != candidates.rend(); ++iter) {
+			if (iter->first > 0 && isDeviceSuitable(iter->second)) {
+				_physicalDevice = iter->second;
+				break;
 			}
 		}
 
@@ -74,8 +80,43 @@ namespace FF::Wrapper {
 		VkPhysicalDeviceFeatures deviceFeatures;
 		vkGetPhysicalDeviceFeatures(device, &deviceFeatures);
 
-		return deviceProp.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU &&
-			deviceFeatures.geometryShader && deviceFeatures.samplerAnisotropy;
+		if (!deviceFeatures.geometryShader || !deviceFeatures.samplerAnisotropy) {
+			return false;
+		}
+
+		for (const char* extension : getRequiredExtensions()) {
+			if (!isExtensionSupported(device, extension)) {
+				return false;
+			}
+		}
+
+		//֡ϴͬȫtimeline semaphoreֵ֧豸ʹ
+		queryTimelineSemaphoreSupport(device);
+		if (!_timelineSemaphoreSupported) {
+			return false;
+		}
+
+		//ҪȾУдʱҪܹʾsurfaceĶ
+		uint32_t qFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(device, &qFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> qFamilies(qFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(device, &qFamilyCount, qFamilies.data());
+
+		bool hasGraphic = false;
+		bool hasPresent = isHeadless();
+		for (uint32_t i = 0; i < qFamilyCount; ++i) {
+			if (qFamilies[i].queueCount > 0 && (qFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
+				hasGraphic = true;
+			}
+
+			if (!isHeadless()) {
+				VkBool32 presentSupport = VK_FALSE;
+				vkGetPhysicalDeviceSurfaceSupportKHR(device, i, _surface->getSurface(), &presentSupport);
+				hasPresent = hasPresent || presentSupport;
+			}
+		}
+
+		return hasGraphic && hasPresent;
 	}
 
 	void Device::initQueueFamilies(VkPhysicalDevice device) {
@@ -87,34 +128,63 @@ namespace FF::Wrapper {
 
 		vkGetPhysicalDeviceQueueFamilyProperties(device, &qFamilyCount, qFamilies.data());
 
-		int i = 0;
+		std::optional<uint32_t> dedicatedTransferFamily;
+		std::optional<uint32_t> dedicatedComputeFamily;
+
+		//Ҫȫ壬ҵרõĴ/
+		uint32_t i = 0;
 		for (const auto& queueFamily : qFamilies) {
 
-			//Ѱ֧ȾĶ
-			if (queueFamily.queueCount > 0 && (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
-				_graphicQueueFamily = i;
+			if (!isQueueFamilyComplete()) {
+				//Ѱ֧ȾĶ
+				if (queueFamily.queueCount > 0 && (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
+					_graphicQueueFamily = i;
+				}
+
+				//Ѱ֧ʾĶ壬޴ģʽû
+				if (!isHeadless()) {
+					VkBool32 presentSupport = VK_FALSE;
+					vkGetPhysicalDeviceSurfaceSupportKHR(device, i, _surface->getSurface(), &presentSupport);
+					if (presentSupport) {
+						_presentQueueFamily = i;
+					}
+				}
 			}
 
-			//Ѱ֧ʾĶ
-			VkBool32 presentSupport = VK_FALSE;
-			vkGetPhysicalDeviceSurfaceSupportKHR(device, i, _surface->getSurface(), &presentSupport);
-			if (presentSupport) {
-				_presentQueueFamily = i;
+			bool hasGraphic = (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+			bool hasCompute = (queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT) != 0;
+			bool hasTransfer = (queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT) != 0;
+
+			//ִֻ֧Ķ壬һӦԿϵDMA
+			if (queueFamily.queueCount > 0 && hasTransfer && !hasGraphic && !hasCompute && !dedicatedTransferFamily.has_value()) {
+				dedicatedTransferFamily = i;
 			}
 
-			if (isQueueFamilyComplete()) {
-				break;
+			//ּ֧㵫ǲ֧ȾĶ壬Ⱦ
+			if (queueFamily.queueCount > 0 && hasCompute && !hasGraphic && !dedicatedComputeFamily.has_value()) {
+				dedicatedComputeFamily = i;
 			}
 
 			++i;
 		}
+
+		//ûרöʱ˻صȾ壬ִͬд
+		_computeQueueFamily = dedicatedComputeFamily.has_value() ? dedicatedComputeFamily : _graphicQueueFamily;
+		_transferQueueFamily = dedicatedTransferFamily.has_value() ? dedicatedTransferFamily : _computeQueueFamily;
 	}
 
 	void Device::createLogicalDevice() {
 
 		std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
 
-		std::set<uint32_t> queueFamilies = { _graphicQueueFamily.value(),_presentQueueFamily.value() };
+		std::set<uint32_t> queueFamilies = { 
+			_graphicQueueFamily.value(),
+			_transferQueueFamily.value(),
+			_computeQueueFamily.value()
+		};
+		if (_presentQueueFamily.has_value()) {
+			queueFamilies.insert(_presentQueueFamily.value());
+		}
 
 		float queuePriority = 1.0;
 
@@ -128,17 +198,64 @@ namespace FF::Wrapper {
 			queueCreateInfos.push_back(queueCreateInfo);
 		}
 
-		//д߼豸Ϣ
-		VkPhysicalDeviceFeatures deviceFeatures = {};
-		deviceFeatures.samplerAnisotropy = VK_TRUE;//򿪸
+		//д߼豸Ϣ1.1֮ʱͨVkPhysicalDeviceFeatures2pNextϣʱpEnabledFeaturesҪΪ
+		VkPhysicalDeviceFeatures2 deviceFeatures = {};
+		deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		deviceFeatures.features.samplerAnisotropy = VK_TRUE;//򿪸
+
+		VkPhysicalDeviceDescriptorIndexingFeatures indexingFeatures = {};
+		indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+
+		VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures = {};
+		timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+
+		std::vector<const char*> extensions = getRequiredExtensions();
+
+		//ֵ֧ιҵ
+		void* featureChain = nullptr;
+
+		if (_bindlessSupported) {
+			indexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			indexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+			indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+			indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+			indexingFeatures.pNext = featureChain;
+			featureChain = &indexingFeatures;
+
+			if (_needDescriptorIndexingExtension) {
+				extensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+			}
+		}
+
+		if (_timelineSemaphoreSupported) {
+			timelineFeatures.timelineSemaphore = VK_TRUE;
+			timelineFeatures.pNext = featureChain;
+			featureChain = &timelineFeatures;
+
+			if (_needTimelineSemaphoreExtension) {
+				extensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+			}
+		}
+
+		deviceFeatures.pNext = featureChain;
 
 		VkDeviceCreateInfo deviceCreateInfo = {};
 		deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 		deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
 		deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
-		deviceCreateInfo.pEnabledFeatures = &deviceFeatures;
-		deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(deviceRequredExtensions.size());
-		deviceCreateInfo.ppEnabledExtensionNames = deviceRequredExtensions.data();
+
+		//ϵĽṹֻ֧ʱŻϣûʱʹ1.0pEnabledFeatures
+		if (featureChain != nullptr) {
+			deviceCreateInfo.pNext = &deviceFeatures;
+			deviceCreateInfo.pEnabledFeatures = nullptr;
+		}
+		else {
+			deviceCreateInfo.pNext = nullptr;
+			deviceCreateInfo.pEnabledFeatures = &deviceFeatures.features;
+		}
+		deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+		deviceCreateInfo.ppEnabledExtensionNames = extensions.data();
 
 		//layer
 		if (_instance->getEnableValidationLayer()) {
@@ -153,11 +270,125 @@ namespace FF::Wrapper {
 		}
 
 		vkGetDeviceQueue(_device, _graphicQueueFamily.value(), 0, &_graphicQueue);
-		vkGetDeviceQueue(_device, _presentQueueFamily.value(), 0, &_presentQueue);
+		if (_presentQueueFamily.has_value()) {
+			vkGetDeviceQueue(_device, _presentQueueFamily.value(), 0, &_presentQueue);
+		}
+		vkGetDeviceQueue(_device, _transferQueueFamily.value(), 0, &_transferQueue);
+		vkGetDeviceQueue(_device, _computeQueueFamily.value(), 0, &_computeQueue);
 	}
 
 	bool Device::isQueueFamilyComplete() {
-		return _graphicQueueFamily.has_value() && _presentQueueFamily.has_value();
+		return _graphicQueueFamily.has_value() && (isHeadless() || _presentQueueFamily.has_value());
+	}
+
+	void Device::queryBindlessSupport(VkPhysicalDevice device) {
+		_bindlessSupported = false;
+		_maxBindlessTextureCount = 0;
+
+		//vkGetPhysicalDeviceFeatures21.1ʼǺĺ
+		uint32_t apiVersion = getUsableApiVersion(device);
+		uint32_t minor = VK_API_VERSION_MINOR(apiVersion);
+		uint32_t major = VK_API_VERSION_MAJOR(apiVersion);
+		if (major == 1 && minor < 1) {
+			return;
+		}
+
+		_needDescriptorIndexingExtension = (major == 1 && minor < 2);
+		if (_needDescriptorIndexingExtension && !isExtensionSupported(device, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+			return;
+		}
+
+		VkPhysicalDeviceDescriptorIndexingFeatures indexingFeatures{};
+		indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+
+		VkPhysicalDeviceFeatures2 features{};
+		features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		features.pNext = &indexingFeatures;
+		vkGetPhysicalDeviceFeatures2(device, &features);
+
+		if (!indexingFeatures.shaderSampledImageArrayNonUniformIndexing ||
+			!indexingFeatures.descriptorBindingSampledImageUpdateAfterBind ||
+			!indexingFeatures.descriptorBindingUpdateUnusedWhilePending ||
+			!indexingFeatures.descriptorBindingPartiallyBound ||
+			!indexingFeatures.runtimeDescriptorArray) {
+			return;
+		}
+
+		VkPhysicalDeviceDescriptorIndexingProperties indexingProps{};
+		indexingProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+
+		VkPhysicalDeviceProperties2 props{};
+		props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		props.pNext = &indexingProps;
+		vkGetPhysicalDeviceProperties2(device, &props);
+
+		//COMBINED_IMAGE_SAMPLERͬʱsampled imagesampler
+		_maxBindlessTextureCount = std::min({
+			indexingProps.maxDescriptorSetUpdateAfterBindSampledImages,
+			indexingProps.maxPerStageDescriptorUpdateAfterBindSampledImages,
+			indexingProps.maxDescriptorSetUpdateAfterBindSamplers,
+			indexingProps.maxPerStageDescriptorUpdateAfterBindSamplers
+		});
+		_bindlessSupported = _maxBindlessTextureCount > 0;
+	}
+
+	uint32_t Device::getUsableApiVersion(VkPhysicalDevice device) {
+		//豸ֵ֧ĺĹܻʵʱapiVersion
+		VkPhysicalDeviceProperties deviceProp;
+		vkGetPhysicalDeviceProperties(device, &deviceProp);
+		return std::min(deviceProp.apiVersion, _instance->getApiVersion());
+	}
+
+	void Device::queryTimelineSemaphoreSupport(VkPhysicalDevice device) {
+		_timelineSemaphoreSupported = false;
+
+		uint32_t apiVersion = getUsableApiVersion(device);
+		uint32_t minor = VK_API_VERSION_MINOR(apiVersion);
+		uint32_t major = VK_API_VERSION_MAJOR(apiVersion);
+		if (major == 1 && minor < 1) {
+			return;
+		}
+
+		_needTimelineSemaphoreExtension = (major == 1 && minor < 2);
+		if (_needTimelineSemaphoreExtension && !isExtensionSupported(device, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)) {
+			return;
+		}
+
+		VkPhysicalDeviceTimelineSemaphoreFeatures timelineFeatures{};
+		timelineFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+
+		VkPhysicalDeviceFeatures2 features{};
+		features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		features.pNext = &timelineFeatures;
+		vkGetPhysicalDeviceFeatures2(device, &features);
+
+		_timelineSemaphoreSupported = timelineFeatures.timelineSemaphore == VK_TRUE;
+	}
+
+	bool Device::isExtensionSupported(VkPhysicalDevice device, const char* extensionName) {
+		uint32_t extensionCount = 0;
+		vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+
+		std::vector<VkExtensionProperties> extensions(extensionCount);
+		vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, extensions.data());
+
+		for (const auto& extension : extensions) {
+			if (std::strcmp(extension.extensionName, extensionName) == 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	std::vector<const char*> Device::getRequiredExtensions() const {
+		std::vector<const char*> extensions{};
+		for (const char* extension : deviceRequredExtensions) {
+			if (isHeadless() && std::strcmp(extension, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0) {
+				continue;
+			}
+			extensions.push_back(extension);
+		}
+		return extensions;
 	}
 
 	VkSampleCountFlagBits Device::getMaxUsableSampleCount() {
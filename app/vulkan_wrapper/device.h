@@ -3,6 +3,7 @@
 #include "../base.h"
 #include "instance.h"
 #include "window_surface.h"
+#include "memory_allocator.h"
 
 namespace FF::Wrapper {
 	const std::vector<const char*> deviceRequredExtensions = {
@@ -10,10 +11,16 @@ namespace FF::Wrapper {
 		VK_KHR_MAINTENANCE1_EXTENSION_NAME
 	};
 
+	/*
+	* ߼豸
+	* 1 surfaceΪʱ޴ģʽҪʾ뽻չʾΪVK_NULL_HANDLE
+	* 2 ִӸߵѡһҪ豸ȣǼʵ(lavapipe)ͬʹ
+	*/
+
 	class Device {
 	public:
 		using Ptr = std::shared_ptr<Device>;
-		static Ptr create(Instance::Ptr instance, WindowSurface::Ptr surface) { 
+		static Ptr create(Instance::Ptr instance, WindowSurface::Ptr surface = nullptr) { 
 			return std::make_shared<Device>(instance, surface);
 		}
 
@@ -35,12 +42,49 @@ namespace FF::Wrapper {
 
 		VkSampleCountFlagBits getMaxUsableSampleCount();
 
+		/*
+		* bindlessdescriptor indexing
+		* 1 豸汾Ϊ1.2ʱǺԣ1.1豸ҪVK_EXT_descriptor_indexingչ
+		* 2 ҪһͼƬ顢partially boundupdate after bindʱС
+		*/
+		void queryBindlessSupport(VkPhysicalDevice device);
+
+		//timeline semaphore豸汾Ϊ1.2ʱǺԣ1.1豸ҪVK_KHR_timeline_semaphoreչ
+		//ѡ豸ʱҪֵ֧֣֧豸ᱻѡ
+		void queryTimelineSemaphoreSupport(VkPhysicalDevice device);
+
+		//豸ʵapiVersionнСһֻвĺĹܿʹ
+		uint32_t getUsableApiVersion(VkPhysicalDevice device);
+
+		[[nodiscard]] bool isExtensionSupported(VkPhysicalDevice device, const char* extensionName);
+
+		//Ҫչ޴ģʽ²չ
+		[[nodiscard]] std::vector<const char*> getRequiredExtensions() const;
+
+		[[nodiscard]] bool isHeadless() const { return _surface == nullptr; }
+
 		[[nodiscard]] VkDevice getDevice() const { return _device; }
 		[[nodiscard]] VkPhysicalDevice getPhysicalDevice() const { return _physicalDevice; }
 		[[nodiscard]] std::optional<uint32_t> getGraphicQueueFamily() const { return _graphicQueueFamily; }
 		[[nodiscard]] std::optional<uint32_t> getPresentQueueFamily() const { return _presentQueueFamily; }
 		[[nodiscard]] VkQueue getGraphicQueue() const { return _graphicQueue; }
 		[[nodiscard]] VkQueue getPresentQueue() const { return _presentQueue; }
+		[[nodiscard]] std::optional<uint32_t> getTransferQueueFamily() const { return _transferQueueFamily; }
+		[[nodiscard]] std::optional<uint32_t> getComputeQueueFamily() const { return _computeQueueFamily; }
+		[[nodiscard]] VkQueue getTransferQueue() const { return _transferQueue; }
+		[[nodiscard]] VkQueue getComputeQueue() const { return _computeQueue; }
+
+		//ȾвͬһʱԴҪ֮תȨ
+		[[nodiscard]] bool hasDedicatedTransferQueue() const { return _transferQueueFamily != _graphicQueueFamily; }
+		[[nodiscard]] bool hasAsyncComputeQueue() const { return _computeQueueFamily != _graphicQueueFamily; }
+		[[nodiscard]] MemoryAllocator::Ptr getAllocator() const { return _allocator; }
+
+		[[nodiscard]] bool isBindlessSupported() const { return _bindlessSupported; }
+
+		//һupdate after bindDescriptorSetܷµͼƬ
+		[[nodiscard]] uint32_t getMaxBindlessTextureCount() const { return _maxBindlessTextureCount; }
+
+		[[nodiscard]] bool isTimelineSemaphoreSupported() const { return _timelineSemaphoreSupported; }
 	private:
 		VkPhysicalDevice _physicalDevice{ VK_NULL_HANDLE };
 		Instance::Ptr _instance{ nullptr };
@@ -53,7 +97,26 @@ namespace FF::Wrapper {
 		std::optional<uint32_t> _presentQueueFamily;
 		VkQueue _presentQueue{ VK_NULL_HANDLE };
 
+		//רõĴ/壬ûеʱȾͬ
+		std::optional<uint32_t> _transferQueueFamily;
+		VkQueue _transferQueue{ VK_NULL_HANDLE };
+
+		std::optional<uint32_t> _computeQueueFamily;
+		VkQueue _computeQueue{ VK_NULL_HANDLE };
+
 		//߼豸
 		VkDevice _device{ VK_NULL_HANDLE };
+
+		bool _bindlessSupported{ false };
+		uint32_t _maxBindlessTextureCount{ 0 };
+
+		//豸汾1.2ʱdescriptor indexingҪչķʽ
+		bool _needDescriptorIndexingExtension{ false };
+
+		bool _timelineSemaphoreSupported{ false };
+		bool _needTimelineSemaphoreExtension{ false };
+
+		//Buffer/ImageԴ涼ӷ
+		MemoryAllocator::Ptr _allocator{ nullptr };
 	};
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "fence.h"
+#include "../profiler.h"
 
 namespace FF::Wrapper {
 	Fence::Fence(const Device::Ptr& device, bool signaled) {
@@ -24,6 +25,11 @@ namespace FF::Wrapper {
 	}
 
 	void Fence::block(uint64_t timeout) {
+		FF_PROFILE_ZONE("Fence::block");
 		vkWaitForFences(_device->getDevice(), 1, &_fence, VK_TRUE, timeout);
 	}
+
+	bool Fence::isSignaled() const {
+		return vkGetFenceStatus(_device->getDevice(), _fence) == VK_SUCCESS;
+	}
 }
\ No newline at end of file
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "../base.h"
 #include "device.h"
 
@@ -28,6 +30,9 @@ namespace FF::Wrapper {
 		//ô˺fenceûбôȴ
 		void block(uint64_t timeout = UINT64_MAX);
 
+		//ѯfenceǷѾ
+		[[nodiscard]] bool isSignaled() const;
+
 		[[nodiscard]] VkFence getFence() const { return _fence; }
 		
 	private:
@@ -0,0 +1,31 @@
+#include "frame_context.h"
+
+namespace FF::Wrapper {
+
+	FrameContext::FrameContext(const Device::Ptr& device, const SubmitScheduler::Ptr& scheduler, uint32_t index, uint32_t workerCount) {
+		_device = device;
+		_scheduler = scheduler;
+		_index = index;
+
+		//ÿ֡ãCommandBufferҪreset
+		_commandPool = CommandPool::create(_device, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+		_commandBuffer = CommandBuffer::create(_device, _commandPool);
+
+		_workerCommandPools.resize(workerCount);
+		_secondaryCommandBuffers.resize(workerCount);
+		for (uint32_t i = 0; i < workerCount; ++i) {
+			_workerCommandPools[i] = CommandPool::create(_device, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+			_secondaryCommandBuffers[i] = CommandBuffer::create(_device, _workerCommandPools[i], true);
+		}
+
+		_imageAvailableSemaphore = Semaphore::create(_device);
+	}
+
+	void FrameContext::begin() {
+		_scheduler->wait(_submitValue);
+		_commandPool->reset();
+		for (auto& pool : _workerCommandPools) {
+			pool->reset();
+		}
+	}
+}
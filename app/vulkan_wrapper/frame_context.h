@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+#include "command_pool.h"
+#include "command_buffer.h"
+#include "semaphore.h"
+#include "submit_scheduler.h"
+
+namespace FF::Wrapper {
+
+	/*
+	* һ֡CPU¼ơGPUִҪȫԴͬʱִе֡(frames in flight)뽻ͼƬ޹
+	* 1 ÿһ֡ԼCommandPoolCommandBufferһύִϺãÿ֡¼
+	* 2 imageAvailable semaphoreְ֣֡ͼƬȴrenderFinishedͼƬ֣SwapChainУ
+	*   Ƿִɵtimelineϵύֵж
+	* 3 indexΪ֡ţuniformλÿ֡descriptorSetȰ
+	* 4 ֡ԽCPUGPUصԽ֣뵽ӳҲԽ
+	* 5 workerCount¼ƲλÿλԼCommandPoolCommandBuffer
+	*   CommandPoolҪⲿͬͬһʱһλֻһ߳¼
+	*/
+	class FrameContext {
+	public:
+		using Ptr = std::shared_ptr<FrameContext>;
+
+		static Ptr create(
+			const Device::Ptr& device, 
+			const SubmitScheduler::Ptr& scheduler, 
+			uint32_t index, 
+			uint32_t workerCount = 0
+		) {
+			return std::make_shared<FrameContext>(device, scheduler, index, workerCount);
+		}
+
+		FrameContext(const Device::Ptr& device, const SubmitScheduler::Ptr& scheduler, uint32_t index, uint32_t workerCount = 0);
+
+		~FrameContext() = default;
+
+		//ȴһ֡һεύִϣCommandPool֮¼
+		void begin();
+
+		[[nodiscard]] uint32_t getIndex() const { return _index; }
+
+		[[nodiscard]] CommandPool::Ptr getCommandPool() const { return _commandPool; }
+
+		[[nodiscard]] CommandBuffer::Ptr getCommandBuffer() const { return _commandBuffer; }
+
+		[[nodiscard]] uint32_t getWorkerCount() const { return static_cast<uint32_t>(_secondaryCommandBuffers.size()); }
+
+		//workerIndex¼ƲλĶCommandBuffer
+		[[nodiscard]] CommandBuffer::Ptr getSecondaryCommandBuffer(uint32_t workerIndex) const { 
+			return _secondaryCommandBuffers.at(workerIndex); 
+		}
+
+		//ύһ֮֡¼ύֵһbeginȴֵ
+		void setSubmitValue(uint64_t value) { _submitValue = value; }
+
+		[[nodiscard]] uint64_t getSubmitValue() const { return _submitValue; }
+
+		[[nodiscard]] Semaphore::Ptr getImageAvailableSemaphore() const { return _imageAvailableSemaphore; }
+
+	private:
+		uint32_t _index{ 0 };
+
+		CommandPool::Ptr _commandPool{ nullptr };
+		CommandBuffer::Ptr _commandBuffer{ nullptr };
+
+		std::vector<CommandPool::Ptr> _workerCommandPools{};
+		std::vector<CommandBuffer::Ptr> _secondaryCommandBuffers{};
+
+		SubmitScheduler::Ptr _scheduler{ nullptr };
+		uint64_t _submitValue{ 0 };
+
+		Semaphore::Ptr _imageAvailableSemaphore{ nullptr };
+
+		Device::Ptr _device{ nullptr };
+	};
+}
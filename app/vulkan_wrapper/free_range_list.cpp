@@ -0,0 +1,84 @@
+#include "free_range_list.h"
+#include <algorithm>
+#include <iterator>
+
+namespace FF::Wrapper {
+
+	static uint64_t alignUp(uint64_t value, uint64_t alignment) {
+		return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+	}
+
+	bool FreeRangeList::allocate(uint64_t size, uint64_t alignment, uint64_t& offset, uint64_t& padding) {
+		//best-fit: ѡ֮ʣСĿ
+		auto best = _ranges.end();
+		uint64_t bestLeft = UINT64_MAX;
+		for (auto it = _ranges.begin(); it != _ranges.end(); ++it) {
+			uint64_t rangePadding = alignUp(it->first, alignment) - it->first;
+			if (rangePadding + size > it->second) {
+				continue;
+			}
+
+			uint64_t left = it->second - rangePadding - size;
+			if (left < bestLeft) {
+				best = it;
+				bestLeft = left;
+				if (left == 0) {
+					break;
+				}
+			}
+		}
+
+		if (best == _ranges.end()) {
+			return false;
+		}
+
+		uint64_t rangeOffset = best->first;
+		padding = alignUp(rangeOffset, alignment) - rangeOffset;
+		offset = rangeOffset + padding;
+
+		_ranges.erase(best);
+		if (bestLeft > 0) {
+			_ranges[offset + size] = bestLeft;
+		}
+		return true;
+	}
+
+	void FreeRangeList::free(uint64_t offset, uint64_t size, uint64_t padding) {
+		offset -= padding;
+		size += padding;
+
+		//һϲ
+		auto next = _ranges.lower_bound(offset);
+		if (next != _ranges.end() && offset + size == next->first) {
+			size += next->second;
+			next = _ranges.erase(next);
+		}
+
+		//ǰһϲ
+		if (next != _ranges.begin()) {
+			auto prev = std::prev(next);
+			if (prev->first + prev->second == offset) {
+				prev->second += size;
+				return;
+			}
+		}
+
+		_ranges[offset] = size;
+	}
+
+	uint64_t FreeRangeList::getFreeBytes() const {
+		uint64_t freeBytes = 0;
+		for (const auto& range : _ranges) {
+			freeBytes += range.second;
+		}
+		return freeBytes;
+	}
+
+	uint64_t FreeRangeList::getLargestRange() const {
+		uint64_t largest = 0;
+		for (const auto& range : _ranges) {
+			largest = std::max(largest, range.second);
+		}
+		return largest;
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+
+namespace FF::Wrapper {
+
+	/*
+	* MemoryBlockڲĹ漰κvulkan
+	* 1 䰴offset򣬷ʱbest-fitѡ֮ʣС䣬պ÷ʱֹͣ
+	* 2 Ϊ˶ֽ(padding)ηһ֣ͷʱһ黹
+	* 3 ͷʱǰڵĿϲȫͷָ֮Ϊһ
+	*/
+	class FreeRangeList {
+	public:
+		FreeRangeList() = default;
+
+		explicit FreeRangeList(uint64_t size) {
+			if (size > 0) {
+				_ranges[0] = size;
+			}
+		}
+
+		//offsetΪ֮㣬paddingΪǰֽڣŲʱfalse״̬
+		bool allocate(uint64_t size, uint64_t alignment, uint64_t& offset, uint64_t& padding);
+
+		//offsetsizepaddingallocateʱͬ
+		void free(uint64_t offset, uint64_t size, uint64_t padding);
+
+		[[nodiscard]] uint64_t getFreeBytes() const;
+
+		[[nodiscard]] uint64_t getLargestRange() const;
+
+		//offset -> size
+		[[nodiscard]] const std::map<uint64_t, uint64_t>& getRanges() const { return _ranges; }
+
+	private:
+		std::map<uint64_t, uint64_t> _ranges{};
+	};
+}
@@ -0,0 +1,291 @@
+#include "gpu_profiler.h"
+#include "command_pool.h"
+#include "../profiler.h"
+
+namespace FF::Wrapper {
+
+	GpuProfiler::Scope::Scope(const GpuProfiler::Ptr& profiler, const CommandBuffer::Ptr& commandBuffer, uint32_t nameId) {
+		_profiler = profiler;
+		_commandBuffer = commandBuffer;
+		if (_profiler) {
+			_region = _profiler->beginRegion(_commandBuffer, nameId);
+		}
+	}
+
+	GpuProfiler::Scope::~Scope() {
+		if (_profiler) {
+			_profiler->endRegion(_commandBuffer, _region);
+		}
+	}
+
+	GpuProfiler::GpuProfiler(const Device::Ptr& device, uint32_t frameCount, uint32_t maxRegions, uint32_t historySize) {
+		_device = device;
+		_maxRegions = maxRegions;
+		_historySize = std::max(historySize, 1u);
+
+		VkPhysicalDeviceProperties props;
+		vkGetPhysicalDeviceProperties(_device->getPhysicalDevice(), &props);
+		_timestampPeriod = static_cast<double>(props.limits.timestampPeriod);
+
+		//ȾtimestampValidBitsΪ0ʱ֧ʱ
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(_device->getPhysicalDevice(), &queueFamilyCount, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(_device->getPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+		uint32_t validBits = queueFamilies[_device->getGraphicQueueFamily().value()].timestampValidBits;
+		_supported = validBits > 0 && props.limits.timestampPeriod > 0.0f;
+		_timestampMask = validBits >= 64 ? UINT64_MAX : ((1ull << validBits) - 1);
+
+		_frames.resize(frameCount);
+		if (_supported) {
+			for (auto& frame : _frames) {
+				frame.mQueryPool = QueryPool::create(_device, VK_QUERY_TYPE_TIMESTAMP, _maxRegions * 2);
+				frame.mRegions.reserve(_maxRegions);
+			}
+		}
+	}
+
+	void GpuProfiler::beginFrame(const CommandBuffer::Ptr& commandBuffer, uint32_t frameIndex, uint64_t frameNumber, uint32_t regionCount) {
+		if (!_supported) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_currentFrame = frameIndex;
+
+		auto& frame = _frames.at(frameIndex);
+		if (frame.mPending) {
+			collect(frame);
+		}
+
+		//һεĽѾأһ֡ĲѯزٱGPUʹãֱ滻
+		if (regionCount * 2 > frame.mQueryPool->getQueryCount()) {
+			frame.mQueryPool = QueryPool::create(_device, VK_QUERY_TYPE_TIMESTAMP, regionCount * 2);
+			frame.mRegions.reserve(regionCount);
+		}
+
+		frame.mRegions.clear();
+		frame.mQueryCount = 0;
+		frame.mFrameNumber = frameNumber;
+		frame.mPending = true;
+		commandBuffer->resetQueryPool(frame.mQueryPool->getQueryPool(), 0, frame.mQueryPool->getQueryCount());
+	}
+
+	uint32_t GpuProfiler::getRegionId(const std::string& name) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto iter = _regionIds.find(name);
+		if (iter != _regionIds.end()) {
+			return iter->second;
+		}
+
+		auto id = static_cast<uint32_t>(_regionNames.size());
+		_regionIds[name] = id;
+		_regionNames.push_back(name);
+		_history.emplace_back();
+		return id;
+	}
+
+	uint32_t GpuProfiler::beginRegion(const CommandBuffer::Ptr& commandBuffer, uint32_t nameId, VkPipelineStageFlagBits stage) {
+		if (!_supported) {
+			return INVALID_REGION;
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto& frame = _frames[_currentFrame];
+		if (!hasRoom(frame, 1)) {
+			return INVALID_REGION;
+		}
+
+		Region region{};
+		region.mNameId = nameId;
+		region.mBeginQuery = frame.mQueryCount++;
+		region.mEndQuery = frame.mQueryCount++;
+		frame.mRegions.push_back(region);
+
+		commandBuffer->writeTimestamp(stage, frame.mQueryPool->getQueryPool(), region.mBeginQuery);
+		return static_cast<uint32_t>(frame.mRegions.size() - 1);
+	}
+
+	void GpuProfiler::endRegion(const CommandBuffer::Ptr& commandBuffer, uint32_t region, VkPipelineStageFlagBits stage) {
+		if (!_supported || region == INVALID_REGION) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto& frame = _frames[_currentFrame];
+		commandBuffer->writeTimestamp(stage, frame.mQueryPool->getQueryPool(), frame.mRegions.at(region).mEndQuery);
+	}
+
+	uint32_t GpuProfiler::reserveRegions(uint32_t count) {
+		if (!_supported || count == 0) {
+			return INVALID_REGION;
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto& frame = _frames[_currentFrame];
+		if (!hasRoom(frame, count)) {
+			return INVALID_REGION;
+		}
+
+		//mRegionsСڲѯܷµregion¼ڼ䲻·䣬ֱ߳̿дԼregion
+		auto first = static_cast<uint32_t>(frame.mRegions.size());
+		for (uint32_t i = 0; i < count; ++i) {
+			Region region{};
+			region.mBeginQuery = frame.mQueryCount++;
+			region.mEndQuery = frame.mQueryCount++;
+			frame.mRegions.push_back(region);
+		}
+		return first;
+	}
+
+	void GpuProfiler::beginReservedRegion(const CommandBuffer::Ptr& commandBuffer, uint32_t region, uint32_t nameId, VkPipelineStageFlagBits stage) {
+		if (!_supported || region == INVALID_REGION) {
+			return;
+		}
+
+		auto& frame = _frames[_currentFrame];
+		frame.mRegions[region].mNameId = nameId;
+		commandBuffer->writeTimestamp(stage, frame.mQueryPool->getQueryPool(), frame.mRegions[region].mBeginQuery);
+	}
+
+	void GpuProfiler::endReservedRegion(const CommandBuffer::Ptr& commandBuffer, uint32_t region, VkPipelineStageFlagBits stage) {
+		if (!_supported || region == INVALID_REGION) {
+			return;
+		}
+
+		auto& frame = _frames[_currentFrame];
+		commandBuffer->writeTimestamp(stage, frame.mQueryPool->getQueryPool(), frame.mRegions[region].mEndQuery);
+	}
+
+	bool GpuProfiler::hasRoom(const Frame& frame, uint32_t count) {
+		if (frame.mQueryCount + count * 2 <= frame.mQueryPool->getQueryCount()) {
+			return true;
+		}
+
+		if (!_overflowReported) {
+			std::cout << "Warning: GPU profiler query pool is full, regions of this frame are dropped" << std::endl;
+			_overflowReported = true;
+		}
+		return false;
+	}
+
+	void GpuProfiler::collect(Frame& frame) {
+		frame.mPending = false;
+
+		//ȴֻδqueryendRegionûб¼Ƶregion
+		std::vector<uint64_t> timestamps{};
+		std::vector<bool> available{};
+		frame.mQueryPool->getResultsWithAvailability(0, frame.mQueryCount, timestamps, available);
+
+		bool trace = _calibrated && CpuProfiler::getInstance().isEnabled();
+		for (const auto& region : frame.mRegions) {
+			if (!available[region.mBeginQuery] || !available[region.mEndQuery]) {
+				continue;
+			}
+
+			uint64_t begin = timestamps[region.mBeginQuery] & _timestampMask;
+			uint64_t end = timestamps[region.mEndQuery] & _timestampMask;
+			double ms = static_cast<double>((end - begin) & _timestampMask) * _timestampPeriod / 1000000.0;
+
+			if (trace) {
+				auto beginNs = static_cast<uint64_t>(static_cast<double>(begin) * _timestampPeriod + _cpuOffsetNs);
+				CpuProfiler::getInstance().addGpuEvent(_regionNames[region.mNameId], beginNs, beginNs + static_cast<uint64_t>(ms * 1000000.0));
+			}
+
+			auto& history = _history[region.mNameId];
+			history.push_back({ frame.mFrameNumber, ms });
+			while (history.size() > _historySize) {
+				history.pop_front();
+			}
+		}
+	}
+
+	void GpuProfiler::calibrate(const SubmitScheduler::Ptr& scheduler) {
+		if (!_supported) {
+			return;
+		}
+
+		auto commandPool = CommandPool::create(_device, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+		auto commandBuffer = CommandBuffer::create(_device, commandPool);
+		auto queryPool = QueryPool::create(_device, VK_QUERY_TYPE_TIMESTAMP, 1);
+
+		commandBuffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+		commandBuffer->resetQueryPool(queryPool->getQueryPool(), 0, 1);
+		commandBuffer->writeTimestamp(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool->getQueryPool(), 0);
+		commandBuffer->end();
+
+		uint64_t cpuBegin = CpuProfiler::now();
+		scheduler->wait(scheduler->submit({ commandBuffer->getCommandBuffer() }));
+		uint64_t cpuEnd = CpuProfiler::now();
+
+		std::vector<uint64_t> timestamps{};
+		if (!queryPool->getResults(0, 1, timestamps, VK_QUERY_RESULT_WAIT_BIT)) {
+			return;
+		}
+
+		double gpuNs = static_cast<double>(timestamps[0] & _timestampMask) * _timestampPeriod;
+		double cpuNs = static_cast<double>(cpuBegin) + static_cast<double>(cpuEnd - cpuBegin) * 0.5;
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_cpuOffsetNs = cpuNs - gpuNs;
+		_calibrated = true;
+	}
+
+	GpuTimingStats GpuProfiler::getStats(const std::string& name) const {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		GpuTimingStats stats{};
+		auto iter = _regionIds.find(name);
+		if (iter == _regionIds.end() || _history[iter->second].empty()) {
+			return stats;
+		}
+
+		const auto& history = _history[iter->second];
+		std::vector<double> samples{};
+		samples.reserve(history.size());
+		for (const auto& sample : history) {
+			samples.push_back(sample.mMs);
+		}
+		stats.mSampleCount = static_cast<uint32_t>(samples.size());
+		stats.mLastMs = samples.back();
+
+		double sum = 0.0;
+		for (double sample : samples) {
+			sum += sample;
+		}
+		stats.mAvgMs = sum / samples.size();
+
+		std::sort(samples.begin(), samples.end());
+		stats.mMinMs = samples.front();
+		size_t p99Index = std::min(samples.size() - 1, static_cast<size_t>(samples.size() * 0.99));
+		stats.mP99Ms = samples[p99Index];
+
+		return stats;
+	}
+
+	std::vector<std::string> GpuProfiler::getRegionNames() const {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		//ֻѾнregion
+		std::vector<std::string> names{};
+		for (size_t i = 0; i < _regionNames.size(); ++i) {
+			if (!_history[i].empty()) {
+				names.push_back(_regionNames[i]);
+			}
+		}
+		std::sort(names.begin(), names.end());
+		return names;
+	}
+
+	std::vector<GpuSample> GpuProfiler::getSamples(const std::string& name) const {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		auto iter = _regionIds.find(name);
+		if (iter == _regionIds.end()) {
+			return {};
+		}
+		const auto& history = _history[iter->second];
+		return std::vector<GpuSample>(history.begin(), history.end());
+	}
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+#include "command_buffer.h"
+#include "query_pool.h"
+#include "submit_scheduler.h"
+#include <mutex>
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+
+namespace FF::Wrapper {
+
+	//һregion֡GPUʱλ
+	struct GpuTimingStats {
+		double mMinMs{ 0.0 };
+		double mAvgMs{ 0.0 };
+		double mP99Ms{ 0.0 };
+		double mLastMs{ 0.0 };
+		uint32_t mSampleCount{ 0 };
+	};
+
+	//һregionĳһ֡еGPUʱmFrameNumberΪbeginFrameʱ֡
+	struct GpuSample {
+		uint64_t mFrameNumber{ 0 };
+		double mMs{ 0.0 };
+	};
+
+	/*
+	* GPUʱ
+	* 1 ÿһ֡һtimestampѯأregionĿʼ/ռһquery
+	* 2 beginFrameһ֡һεύִ֮ãʱصĽѾframeCount֡ӳ
+	* 3 ʱtimestampPeriodõ룬ͬregionĺʱͬ֡űhistorySize֡ͳmin/avg/p99
+	* 4 beginRegion/endRegionڶ߳¼ƵĶCommandBufferеãqueryķ
+	*   region(Ƽʱ)¼ǰreserveRegionsһηã߳begin/endReservedRegionд룬
+	* 5 beginFrameһ֡ԤƵregionѯزʱؽģqueryȻʱ֮regionټ¼
+	*   һζʱӡ棻ʱֻδqueryӦregion
+	* 6 regionͨgetRegionIdǼΪţÿ֡¼ʱֻţƼʱʱַ
+	* 7 calibrate֮CPUʱصregionͬʱ㵽CPUʱᣬCpuProfilertrace
+	*/
+	class GpuProfiler {
+	public:
+		using Ptr = std::shared_ptr<GpuProfiler>;
+
+		static constexpr uint32_t DEFAULT_MAX_REGIONS = 256;
+		static constexpr uint32_t DEFAULT_HISTORY_SIZE = 240;
+		static constexpr uint32_t INVALID_REGION = UINT32_MAX;
+
+		//region򣬹ʱд뿪ʼʱʱдʱ
+		class Scope {
+		public:
+			Scope(const GpuProfiler::Ptr& profiler, const CommandBuffer::Ptr& commandBuffer, uint32_t nameId);
+
+			~Scope();
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+		private:
+			GpuProfiler::Ptr _profiler{ nullptr };
+			CommandBuffer::Ptr _commandBuffer{ nullptr };
+			uint32_t _region{ INVALID_REGION };
+		};
+
+		static Ptr create(
+			const Device::Ptr& device,
+			uint32_t frameCount,
+			uint32_t maxRegions = DEFAULT_MAX_REGIONS,
+			uint32_t historySize = DEFAULT_HISTORY_SIZE
+		) {
+			return std::make_shared<GpuProfiler>(device, frameCount, maxRegions, historySize);
+		}
+
+		GpuProfiler(
+			const Device::Ptr& device,
+			uint32_t frameCount,
+			uint32_t maxRegions = DEFAULT_MAX_REGIONS,
+			uint32_t historySize = DEFAULT_HISTORY_SIZE
+		);
+
+		~GpuProfiler() = default;
+
+		//¼һ֡CommandBufferʱbegin֮RenderPass֮ǰãһεĽòѯ
+		//frameNumber¼һ֡ĽУصӳٲ̶(罻ؽʱ֡)ʹ߰֡ŶӦ
+		//regionCountΪһ֡ԤƵregionѯصʱؽѯأ֮֡ʹ
+		void beginFrame(const CommandBuffer::Ptr& commandBuffer, uint32_t frameIndex, uint64_t frameNumber, uint32_t regionCount = 0);
+
+		//Ǽregionƣͬͬһţ¼֮ǰ
+		uint32_t getRegionId(const std::string& name);
+
+		//regionţ֧ʱqueryʱINVALID_REGION
+		uint32_t beginRegion(
+			const CommandBuffer::Ptr& commandBuffer,
+			uint32_t nameId,
+			VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT
+		);
+
+		void endRegion(
+			const CommandBuffer::Ptr& commandBuffer,
+			uint32_t region,
+			VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+		);
+
+		//¼߳̿ʼ֮ǰãԤcountregionصһţqueryʱINVALID_REGION
+		uint32_t reserveRegions(uint32_t count);
+
+		//regionΪreserveRegionsصżƫƣÿregionֻһ߳д룬
+		void beginReservedRegion(
+			const CommandBuffer::Ptr& commandBuffer,
+			uint32_t region,
+			uint32_t nameId,
+			VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT
+		);
+
+		void endReservedRegion(
+			const CommandBuffer::Ptr& commandBuffer,
+			uint32_t region,
+			VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+		);
+
+		/*
+		* У׼GPUʱCpuProfiler::now()֮ƫƣȴһύ
+		* 1 ֻдһʱȡύǰCPUʱеΪӦʱ̣һύʱ
+		* 2 GPUʱCPUʱӻỺƯƣʱʱٴε
+		*/
+		void calibrate(const SubmitScheduler::Ptr& scheduler);
+
+		[[nodiscard]] GpuTimingStats getStats(const std::string& name) const;
+
+		//
+		[[nodiscard]] std::vector<std::string> getRegionNames() const;
+
+		//regionȫʷʱնص˳
+		[[nodiscard]] std::vector<GpuSample> getSamples(const std::string& name) const;
+
+		[[nodiscard]] bool isSupported() const { return _supported; }
+
+	private:
+		struct Region {
+			uint32_t mNameId{ 0 };
+			uint32_t mBeginQuery{ 0 };
+			uint32_t mEndQuery{ 0 };
+		};
+
+		struct Frame {
+			QueryPool::Ptr mQueryPool{ nullptr };
+			std::vector<Region> mRegions{};
+			uint32_t mQueryCount{ 0 };
+			uint64_t mFrameNumber{ 0 };
+
+			//Ѿ¼ʱûж
+			bool mPending{ false };
+		};
+
+		//frameһεĽʷ
+		void collect(Frame& frame);
+
+		//ѯطŲcountregionʱfalseһʱӡ棻ǰҪ_mutex
+		bool hasRoom(const Frame& frame, uint32_t count);
+
+	private:
+		bool _supported{ false };
+
+		//һʱλӦ
+		double _timestampPeriod{ 1.0 };
+
+		//ʱЧλЧλĲҪ
+		uint64_t _timestampMask{ UINT64_MAX };
+
+		//CPUʱ() = GPUʱ() + _cpuOffsetNs
+		bool _calibrated{ false };
+		double _cpuOffsetNs{ 0.0 };
+
+		uint32_t _maxRegions{ 0 };
+		uint32_t _historySize{ 0 };
+
+		std::vector<Frame> _frames{};
+		uint32_t _currentFrame{ 0 };
+
+		//ǰ֡region䣬¼̶߳߳
+		mutable std::mutex _mutex;
+
+		bool _overflowReported{ false };
+
+		//regionţż_regionNames_historyеλ
+		std::unordered_map<std::string, uint32_t> _regionIds{};
+		std::vector<std::string> _regionNames{};
+		std::vector<std::deque<GpuSample>> _history{};
+
+		Device::Ptr _device{ nullptr };
+	};
+}
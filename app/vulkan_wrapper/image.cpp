@@ -1,6 +1,5 @@
 #include "image.h"
 #include "command_buffer.h"
-#include "buffer.h"
 
 namespace FF::Wrapper {
 
@@ -73,12 +72,15 @@ namespace FF::Wrapper {
 		const VkImageUsageFlags& usage,
 		const VkSampleCountFlagBits& samples,
 		const VkMemoryPropertyFlags& properties,
-		const VkImageAspectFlags& aspectFlags
+		const VkImageAspectFlags& aspectFlags,
+		uint32_t mipLevels
 	) {
 		_device = device;
 		_width = width;
 		_height = height;
 		_format = format;
+		_mipLevels = mipLevels;
+		_aspectFlags = aspectFlags;
 		_layout = VK_IMAGE_LAYOUT_UNDEFINED;
 
 		VkImageCreateInfo imageCreateInfo{};
@@ -91,7 +93,7 @@ namespace FF::Wrapper {
 		imageCreateInfo.tiling = imageTiling;
 		imageCreateInfo.usage = usage;
 		imageCreateInfo.samples = samples;
-		imageCreateInfo.mipLevels = 1;
+		imageCreateInfo.mipLevels = mipLevels;
 		imageCreateInfo.arrayLayers = 1;
 		imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 		imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
@@ -100,22 +102,18 @@ namespace FF::Wrapper {
 			throw std::runtime_error("Error: failed to create image");
 		}
 
-		//ڴռ
+		//ڴռ䣬ȾĿȸ߶䣬ӷblockг
 		VkMemoryRequirements memReq{};
 		vkGetImageMemoryRequirements(_device->getDevice(), _image, &memReq);
 
-		VkMemoryAllocateInfo allocInfo{};
-		allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-		allocInfo.allocationSize = memReq.size;
-
-		//bufferڴ͵ID
-		allocInfo.memoryTypeIndex = findMemoryType(memReq.memoryTypeBits, properties);
-
-		if (vkAllocateMemory(_device->getDevice(), &allocInfo, nullptr, &_imageMemory) != VK_SUCCESS) {
-			throw std::runtime_error("Error: failed to allocate memory");
-		}
+		bool isAttachment = (usage & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)) != 0;
+		_allocation = _device->getAllocator()->allocate(
+			memReq, properties,
+			imageTiling == VK_IMAGE_TILING_LINEAR,
+			isAttachment
+		);
 
-		vkBindImageMemory(_device->getDevice(), _image, _imageMemory, 0);
+		vkBindImageMemory(_device->getDevice(), _image, _allocation.mMemory, _allocation.mOffset);
 
 		//imageView
 		VkImageViewCreateInfo imageViewCreateInfo{};
@@ -125,7 +123,7 @@ namespace FF::Wrapper {
 		imageViewCreateInfo.image = _image;
 		imageViewCreateInfo.subresourceRange.aspectMask = aspectFlags;
 		imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
-		imageViewCreateInfo.subresourceRange.levelCount = 1;
+		imageViewCreateInfo.subresourceRange.levelCount = mipLevels;
 		imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
 		imageViewCreateInfo.subresourceRange.layerCount = 1;
 
@@ -139,20 +137,18 @@ namespace FF::Wrapper {
 		if (_imageView != VK_NULL_HANDLE) {
 			vkDestroyImageView(_device->getDevice(), _imageView, nullptr);
 		}
-		if (_imageMemory != VK_NULL_HANDLE) {
-			vkFreeMemory(_device->getDevice(), _imageMemory, nullptr);
-		}
 		if (_image != VK_NULL_HANDLE) {
 			vkDestroyImage(_device->getDevice(), _image, nullptr);
 		}
+		_device->getAllocator()->free(_allocation);
 	}
 
-	void Image::setImageLayout(
+	void Image::addLayoutBarrier(
+		const CommandBuffer::Ptr& commandBuffer,
 		const VkImageLayout& layout,
 		const VkPipelineStageFlags& srcStageMask,
 		const VkPipelineStageFlags& dstStageMask,
-		const VkImageSubresourceRange& subresourceRange,
-		const CommandPool::Ptr& commandPool
+		const VkImageSubresourceRange& subresourceRange
 	) {
 		VkImageMemoryBarrier imageMemoryBarrier{};
 		imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -202,38 +198,91 @@ namespace FF::Wrapper {
 
 		_layout = layout;
 
-		auto commandBuffer = CommandBuffer::create(_device, commandPool);
-		commandBuffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-		commandBuffer->transferImageLayout(imageMemoryBarrier, srcStageMask, dstStageMask);
-		commandBuffer->end();
-		commandBuffer->submitSync(_device->getGraphicQueue());
-
+		commandBuffer->addImageBarrier(imageMemoryBarrier, srcStageMask, dstStageMask);
 	}
 
-	void Image::fillImageData(const CommandPool::Ptr& commadPool, size_t size, void* data) {
-		assert(data);
-		assert(size);
-		auto stageBuffer = Buffer::createStageBuffer(_device, size, data);
-		auto commandBuffer = CommandBuffer::create(_device, commadPool);
-		commandBuffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-		commandBuffer->copyBufferToImage(stageBuffer->getBuffer(), _image, _layout, _width, _height);
-		commandBuffer->end();
-		commandBuffer->submitSync(_device->getGraphicQueue());
+	void Image::generateMipmaps(
+		const CommandBuffer::Ptr& commandBuffer,
+		VkImageLayout finalLayout,
+		VkPipelineStageFlags dstStageMask
+	) {
+		VkImageMemoryBarrier barrier{};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = _image;
+		barrier.subresourceRange.aspectMask = _aspectFlags;
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = 1;
+		barrier.subresourceRange.levelCount = 1;
+
+		int32_t mipWidth = static_cast<int32_t>(_width);
+		int32_t mipHeight = static_cast<int32_t>(_height);
+
+		for (uint32_t i = 1; i < _mipLevels; ++i) {
+			//һдϣΪblitԴ
+			barrier.subresourceRange.baseMipLevel = i - 1;
+			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+			barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+			commandBuffer->addImageBarrier(barrier, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+			int32_t nextWidth = mipWidth > 1 ? mipWidth / 2 : 1;
+			int32_t nextHeight = mipHeight > 1 ? mipHeight / 2 : 1;
+
+			VkImageBlit blit{};
+			blit.srcOffsets[0] = { 0, 0, 0 };
+			blit.srcOffsets[1] = { mipWidth, mipHeight, 1 };
+			blit.srcSubresource.aspectMask = _aspectFlags;
+			blit.srcSubresource.mipLevel = i - 1;
+			blit.srcSubresource.baseArrayLayer = 0;
+			blit.srcSubresource.layerCount = 1;
+			blit.dstOffsets[0] = { 0, 0, 0 };
+			blit.dstOffsets[1] = { nextWidth, nextHeight, 1 };
+			blit.dstSubresource.aspectMask = _aspectFlags;
+			blit.dstSubresource.mipLevel = i;
+			blit.dstSubresource.baseArrayLayer = 0;
+			blit.dstSubresource.layerCount = 1;
+
+			commandBuffer->blitImage(
+				_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+				_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				{ blit }, VK_FILTER_LINEAR
+			);
+
+			//һѾ꣬תΪյlayoutһbarrierһblitǰһflush
+			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+			barrier.newLayout = finalLayout;
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			commandBuffer->addImageBarrier(barrier, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStageMask);
+
+			mipWidth = nextWidth;
+			mipHeight = nextHeight;
+		}
+
+		//һֻд룬ûΪԴ
+		barrier.subresourceRange.baseMipLevel = _mipLevels - 1;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout = finalLayout;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		commandBuffer->addImageBarrier(barrier, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStageMask);
+
+		_layout = finalLayout;
 	}
 
-	uint32_t Image::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-		VkPhysicalDeviceMemoryProperties memProps;
-		vkGetPhysicalDeviceMemoryProperties(_device->getPhysicalDevice(), &memProps);
+	bool Image::isLinearBlitSupported(const Device::Ptr& device, VkFormat format) {
+		VkFormatProperties props;
+		vkGetPhysicalDeviceFormatProperties(device->getPhysicalDevice(), format, &props);
 
-		// typeFilter=0x0001|0x0100 i==0ʱ (typeFilter & (1 << i) Ϊ棬
-		//typeFilterΪ±Ļֻ±Ϊ 1<<i
+		VkFormatFeatureFlags required = 
+			VK_FORMAT_FEATURE_BLIT_SRC_BIT | 
+			VK_FORMAT_FEATURE_BLIT_DST_BIT | 
+			VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
 
-		for (uint32_t i = 0; i < memProps.memoryTypeCount; ++i) {
-			if ((typeFilter & (1 << i)) && ((memProps.memoryTypes[i].propertyFlags & properties) == properties)) {
-				return i;
-			}
-		}
-		throw std::runtime_error("Error: failed to find the property memory type");
+		return (props.optimalTilingFeatures & required) == required;
 	}
 
 	VkFormat Image::findDepthFormat(const Device::Ptr& device) {
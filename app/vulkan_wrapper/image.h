@@ -2,7 +2,7 @@
 
 #include "../base.h"
 #include "device.h"
-#include "command_pool.h"
+#include "command_buffer.h"
 
 namespace FF::Wrapper {
 
@@ -34,6 +34,21 @@ namespace FF::Wrapper {
 			VkFormatFeatureFlags features
 		);
 
+		//mipmapļfloor(log2(max(width, height))) + 1
+		//ֻ㣬Ҫvulkanʱtexture_cookerҲֱʹ
+		static uint32_t calculateMipLevels(uint32_t width, uint32_t height) {
+			uint32_t levels = 1;
+			uint32_t size = std::max(width, height);
+			while (size > 1) {
+				size >>= 1;
+				++levels;
+			}
+			return levels;
+		}
+
+		//optimalŲܷΪblitԴĿ֧꣬Թˣ֧ʱֻCPUmipmap
+		static bool isLinearBlitSupported(const Device::Ptr& device, VkFormat format);
+
 	public:
 
 		static Ptr create(
@@ -46,9 +61,10 @@ namespace FF::Wrapper {
 			const VkImageUsageFlags& usage,
 			const VkSampleCountFlagBits& samples,
 			const VkMemoryPropertyFlags& properties,
-			const VkImageAspectFlags& aspectFlags
+			const VkImageAspectFlags& aspectFlags,
+			uint32_t mipLevels = 1
 		) {
-			return std::make_shared<Image>(device, width, height, format, imageType, imageTiling, usage, samples, properties, aspectFlags);
+			return std::make_shared<Image>(device, width, height, format, imageType, imageTiling, usage, samples, properties, aspectFlags, mipLevels);
 		}
 
 		Image(
@@ -61,22 +77,33 @@ namespace FF::Wrapper {
 			const VkImageUsageFlags& usage,
 			const VkSampleCountFlagBits& samples,
 			const VkMemoryPropertyFlags& properties,
-			const VkImageAspectFlags& aspectFlags
+			const VkImageAspectFlags& aspectFlags,
+			uint32_t mipLevels = 1
 		);
 
 		
 		~Image();
 
-		//齫÷д뵽
-		void setImageLayout(
-			const VkImageLayout& layout, 
-			const VkPipelineStageFlags& srcStageMask, 
+		//layoutתbarriercommandBufferbarrierУύһ/Ƶָ֮ǰԶflush
+		void addLayoutBarrier(
+			const CommandBuffer::Ptr& commandBuffer,
+			const VkImageLayout& layout,
+			const VkPipelineStageFlags& srcStageMask,
 			const VkPipelineStageFlags& dstStageMask,
-			const VkImageSubresourceRange& subresourceRange,
-			const CommandPool::Ptr& commandPool
-			);
+			const VkImageSubresourceRange& subresourceRange
+		);
 
-		void fillImageData(const CommandPool::Ptr& commadPool, size_t size, void* data);
+		/*
+		* vkCmdBlitImagemipmap¼һȾcommandBuffer
+		* 1 ǰм𶼴TRANSFER_DST0ѾдݣͼƬҪTRANSFER_SRC;
+		* 2 i-1תΪTRANSFER_SRCСһblitiתΪfinalLayout
+		* 3 i-1finalLayoutתiTRANSFER_SRCתϲͬһbarrier
+		*/
+		void generateMipmaps(
+			const CommandBuffer::Ptr& commandBuffer,
+			VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+		);
 
 		bool hasStencilComponent();
 
@@ -86,13 +113,16 @@ namespace FF::Wrapper {
 
 		[[nodiscard]] VkImageLayout getLayout() const { return _layout; }
 
+		//layoutתⲿ¼ʱ(ȨתƵbarrier)ͬ¼layout
+		void setLayout(VkImageLayout layout) { _layout = layout; }
+
 		[[nodiscard]] size_t getWidth() const { return _width; }
 
 		[[nodiscard]] size_t getHeight() const { return _height; }
 
-	private:
+		[[nodiscard]] VkFormat getFormat() const { return _format; }
 
-		uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+		[[nodiscard]] uint32_t getMipLevels() const { return _mipLevels; }
 
 	private:
 		Device::Ptr _device{ nullptr };
@@ -100,10 +130,12 @@ namespace FF::Wrapper {
 		uint32_t _width{ 0 };
 		uint32_t _height{ 0 };
 		VkImage _image{ VK_NULL_HANDLE };
-		VkDeviceMemory _imageMemory{ VK_NULL_HANDLE };
+		MemoryAllocation _allocation{};
 		VkImageView _imageView{ VK_NULL_HANDLE };
 		VkImageLayout _layout{ VK_IMAGE_LAYOUT_UNDEFINED };
 		VkFormat _format;
+		uint32_t _mipLevels{ 1 };
+		VkImageAspectFlags _aspectFlags{ 0 };
 	};
 
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "instance.h"
+#include <algorithm>
 
 namespace FF::Wrapper {
 	//validationLayer callback
@@ -37,8 +38,18 @@ namespace FF::Wrapper {
 		}
 	}
 
-	Instance::Instance(bool enableValidationLayer){
+	uint32_t Instance::queryInstanceVersion() {
+		auto func = (PFN_vkEnumerateInstanceVersion)vkGetInstanceProcAddr(VK_NULL_HANDLE, "vkEnumerateInstanceVersion");
+		uint32_t version = VK_API_VERSION_1_0;
+		if (func == nullptr || func(&version) != VK_SUCCESS) {
+			return VK_API_VERSION_1_0;
+		}
+		return version;
+	}
+
+	Instance::Instance(bool enableValidationLayer, bool headless){
 		_enableValidationLayer = enableValidationLayer;
+		_headless = headless;
 		if (_enableValidationLayer && !checkValidationLayerSupport()) {
 			throw std::runtime_error("Error: validaton layer is not supported");
 		}
@@ -51,7 +62,10 @@ namespace FF::Wrapper {
 		appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
 		appInfo.pEngineName = "No Engine";
 		appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-		appInfo.apiVersion = VK_API_VERSION_1_0;
+		//1.1кĵvkGetPhysicalDeviceFeatures21.2кĵdescriptor indexingtimeline semaphore
+		//İ汾ֵ֧ܳİ汾1.0ʵֻᴴʧ
+		_apiVersion = std::min(queryInstanceVersion(), static_cast<uint32_t>(VK_API_VERSION_1_2));
+		appInfo.apiVersion = _apiVersion;
 
 		VkInstanceCreateInfo instCreateInfo = {};
 		instCreateInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -98,11 +112,16 @@ namespace FF::Wrapper {
 	}
 
 	std::vector<const char*> Instance::getRequiredExtensions() {
-		uint32_t glfwExtensionCount = 0;
-		const char** glfwExtensions = glfwGetRequiredInstanceExtensions (&glfwExtensionCount);
-		std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount); 
+		std::vector<const char*> extensions{};
+		if (!_headless) {
+			uint32_t glfwExtensionCount = 0;
+			const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+			extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+		}
 
-		extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+		if (_enableValidationLayer) {
+			extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+		}
 
 		return extensions;
 	}
@@ -7,9 +7,12 @@ namespace FF::Wrapper {
 	public:
 		using Ptr = std::shared_ptr<Instance>;
 
-		static Ptr create(bool enableValidationLayer) { return std::make_shared<Instance>(enableValidationLayer); }
+		//headlessΪtrueʱglfwsurfaceչûдϵͳҲԴ
+		static Ptr create(bool enableValidationLayer, bool headless = false) { 
+			return std::make_shared<Instance>(enableValidationLayer, headless); 
+		}
 
-		Instance(bool enableValidationLayer);
+		Instance(bool enableValidationLayer, bool headless = false);
 
 		~Instance();
 
@@ -24,9 +27,19 @@ namespace FF::Wrapper {
 		[[nodiscard]] VkInstance getInstance() const { return _instance; }
 
 		[[nodiscard]] bool getEnableValidationLayer() const { return _enableValidationLayer; }
+
+		//ʵʱʹõapiVersionΪֵ֧İ汾1.2нСһ
+		[[nodiscard]] uint32_t getApiVersion() const { return _apiVersion; }
+
+	private:
+		//1.0ļûvkEnumerateInstanceVersion
+		static uint32_t queryInstanceVersion();
+
 	private:
 		VkInstance _instance{ VK_NULL_HANDLE };
 		bool _enableValidationLayer{ false };
+		bool _headless{ false };
+		uint32_t _apiVersion{ VK_API_VERSION_1_0 };
 		VkDebugUtilsMessengerEXT _debugger{ VK_NULL_HANDLE };
 	};
 }
\ No newline at end of file
@@ -0,0 +1,313 @@
+#include "memory_allocator.h"
+
+namespace FF::Wrapper {
+
+	static VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+		return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+	}
+
+	static VkDeviceSize alignDown(VkDeviceSize value, VkDeviceSize alignment) {
+		return alignment > 1 ? value / alignment * alignment : value;
+	}
+
+	MemoryAllocator::MemoryAllocator(VkPhysicalDevice physicalDevice, VkDevice device, VkDeviceSize blockSize) {
+		_physicalDevice = physicalDevice;
+		_device = device;
+		_blockSize = blockSize;
+
+		vkGetPhysicalDeviceMemoryProperties(_physicalDevice, &_memProps);
+
+		VkPhysicalDeviceProperties props;
+		vkGetPhysicalDeviceProperties(_physicalDevice, &props);
+		_nonCoherentAtomSize = std::max<VkDeviceSize>(props.limits.nonCoherentAtomSize, 1);
+
+		_pools.resize(_memProps.memoryTypeCount * 2);
+	}
+
+	MemoryAllocator::~MemoryAllocator() {
+		for (auto& pool : _pools) {
+			for (auto& block : pool) {
+				if (block->mAllocationCount > 0) {
+					std::cout << "Warning: memory block destroyed with " << block->mAllocationCount << " live allocations" << std::endl;
+				}
+				destroyBlock(block.get());
+			}
+			pool.clear();
+		}
+	}
+
+	uint32_t MemoryAllocator::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
+		// typeFilter=0x0001|0x0100 i==0ʱ (typeFilter & (1 << i) Ϊ棬
+		//typeFilterΪ±Ļֻ±Ϊ 1<<i
+		for (uint32_t i = 0; i < _memProps.memoryTypeCount; ++i) {
+			if ((typeFilter & (1 << i)) && ((_memProps.memoryTypes[i].propertyFlags & properties) == properties)) {
+				return i;
+			}
+		}
+		throw std::runtime_error("Error: failed to find the property memory type");
+	}
+
+	bool MemoryAllocator::isHostVisible(uint32_t memoryTypeIndex) const {
+		return (_memProps.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+	}
+
+	bool MemoryAllocator::isHostCoherent(uint32_t memoryTypeIndex) const {
+		return (_memProps.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+	}
+
+	void* MemoryAllocator::mapMemory(VkDeviceMemory memory, uint32_t memoryTypeIndex) {
+		if (!isHostVisible(memoryTypeIndex)) {
+			return nullptr;
+		}
+
+		//ͬһVkDeviceMemoryܱظmapڴʱӳ䣬֮һֱ
+		void* data = nullptr;
+		if (vkMapMemory(_device, memory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS) {
+			throw std::runtime_error("Error: failed to map memory block");
+		}
+		return data;
+	}
+
+	MemoryAllocation MemoryAllocator::allocate(
+		const VkMemoryRequirements& requirements,
+		VkMemoryPropertyFlags properties,
+		bool linear,
+		bool preferDedicated
+	) {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		uint32_t memoryTypeIndex = findMemoryType(requirements.memoryTypeBits, properties);
+
+		//Դ䣬Žblockֻblockܿ챻ռԸ
+		if (preferDedicated || requirements.size > _blockSize / 2) {
+			return allocateDedicated(requirements.size, memoryTypeIndex);
+		}
+
+		VkDeviceSize alignment = requirements.alignment;
+		if (!isHostCoherent(memoryTypeIndex) && isHostVisible(memoryTypeIndex)) {
+			//flushķΧҪnonCoherentAtomSize룬ʱԱflush˵
+			alignment = std::max(alignment, _nonCoherentAtomSize);
+		}
+
+		uint32_t poolIndex = memoryTypeIndex * 2 + (linear ? 0 : 1);
+		MemoryAllocation allocation{};
+		for (auto& block : _pools[poolIndex]) {
+			if (allocateFromBlock(block.get(), requirements.size, alignment, allocation)) {
+				return allocation;
+			}
+		}
+
+		auto block = createBlock(poolIndex, memoryTypeIndex, requirements.size);
+		if (!allocateFromBlock(block, requirements.size, alignment, allocation)) {
+			throw std::runtime_error("Error: failed to allocate from new memory block");
+		}
+		return allocation;
+	}
+
+	MemoryAllocation MemoryAllocator::allocateDedicated(VkDeviceSize size, uint32_t memoryTypeIndex) {
+		VkMemoryAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		allocInfo.allocationSize = size;
+		allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+		MemoryAllocation allocation{};
+		if (vkAllocateMemory(_device, &allocInfo, nullptr, &allocation.mMemory) != VK_SUCCESS) {
+			throw std::runtime_error("Error: failed to allocate memory");
+		}
+
+		allocation.mOffset = 0;
+		allocation.mSize = size;
+		allocation.mMemoryTypeIndex = memoryTypeIndex;
+		allocation.mDedicated = true;
+		allocation.mMappedData = mapMemory(allocation.mMemory, memoryTypeIndex);
+
+		++_dedicatedCount;
+		_dedicatedBytes += size;
+
+		return allocation;
+	}
+
+	MemoryBlock* MemoryAllocator::createBlock(uint32_t poolIndex, uint32_t memoryTypeIndex, VkDeviceSize minSize) {
+		//С(256MBBARڴ)ϲһ̫
+		uint32_t heapIndex = _memProps.memoryTypes[memoryTypeIndex].heapIndex;
+		VkDeviceSize blockSize = std::min(_blockSize, _memProps.memoryHeaps[heapIndex].size / 8);
+		blockSize = std::max(blockSize, minSize);
+
+		auto block = std::make_unique<MemoryBlock>();
+
+		VkMemoryAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+		//Դŵʱ𲽼
+		VkResult result = VK_ERROR_OUT_OF_DEVICE_MEMORY;
+		while (true) {
+			allocInfo.allocationSize = blockSize;
+			result = vkAllocateMemory(_device, &allocInfo, nullptr, &block->mMemory);
+			if (result == VK_SUCCESS || blockSize / 2 < minSize) {
+				break;
+			}
+			blockSize /= 2;
+		}
+
+		if (result != VK_SUCCESS) {
+			throw std::runtime_error("Error: failed to allocate memory block");
+		}
+
+		block->mSize = blockSize;
+		block->mPoolIndex = poolIndex;
+		block->mMappedData = mapMemory(block->mMemory, memoryTypeIndex);
+		block->mFreeRanges = FreeRangeList(blockSize);
+
+		_pools[poolIndex].push_back(std::move(block));
+		return _pools[poolIndex].back().get();
+	}
+
+	void MemoryAllocator::destroyBlock(MemoryBlock* block) {
+		if (block->mMappedData != nullptr) {
+			vkUnmapMemory(_device, block->mMemory);
+		}
+		if (block->mMemory != VK_NULL_HANDLE) {
+			vkFreeMemory(_device, block->mMemory, nullptr);
+		}
+	}
+
+	bool MemoryAllocator::allocateFromBlock(MemoryBlock* block, VkDeviceSize size, VkDeviceSize alignment, MemoryAllocation& allocation) {
+		VkDeviceSize offset = 0;
+		VkDeviceSize padding = 0;
+		if (!block->mFreeRanges.allocate(size, alignment, offset, padding)) {
+			return false;
+		}
+
+		++block->mAllocationCount;
+		block->mUsedBytes += size;
+		block->mWastedBytes += padding;
+
+		allocation.mMemory = block->mMemory;
+		allocation.mOffset = offset;
+		allocation.mSize = size;
+		allocation.mMemoryTypeIndex = block->mPoolIndex / 2;
+		allocation.mPadding = padding;
+		allocation.mDedicated = false;
+		allocation.mBlock = block;
+		allocation.mMappedData = block->mMappedData ? static_cast<char*>(block->mMappedData) + allocation.mOffset : nullptr;
+
+		return true;
+	}
+
+	void MemoryAllocator::free(MemoryAllocation& allocation) {
+		if (!allocation.isValid()) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		if (allocation.mDedicated) {
+			if (allocation.mMappedData != nullptr) {
+				vkUnmapMemory(_device, allocation.mMemory);
+			}
+			vkFreeMemory(_device, allocation.mMemory, nullptr);
+			--_dedicatedCount;
+			_dedicatedBytes -= allocation.mSize;
+			allocation = MemoryAllocation{};
+			return;
+		}
+
+		MemoryBlock* block = allocation.mBlock;
+
+		--block->mAllocationCount;
+		block->mUsedBytes -= allocation.mSize;
+		block->mWastedBytes -= allocation.mPadding;
+		block->mFreeRanges.free(allocation.mOffset, allocation.mSize, allocation.mPadding);
+
+		//blockֻһĻ
+		if (block->mAllocationCount == 0) {
+			auto& pool = _pools[block->mPoolIndex];
+			size_t emptyCount = 0;
+			for (const auto& b : pool) {
+				if (b->mAllocationCount == 0) {
+					++emptyCount;
+				}
+			}
+
+			if (emptyCount > 1) {
+				for (auto it = pool.begin(); it != pool.end(); ++it) {
+					if (it->get() == block) {
+						destroyBlock(block);
+						pool.erase(it);
+						break;
+					}
+				}
+			}
+		}
+
+		allocation = MemoryAllocation{};
+	}
+
+	void MemoryAllocator::flush(const MemoryAllocation& allocation, VkDeviceSize offset, VkDeviceSize size) {
+		if (!allocation.isValid() || isHostCoherent(allocation.mMemoryTypeIndex)) {
+			return;
+		}
+
+		if (size == VK_WHOLE_SIZE) {
+			size = allocation.mSize - offset;
+		}
+
+		VkDeviceSize begin = alignDown(allocation.mOffset + offset, _nonCoherentAtomSize);
+		VkDeviceSize end = alignUp(allocation.mOffset + offset + size, _nonCoherentAtomSize);
+
+		VkMappedMemoryRange range{};
+		range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+		range.memory = allocation.mMemory;
+		range.offset = begin;
+		range.size = end - begin;
+
+		//֮Խڴĩβ
+		VkDeviceSize memorySize = allocation.mBlock ? allocation.mBlock->mSize : allocation.mSize;
+		if (range.offset + range.size > memorySize) {
+			range.size = VK_WHOLE_SIZE;
+		}
+
+		vkFlushMappedMemoryRanges(_device, 1, &range);
+	}
+
+	MemoryStats MemoryAllocator::getStats() {
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		MemoryStats stats{};
+		stats.mDedicatedCount = _dedicatedCount;
+		stats.mDedicatedBytes = _dedicatedBytes;
+		stats.mAllocationCount = _dedicatedCount;
+		stats.mUsedBytes = _dedicatedBytes;
+
+		for (const auto& pool : _pools) {
+			for (const auto& block : pool) {
+				++stats.mBlockCount;
+				stats.mBlockBytes += block->mSize;
+				stats.mAllocationCount += block->mAllocationCount;
+				stats.mUsedBytes += block->mUsedBytes;
+				stats.mWastedBytes += block->mWastedBytes;
+
+				stats.mFreeBytes += block->mFreeRanges.getFreeBytes();
+				stats.mLargestFreeRange = std::max(stats.mLargestFreeRange, block->mFreeRanges.getLargestRange());
+			}
+		}
+
+		if (stats.mFreeBytes > 0) {
+			stats.mFragmentation = 1.0f - static_cast<float>(stats.mLargestFreeRange) / static_cast<float>(stats.mFreeBytes);
+		}
+
+		return stats;
+	}
+
+	void MemoryAllocator::printStats() {
+		auto stats = getStats();
+		std::cout << "MemoryAllocator: "
+			<< stats.mBlockCount << " blocks (" << stats.mBlockBytes / 1024 << " KB), "
+			<< stats.mDedicatedCount << " dedicated (" << stats.mDedicatedBytes / 1024 << " KB), "
+			<< stats.mAllocationCount << " allocations, "
+			<< stats.mUsedBytes / 1024 << " KB used, "
+			<< stats.mWastedBytes << " bytes wasted, "
+			<< "fragmentation " << stats.mFragmentation << std::endl;
+	}
+}
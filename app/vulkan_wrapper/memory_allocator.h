@@ -0,0 +1,135 @@
+#pragma once
+
+#include "../base.h"
+#include "free_range_list.h"
+#include <mutex>
+
+namespace FF::Wrapper {
+
+	/*
+	* Դӷ
+	* 1 ÿһڴάɴ(block)Buffer/ImageblockгһʹãÿԴһvkAllocateMemory
+	* 2 blockڲʹðoffsetĿʱbest-fitͷʱǰϲ
+	* 3 Linear(Buffer/Image)Optimal(ŲImage)ֿڲͬblockbufferImageGranularityĳͻ
+	* 4 blockһСʽҪԴ(ȾĿ)߶
+	*/
+
+	struct MemoryBlock;
+
+	struct MemoryAllocation {
+		VkDeviceMemory mMemory{ VK_NULL_HANDLE };
+		VkDeviceSize mOffset{ 0 };
+		VkDeviceSize mSize{ 0 };
+		uint32_t mMemoryTypeIndex{ 0 };
+
+		//HostVisibleڴ泣פӳ䣬Ѿoffsetĵַ
+		void* mMappedData{ nullptr };
+
+		bool mDedicated{ false };
+
+		//Ϊֽͷʱһ黹
+		VkDeviceSize mPadding{ 0 };
+
+		MemoryBlock* mBlock{ nullptr };
+
+		[[nodiscard]] bool isValid() const { return mMemory != VK_NULL_HANDLE; }
+	};
+
+	struct MemoryStats {
+		uint32_t mBlockCount{ 0 };
+		uint32_t mDedicatedCount{ 0 };
+		uint32_t mAllocationCount{ 0 };
+
+		VkDeviceSize mBlockBytes{ 0 };
+		VkDeviceSize mDedicatedBytes{ 0 };
+		VkDeviceSize mUsedBytes{ 0 };
+
+		//˷ѵֽ
+		VkDeviceSize mWastedBytes{ 0 };
+
+		VkDeviceSize mFreeBytes{ 0 };
+		VkDeviceSize mLargestFreeRange{ 0 };
+
+		//1 - /ȫУ0ʾпռȫ
+		float mFragmentation{ 0.0f };
+	};
+
+	struct MemoryBlock {
+		VkDeviceMemory mMemory{ VK_NULL_HANDLE };
+		VkDeviceSize mSize{ 0 };
+		void* mMappedData{ nullptr };
+		uint32_t mPoolIndex{ 0 };
+
+		FreeRangeList mFreeRanges{};
+
+		uint32_t mAllocationCount{ 0 };
+		VkDeviceSize mUsedBytes{ 0 };
+		VkDeviceSize mWastedBytes{ 0 };
+	};
+
+	class MemoryAllocator {
+	public:
+		using Ptr = std::shared_ptr<MemoryAllocator>;
+
+		static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = 64ull * 1024 * 1024;
+
+		static Ptr create(VkPhysicalDevice physicalDevice, VkDevice device, VkDeviceSize blockSize = DEFAULT_BLOCK_SIZE) {
+			return std::make_shared<MemoryAllocator>(physicalDevice, device, blockSize);
+		}
+
+		//ﲻDevice::PtrDeviceзѭ
+		MemoryAllocator(VkPhysicalDevice physicalDevice, VkDevice device, VkDeviceSize blockSize = DEFAULT_BLOCK_SIZE);
+
+		~MemoryAllocator();
+
+		//linear: BufferLINEARŲImageΪtrue
+		MemoryAllocation allocate(
+			const VkMemoryRequirements& requirements,
+			VkMemoryPropertyFlags properties,
+			bool linear,
+			bool preferDedicated = false
+		);
+
+		void free(MemoryAllocation& allocation);
+
+		//HostCoherentڴдҪflushCoherentڴֱӷ
+		void flush(const MemoryAllocation& allocation, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+
+		[[nodiscard]] MemoryStats getStats();
+
+		void printStats();
+
+		uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+
+	private:
+		MemoryAllocation allocateDedicated(VkDeviceSize size, uint32_t memoryTypeIndex);
+
+		bool allocateFromBlock(MemoryBlock* block, VkDeviceSize size, VkDeviceSize alignment, MemoryAllocation& allocation);
+
+		MemoryBlock* createBlock(uint32_t poolIndex, uint32_t memoryTypeIndex, VkDeviceSize minSize);
+
+		void destroyBlock(MemoryBlock* block);
+
+		void* mapMemory(VkDeviceMemory memory, uint32_t memoryTypeIndex);
+
+		bool isHostVisible(uint32_t memoryTypeIndex) const;
+
+		bool isHostCoherent(uint32_t memoryTypeIndex) const;
+
+	private:
+		VkPhysicalDevice _physicalDevice{ VK_NULL_HANDLE };
+		VkDevice _device{ VK_NULL_HANDLE };
+		VkDeviceSize _blockSize{ DEFAULT_BLOCK_SIZE };
+
+		VkPhysicalDeviceMemoryProperties _memProps{};
+		VkDeviceSize _nonCoherentAtomSize{ 1 };
+
+		//±Ϊ memoryTypeIndex * 2 + (linear ? 0 : 1)
+		std::vector<std::vector<std::unique_ptr<MemoryBlock>>> _pools{};
+
+		uint32_t _dedicatedCount{ 0 };
+		VkDeviceSize _dedicatedBytes{ 0 };
+
+		std::mutex _mutex;
+	};
+}
@@ -0,0 +1,158 @@
+#include "offscreen_target.h"
+
+namespace FF::Wrapper {
+
+	OffscreenTarget::OffscreenTarget(
+		const Device::Ptr& device,
+		uint32_t width,
+		uint32_t height,
+		uint32_t imageCount,
+		bool readback
+	) {
+		_device = device;
+		_format = chooseFormat(_device);
+		_extent = { width, height };
+		_imageCount = imageCount;
+
+		//뽻ͬŵinitialLayoutΪUNDEFINEDRenderPassʱԶתlayout
+		_colorImages.resize(_imageCount);
+		_multiSampleImages.resize(_imageCount);
+		_depthImages.resize(_imageCount);
+		for (uint32_t i = 0; i < _imageCount; ++i) {
+			_colorImages[i] = Image::create(
+				_device,
+				width, height,
+				_format,
+				VK_IMAGE_TYPE_2D,
+				VK_IMAGE_TILING_OPTIMAL,
+				VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+				VK_SAMPLE_COUNT_1_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+				VK_IMAGE_ASPECT_COLOR_BIT
+			);
+
+			_multiSampleImages[i] = Image::createRenderTargetImage(
+				_device, width, height, _format,
+				_device->getMaxUsableSampleCount()
+			);
+
+			_depthImages[i] = Image::createDepthImage(
+				_device, width, height,
+				_device->getMaxUsableSampleCount()
+			);
+		}
+
+		if (readback) {
+			VkDeviceSize size = static_cast<VkDeviceSize>(width) * height * 4;
+			_readbackBuffer = Buffer::create(
+				_device, size,
+				VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+			);
+		}
+	}
+
+	OffscreenTarget::~OffscreenTarget() {
+		for (auto& frameBuffer : _frameBuffers) {
+			vkDestroyFramebuffer(_device->getDevice(), frameBuffer, nullptr);
+		}
+	}
+
+	void OffscreenTarget::createFrameBuffers(const RenderPass::Ptr& renderPass) {
+		for (auto& frameBuffer : _frameBuffers) {
+			vkDestroyFramebuffer(_device->getDevice(), frameBuffer, nullptr);
+		}
+
+		_frameBuffers.resize(_imageCount);
+		for (uint32_t i = 0; i < _imageCount; ++i) {
+			//˳RenderPassƥ
+			std::array<VkImageView, 3> attachments = {
+				_colorImages[i]->getImageView(),
+				_multiSampleImages[i]->getImageView(),
+				_depthImages[i]->getImageView()
+			};
+			VkFramebufferCreateInfo frameBufferCreateInfo{};
+			frameBufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+			frameBufferCreateInfo.renderPass = renderPass->getRenderPass();
+			frameBufferCreateInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+			frameBufferCreateInfo.pAttachments = attachments.data();
+			frameBufferCreateInfo.width = _extent.width;
+			frameBufferCreateInfo.height = _extent.height;
+			frameBufferCreateInfo.layers = 1;
+
+			if (vkCreateFramebuffer(_device->getDevice(), &frameBufferCreateInfo, nullptr, &_frameBuffers[i]) != VK_SUCCESS) {
+				throw std::runtime_error("Error: failed to create offscreen frame buffer");
+			}
+		}
+	}
+
+	void OffscreenTarget::recordReadback(const CommandBuffer::Ptr& commandBuffer, uint32_t index) {
+		if (!isReadbackEnabled()) {
+			return;
+		}
+
+		//RenderPassTRANSFER_SRCתдĿɼRenderPassⲿ֤
+		commandBuffer->copyImageToBuffer(
+			_colorImages[index]->getImage(),
+			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			_readbackBuffer->getBuffer(),
+			_extent.width, _extent.height
+		);
+		_readbackRecorded = true;
+
+		//CPUɼendһflush
+		commandBuffer->memoryBarrier(
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_HOST_BIT,
+			VK_ACCESS_TRANSFER_WRITE_BIT,
+			VK_ACCESS_HOST_READ_BIT
+		);
+	}
+
+	void OffscreenTarget::readPixels(std::vector<uint8_t>& pixels) const {
+		if (!isReadbackEnabled()) {
+			throw std::runtime_error("Error: offscreen target readback is not enabled");
+		}
+		if (!_readbackRecorded) {
+			throw std::runtime_error("Error: offscreen target has not recorded a readback");
+		}
+
+		size_t size = static_cast<size_t>(_extent.width) * _extent.height * 4;
+		auto data = static_cast<const uint8_t*>(_readbackBuffer->getMappedData());
+		pixels.assign(data, data + size);
+
+		//BGRAʽΪRGBA
+		if (_format == VK_FORMAT_B8G8R8A8_SRGB || _format == VK_FORMAT_B8G8R8A8_UNORM) {
+			for (size_t i = 0; i < size; i += 4) {
+				std::swap(pixels[i], pixels[i + 2]);
+			}
+		}
+	}
+
+	void OffscreenTarget::saveImage(const std::string& path) const {
+		std::vector<uint8_t> pixels{};
+		readPixels(pixels);
+
+		std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file) {
+			throw std::runtime_error("Error: failed to save image " + path);
+		}
+
+		file << "P6\n" << _extent.width << " " << _extent.height << "\n255\n";
+		for (size_t i = 0; i < pixels.size(); i += 4) {
+			file.write(reinterpret_cast<const char*>(&pixels[i]), 3);
+		}
+		if (!file) {
+			throw std::runtime_error("Error: failed to save image " + path);
+		}
+	}
+
+	VkFormat OffscreenTarget::chooseFormat(const Device::Ptr& device) {
+		return Image::findSupportedFormat(
+			device,
+			{ VK_FORMAT_R8G8B8A8_SRGB, VK_FORMAT_B8G8R8A8_SRGB, VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_B8G8R8A8_UNORM },
+			VK_IMAGE_TILING_OPTIMAL,
+			VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_TRANSFER_SRC_BIT
+		);
+	}
+}
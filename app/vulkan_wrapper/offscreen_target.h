@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+#include "render_pass.h"
+#include "image.h"
+#include "buffer.h"
+#include "command_buffer.h"
+
+namespace FF::Wrapper {
+
+	/*
+	* ȾĿ꣬޴ģʽ´潻
+	* 1 ÿһ֡һ鸽ţɫͼƬزͼƬͼƬ˳뽻һ£ʹͬһRenderPass
+	* 2 RenderPassɫͼƬҪTRANSFER_SRC_OPTIMALʱֱӿ
+	* 3 ʱһפӳHostVisible bufferֻҪ֡recordReadbackɫͼƬȥ
+	*   һύִ֮󣬲ͨreadPixels/saveImageȡ
+	*/
+	class OffscreenTarget {
+	public:
+		using Ptr = std::shared_ptr<OffscreenTarget>;
+
+		static Ptr create(
+			const Device::Ptr& device,
+			uint32_t width,
+			uint32_t height,
+			uint32_t imageCount,
+			bool readback = false
+		) {
+			return std::make_shared<OffscreenTarget>(device, width, height, imageCount, readback);
+		}
+
+		OffscreenTarget(
+			const Device::Ptr& device,
+			uint32_t width,
+			uint32_t height,
+			uint32_t imageCount,
+			bool readback = false
+		);
+
+		~OffscreenTarget();
+
+		void createFrameBuffers(const RenderPass::Ptr& renderPass);
+
+		//RenderPass֮¼ƣindexӦɫͼƬbuffer֮ǰصĽ
+		void recordReadback(const CommandBuffer::Ptr& commandBuffer, uint32_t index);
+
+		//дϵµRGBAأÿ4ֽ
+		void readPixels(std::vector<uint8_t>& pixels) const;
+
+		//ΪPPM(P6)
+		void saveImage(const std::string& path) const;
+
+		//ѡRGBA˳ͬʱ֧Ϊɫ뿽ԴsRGBʽ
+		static VkFormat chooseFormat(const Device::Ptr& device);
+
+	public:
+
+		[[nodiscard]] VkFormat getFormat() const { return _format; }
+
+		[[nodiscard]] uint32_t getImageCount() const { return _imageCount; }
+
+		[[nodiscard]] VkFramebuffer getFrameBuffer(uint32_t index) const { return _frameBuffers[index]; }
+
+		[[nodiscard]] VkExtent2D getExtent() const { return _extent; }
+
+		[[nodiscard]] Image::Ptr getColorImage(uint32_t index) const { return _colorImages[index]; }
+
+		[[nodiscard]] bool isReadbackEnabled() const { return _readbackBuffer != nullptr; }
+
+		//Ƿ¼ƹrecordReadback
+		[[nodiscard]] bool hasReadback() const { return _readbackRecorded; }
+
+	private:
+		VkFormat _format{ VK_FORMAT_UNDEFINED };
+		VkExtent2D _extent{ 0, 0 };
+		uint32_t _imageCount{ 0 };
+
+		std::vector<Image::Ptr> _colorImages{};
+		std::vector<Image::Ptr> _multiSampleImages{};
+		std::vector<Image::Ptr> _depthImages{};
+		std::vector<VkFramebuffer> _frameBuffers{};
+
+		Buffer::Ptr _readbackBuffer{ nullptr };
+		bool _readbackRecorded{ false };
+
+		Device::Ptr _device{ nullptr };
+	};
+}
@@ -1,9 +1,10 @@
 #include "pipeline.h"
 
 namespace FF::Wrapper {
-	Pipeline::Pipeline(const Device::Ptr& device, const RenderPass::Ptr& renderPass) {
+	Pipeline::Pipeline(const Device::Ptr& device, const RenderPass::Ptr& renderPass, const PipelineCache::Ptr& pipelineCache) {
 		_device = device;
 		_renderPass = renderPass;
+		_pipelineCache = pipelineCache;
 		mVertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 		mAssemblyState.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
 		mViewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
@@ -12,6 +13,7 @@ namespace FF::Wrapper {
 		mBlendState.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
 		mDepthStencilState.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
 		mLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		mDynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
 	}
 
 	Pipeline::~Pipeline() {
@@ -28,6 +30,35 @@ namespace FF::Wrapper {
 		_shaders = shaderGroup;
 	}
 
+	void Pipeline::setVertexInput(
+		const std::vector<VkVertexInputBindingDescription>& bindings,
+		const std::vector<VkVertexInputAttributeDescription>& attributes
+	) {
+		_vertexBindings = bindings;
+		_vertexAttributes = attributes;
+		mVertexInputState.vertexBindingDescriptionCount = static_cast<uint32_t>(_vertexBindings.size());
+		mVertexInputState.pVertexBindingDescriptions = _vertexBindings.data();
+		mVertexInputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(_vertexAttributes.size());
+		mVertexInputState.pVertexAttributeDescriptions = _vertexAttributes.data();
+	}
+
+	void Pipeline::setDescriptorSetLayouts(const std::vector<VkDescriptorSetLayout>& setLayouts, const std::vector<std::vector<uint8_t>>& setLayoutKeys) {
+		if (setLayouts.size() != setLayoutKeys.size()) {
+			throw std::runtime_error("Error: every descriptor set layout needs a layout key");
+		}
+
+		_setLayouts = setLayouts;
+		_setLayoutKeys = setLayoutKeys;
+		mLayoutCreateInfo.setLayoutCount = static_cast<uint32_t>(_setLayouts.size());
+		mLayoutCreateInfo.pSetLayouts = _setLayouts.data();
+	}
+
+	void Pipeline::setPushConstantRanges(const std::vector<VkPushConstantRange>& pushConstantRanges) {
+		_pushConstantRanges = pushConstantRanges;
+		mLayoutCreateInfo.pushConstantRangeCount = static_cast<uint32_t>(_pushConstantRanges.size());
+		mLayoutCreateInfo.pPushConstantRanges = _pushConstantRanges.empty() ? nullptr : _pushConstantRanges.data();
+	}
+
 	void Pipeline::build() {
 
 		//shaders
@@ -41,11 +72,17 @@ namespace FF::Wrapper {
 			shaderCreateInfos.push_back(shaderCreateInfo);
 		}
 
-		//ӿڼ
-		mViewportState.viewportCount = static_cast<uint32_t>(_viewports.size());
-		mViewportState.pViewports = _viewports.data();
-		mViewportState.scissorCount = static_cast<uint32_t>(_scissors.size());
-		mViewportState.pScissors = _scissors.data();
+		//ӿڼã̬ӿڼֻҪ¼ʱ
+		bool dynamicViewport = isDynamicState(VK_DYNAMIC_STATE_VIEWPORT);
+		bool dynamicScissor = isDynamicState(VK_DYNAMIC_STATE_SCISSOR);
+		mViewportState.viewportCount = (dynamicViewport && _viewports.empty()) ? 1 : static_cast<uint32_t>(_viewports.size());
+		mViewportState.pViewports = dynamicViewport ? nullptr : _viewports.data();
+		mViewportState.scissorCount = (dynamicScissor && _scissors.empty()) ? 1 : static_cast<uint32_t>(_scissors.size());
+		mViewportState.pScissors = dynamicScissor ? nullptr : _scissors.data();
+
+		//̬״̬
+		mDynamicState.dynamicStateCount = static_cast<uint32_t>(_dynamicStates.size());
+		mDynamicState.pDynamicStates = _dynamicStates.data();
 
 		//blending
 		mBlendState.attachmentCount = static_cast<uint32_t>(_blendAttachmentStates.size());
@@ -71,6 +108,7 @@ namespace FF::Wrapper {
 		pipelineCreateInfo.pMultisampleState = &mSampleState;
 		pipelineCreateInfo.pDepthStencilState = &mDepthStencilState;
 		pipelineCreateInfo.pColorBlendState = &mBlendState;
+		pipelineCreateInfo.pDynamicState = _dynamicStates.empty() ? nullptr : &mDynamicState;
 		pipelineCreateInfo.layout = _layout;
 		pipelineCreateInfo.renderPass = _renderPass->getRenderPass();
 		pipelineCreateInfo.subpass = 0;
@@ -85,7 +123,8 @@ namespace FF::Wrapper {
 		}
 
 		//pipeline cacheԽϢ뻺棬ڶpipelineʹãҲԴ浽ļͬ
-		if (vkCreateGraphicsPipelines(_device->getDevice(), VK_NULL_HANDLE, 1,&pipelineCreateInfo, nullptr, &_pipeline) != VK_SUCCESS) {
+		VkPipelineCache pipelineCache = _pipelineCache ? _pipelineCache->getPipelineCache() : VK_NULL_HANDLE;
+		if (vkCreateGraphicsPipelines(_device->getDevice(), pipelineCache, 1,&pipelineCreateInfo, nullptr, &_pipeline) != VK_SUCCESS) {
 			throw std::runtime_error("Error: failed to create pipeline");
 		}
 	}
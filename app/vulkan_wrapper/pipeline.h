@@ -4,16 +4,22 @@
 #include "device.h"
 #include "shader.h"
 #include "render_pass.h"
+#include "pipeline_cache.h"
+#include <algorithm>
 
 namespace FF::Wrapper {
 	class Pipeline {
 	public:
 		using Ptr = std::shared_ptr<Pipeline>;
-		static Ptr create(const Device::Ptr& device, const RenderPass::Ptr& renderPass) {
-			return std::make_shared<Pipeline>(device, renderPass);
+		static Ptr create(
+			const Device::Ptr& device, 
+			const RenderPass::Ptr& renderPass, 
+			const PipelineCache::Ptr& pipelineCache = nullptr
+		) {
+			return std::make_shared<Pipeline>(device, renderPass, pipelineCache);
 		}
 
-		Pipeline(const Device::Ptr& device, const RenderPass::Ptr& renderPass);
+		Pipeline(const Device::Ptr& device, const RenderPass::Ptr& renderPass, const PipelineCache::Ptr& pipelineCache = nullptr);
 
 		~Pipeline();
 
@@ -27,6 +33,28 @@ namespace FF::Wrapper {
 			_blendAttachmentStates.push_back(blendAttachment);
 		}
 
+		//PipelineԼ棬create infoеָָ뿪ĺ߳build
+		void setVertexInput(
+			const std::vector<VkVertexInputBindingDescription>& bindings,
+			const std::vector<VkVertexInputAttributeDescription>& attributes
+		);
+
+		//setLayoutKeysΪÿlayout(DescriptorSetLayout/BindlessTablegetLayoutKey)PipelineRegistryȽ
+		void setDescriptorSetLayouts(const std::vector<VkDescriptorSetLayout>& setLayouts, const std::vector<std::vector<uint8_t>>& setLayoutKeys);
+
+		void setPushConstantRanges(const std::vector<VkPushConstantRange>& pushConstantRanges);
+
+		/*
+		* ̬״̬¼ʱͨCommandBufferãٹ̻pipeline
+		* viewport/scissorΪ̬ʱsetViewports/setScissorsֻҪʱĬϸһ
+		* ڴС仯ʱpipeline˲Ҫؽ
+		*/
+		void setDynamicStates(const std::vector<VkDynamicState>& dynamicStates) { _dynamicStates = dynamicStates; }
+
+		[[nodiscard]] bool isDynamicState(VkDynamicState state) const {
+			return std::find(_dynamicStates.begin(), _dynamicStates.end(), state) != _dynamicStates.end();
+		}
+
 		void build();
 
 	public:
@@ -35,6 +63,20 @@ namespace FF::Wrapper {
 
 		[[nodiscard]] VkPipelineLayout getPipelineLayout() const { return _layout; }
 
+		[[nodiscard]] const std::vector<Shader::Ptr>& getShaderGroup() const { return _shaders; }
+
+		[[nodiscard]] const std::vector<VkViewport>& getViewports() const { return _viewports; }
+
+		[[nodiscard]] const std::vector<VkRect2D>& getScissors() const { return _scissors; }
+
+		[[nodiscard]] const std::vector<VkPipelineColorBlendAttachmentState>& getBlendAttachments() const { return _blendAttachmentStates; }
+
+		[[nodiscard]] RenderPass::Ptr getRenderPass() const { return _renderPass; }
+
+		[[nodiscard]] const std::vector<VkDynamicState>& getDynamicStates() const { return _dynamicStates; }
+
+		[[nodiscard]] const std::vector<std::vector<uint8_t>>& getSetLayoutKeys() const { return _setLayoutKeys; }
+
 	public:
 		VkPipelineVertexInputStateCreateInfo mVertexInputState{};
 		VkPipelineInputAssemblyStateCreateInfo mAssemblyState{};
@@ -44,15 +86,23 @@ namespace FF::Wrapper {
 		VkPipelineColorBlendStateCreateInfo mBlendState{};
 		VkPipelineDepthStencilStateCreateInfo mDepthStencilState{};
 		VkPipelineLayoutCreateInfo mLayoutCreateInfo{};
+		VkPipelineDynamicStateCreateInfo mDynamicState{};
 
 	private:
 		VkPipeline _pipeline{ VK_NULL_HANDLE };
 		VkPipelineLayout _layout{ VK_NULL_HANDLE };
 		Device::Ptr _device{ nullptr };
 		RenderPass::Ptr _renderPass{ nullptr };
+		PipelineCache::Ptr _pipelineCache{ nullptr };
 		std::vector<Shader::Ptr> _shaders{};
 		std::vector<VkViewport> _viewports{};
 		std::vector<VkRect2D> _scissors{};
 		std::vector<VkPipelineColorBlendAttachmentState> _blendAttachmentStates{};
+		std::vector<VkVertexInputBindingDescription> _vertexBindings{};
+		std::vector<VkVertexInputAttributeDescription> _vertexAttributes{};
+		std::vector<VkDescriptorSetLayout> _setLayouts{};
+		std::vector<std::vector<uint8_t>> _setLayoutKeys{};
+		std::vector<VkPushConstantRange> _pushConstantRanges{};
+		std::vector<VkDynamicState> _dynamicStates{};
 	};
 }
\ No newline at end of file
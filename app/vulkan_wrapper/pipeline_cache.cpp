@@ -0,0 +1,102 @@
+#include "pipeline_cache.h"
+#include <cstring>
+#include <filesystem>
+
+namespace FF::Wrapper {
+
+	PipelineCache::PipelineCache(const Device::Ptr& device, const std::string& path) {
+		_device = device;
+		_path = path;
+
+		std::vector<char> data = loadData();
+		_loadedFromDisk = !data.empty();
+
+		VkPipelineCacheCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		createInfo.initialDataSize = data.size();
+		createInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+		if (vkCreatePipelineCache(_device->getDevice(), &createInfo, nullptr, &_pipelineCache) != VK_SUCCESS) {
+			throw std::runtime_error("Error: failed to create pipeline cache");
+		}
+	}
+
+	PipelineCache::~PipelineCache() {
+		if (_pipelineCache != VK_NULL_HANDLE) {
+			vkDestroyPipelineCache(_device->getDevice(), _pipelineCache, nullptr);
+		}
+	}
+
+	std::vector<char> PipelineCache::loadData() {
+		std::ifstream file(_path.c_str(), std::ios::ate | std::ios::binary | std::ios::in);
+
+		//һûļǴ
+		if (!file) {
+			return {};
+		}
+
+		const size_t fileSize = file.tellg();
+		std::vector<char> data(fileSize);
+		file.seekg(0);
+		file.read(data.data(), fileSize);
+		file.close();
+
+		//cacheʱؽheader豸仯һֱӶ˳ʱᱻ
+		if (!isHeaderValid(data) || !isDeviceMatched(data)) {
+			return {};
+		}
+
+		return data;
+	}
+
+	bool PipelineCache::isHeaderValid(const std::vector<char>& data) const {
+		VkPipelineCacheHeaderVersionOne header{};
+		if (data.size() < sizeof(header)) {
+			return false;
+		}
+		memcpy(&header, data.data(), sizeof(header));
+
+		return header.headerSize >= sizeof(header) &&
+			header.headerSize <= data.size() &&
+			header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE;
+	}
+
+	bool PipelineCache::isDeviceMatched(const std::vector<char>& data) const {
+		VkPipelineCacheHeaderVersionOne header{};
+		memcpy(&header, data.data(), sizeof(header));
+
+		VkPhysicalDeviceProperties props;
+		vkGetPhysicalDeviceProperties(_device->getPhysicalDevice(), &props);
+
+		return header.vendorID == props.vendorID &&
+			header.deviceID == props.deviceID &&
+			memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+	}
+
+	void PipelineCache::save() {
+		size_t dataSize = 0;
+		if (vkGetPipelineCacheData(_device->getDevice(), _pipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0) {
+			return;
+		}
+
+		std::vector<char> data(dataSize);
+		if (vkGetPipelineCacheData(_device->getDevice(), _pipelineCache, &dataSize, data.data()) != VK_SUCCESS) {
+			throw std::runtime_error("Error: failed to get pipeline cache data");
+		}
+
+		std::string tempPath = _path + ".tmp";
+		std::ofstream file(tempPath.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+		if (!file) {
+			throw std::runtime_error("Error: failed to open pipeline cache file");
+		}
+		file.write(data.data(), static_cast<std::streamsize>(dataSize));
+		file.close();
+
+		//filesystem::renameֱӸеļ(WindowsΪMoveFileEx + REPLACE_EXISTING)ھļɾļûм״̬
+		std::error_code error{};
+		std::filesystem::rename(tempPath, _path, error);
+		if (error) {
+			throw std::runtime_error("Error: failed to save pipeline cache file " + _path + ": " + error.message());
+		}
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+
+namespace FF::Wrapper {
+
+	/*
+	* ־û̵VkPipelineCache
+	* 1 ʱȡһαݣheader(ļضϵ)headerеvendorID/deviceID/pipelineCacheUUID
+	*   뵱ǰ豸һ(Կ)ʱӿյcacheʼ˳ʱsaveǾļ
+	* 2 Pipelineһcacheؽʱ´pipelineֱУ±shader
+	* 3 ˳ʱsaveдش̣дʱļԭӵ滻;˳𻵻ȱʧļ
+	*/
+	class PipelineCache {
+	public:
+		static constexpr const char* DEFAULT_CACHE_PATH = "pipeline_cache.bin";
+
+		using Ptr = std::shared_ptr<PipelineCache>;
+		static Ptr create(const Device::Ptr& device, const std::string& path = DEFAULT_CACHE_PATH) {
+			return std::make_shared<PipelineCache>(device, path);
+		}
+
+		PipelineCache(const Device::Ptr& device, const std::string& path = DEFAULT_CACHE_PATH);
+
+		~PipelineCache();
+
+		void save();
+
+		[[nodiscard]] VkPipelineCache getPipelineCache() const { return _pipelineCache; }
+
+		//ʱǷɹȡ˴ϵ
+		[[nodiscard]] bool isLoadedFromDisk() const { return _loadedFromDisk; }
+
+	private:
+		std::vector<char> loadData();
+
+		//headerĴС汾Ƿȷ
+		bool isHeaderValid(const std::vector<char>& data) const;
+
+		//headerе豸ϢǷ뵱ǰ豸һ£ǰheaderЧ
+		bool isDeviceMatched(const std::vector<char>& data) const;
+
+	private:
+		VkPipelineCache _pipelineCache{ VK_NULL_HANDLE };
+		Device::Ptr _device{ nullptr };
+		std::string _path{};
+		bool _loadedFromDisk{ false };
+	};
+}
@@ -0,0 +1,91 @@
+#include "pipeline_compiler.h"
+
+namespace FF::Wrapper {
+
+	PipelineCompiler::PipelineCompiler(const PipelineRegistry::Ptr& registry, const ThreadPool::Ptr& threadPool) {
+		_registry = registry;
+		_threadPool = threadPool;
+	}
+
+	PipelineCompiler::~PipelineCompiler() {
+		//߳лbuilddeviceȴǽ
+		waitAll();
+	}
+
+	PipelineHandle::Ptr PipelineCompiler::compile(const Pipeline::Ptr& pipeline, const Pipeline::Ptr& fallback) {
+		auto key = PipelineRegistry::computeStateKey(pipeline);
+
+		auto existing = _registry->findPipeline(key);
+		if (existing) {
+			std::promise<Pipeline::Ptr> promise;
+			promise.set_value(existing);
+			auto handle = PipelineHandle::create(existing, promise.get_future().share());
+			handle->setPipeline(existing);
+			return handle;
+		}
+
+		for (const auto& compile : _pendingCompiles) {
+			if (compile.mKey == key) {
+				return compile.mHandle;
+			}
+		}
+
+		std::shared_future<Pipeline::Ptr> future = _threadPool->submit([pipeline]() {
+			pipeline->build();
+			return pipeline;
+		}).share();
+
+		PendingCompile compile;
+		compile.mKey = std::move(key);
+		compile.mHandle = PipelineHandle::create(fallback, future);
+		_pendingCompiles.push_back(compile);
+
+		return compile.mHandle;
+	}
+
+	std::vector<PipelineHandle::Ptr> PipelineCompiler::compileBatch(
+		const std::vector<Pipeline::Ptr>& pipelines, 
+		const Pipeline::Ptr& fallback
+	) {
+		std::vector<PipelineHandle::Ptr> handles{};
+		for (const auto& pipeline : pipelines) {
+			handles.push_back(compile(pipeline, fallback));
+		}
+		return handles;
+	}
+
+	void PipelineCompiler::update() {
+		for (auto iter = _pendingCompiles.begin(); iter != _pendingCompiles.end();) {
+			if (iter->mHandle->getFuture().wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+				++iter;
+				continue;
+			}
+
+			finishCompile(*iter);
+			iter = _pendingCompiles.erase(iter);
+		}
+	}
+
+	void PipelineCompiler::waitAll() {
+		for (auto& compile : _pendingCompiles) {
+			finishCompile(compile);
+		}
+		_pendingCompiles.clear();
+	}
+
+	void PipelineCompiler::finishCompile(PendingCompile& compile) {
+		Pipeline::Ptr pipeline{ nullptr };
+		try {
+			pipeline = compile.mHandle->getFuture().get();
+		}
+		catch (const std::exception& e) {
+			//ʧʱfallback
+			compile.mHandle->_failed = true;
+			compile.mHandle->_error = e.what();
+			return;
+		}
+
+		_registry->addPipeline(compile.mKey, pipeline);
+		compile.mHandle->setPipeline(pipeline);
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "../base.h"
+#include "../thread_pool.h"
+#include "pipeline.h"
+#include "pipeline_registry.h"
+
+namespace FF::Wrapper {
+
+	/*
+	* 첽Pipeline
+	* ֮ǰgetPipelinefallback(Ϊ)ɺPipelineCompiler::updateлΪpipeline
+	* ֻ߳ждgetFuture̵߳ȴ
+	*/
+	class PipelineHandle {
+	public:
+		using Ptr = std::shared_ptr<PipelineHandle>;
+
+		static Ptr create(const Pipeline::Ptr& fallback, const std::shared_future<Pipeline::Ptr>& future) {
+			return std::make_shared<PipelineHandle>(fallback, future);
+		}
+
+		PipelineHandle(const Pipeline::Ptr& fallback, const std::shared_future<Pipeline::Ptr>& future) 
+			: _pipeline(fallback), _future(future) {}
+
+		~PipelineHandle() = default;
+
+		[[nodiscard]] Pipeline::Ptr getPipeline() const { return _pipeline; }
+
+		[[nodiscard]] bool isReady() const { return _ready; }
+
+		//ʧʱһֱʹfallback
+		[[nodiscard]] bool isFailed() const { return _failed; }
+
+		//ʧʱbuild׳쳣Ϣ
+		[[nodiscard]] const std::string& getError() const { return _error; }
+
+		[[nodiscard]] const std::shared_future<Pipeline::Ptr>& getFuture() const { return _future; }
+
+	private:
+		friend class PipelineCompiler;
+
+		void setPipeline(const Pipeline::Ptr& pipeline) {
+			_pipeline = pipeline;
+			_ready = true;
+		}
+
+	private:
+		Pipeline::Ptr _pipeline{ nullptr };
+		std::shared_future<Pipeline::Ptr> _future{};
+		bool _ready{ false };
+		bool _failed{ false };
+		std::string _error{};
+	};
+
+	/*
+	* ̳߳вбPipeline
+	* 1 compile߳м״̬keyעеֱӷؾľڱͬ״̬ͬһ
+	* 2 ύ̳߳buildvkCreateGraphicsPipelinesPipelineCacheԶ߳ͬʱ
+	* 3 ύ֮ͽ˹̣֮߳ǰ̲߳޸еҪͨPipelineset
+	* 4 update߳ÿ֡ãѱɵpipelineǼǵעл
+	* 5 ʧܲ׳ΪʧܲϢʹ߾ʹfallback׳
+	*/
+	class PipelineCompiler {
+	public:
+		using Ptr = std::shared_ptr<PipelineCompiler>;
+		static Ptr create(const PipelineRegistry::Ptr& registry, const ThreadPool::Ptr& threadPool) {
+			return std::make_shared<PipelineCompiler>(registry, threadPool);
+		}
+
+		PipelineCompiler(const PipelineRegistry::Ptr& registry, const ThreadPool::Ptr& threadPool);
+
+		~PipelineCompiler();
+
+		PipelineHandle::Ptr compile(const Pipeline::Ptr& pipeline, const Pipeline::Ptr& fallback = nullptr);
+
+		//һͬʱύصľdescriptionsһһӦ
+		std::vector<PipelineHandle::Ptr> compileBatch(
+			const std::vector<Pipeline::Ptr>& pipelines, 
+			const Pipeline::Ptr& fallback = nullptr
+		);
+
+		//߳ÿ֡
+		void update();
+
+		//ֱѾύpipelineϲл
+		void waitAll();
+
+		[[nodiscard]] bool hasPendingCompiles() const { return !_pendingCompiles.empty(); }
+
+	private:
+		struct PendingCompile {
+			std::vector<uint8_t> mKey{};
+			PipelineHandle::Ptr mHandle{ nullptr };
+		};
+
+		void finishCompile(PendingCompile& compile);
+
+	private:
+		PipelineRegistry::Ptr _registry{ nullptr };
+		ThreadPool::Ptr _threadPool{ nullptr };
+		std::vector<PendingCompile> _pendingCompiles{};
+	};
+}
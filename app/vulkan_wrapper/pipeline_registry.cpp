@@ -0,0 +1,194 @@
+#include "pipeline_registry.h"
+
+namespace FF::Wrapper {
+
+	PipelineRegistry::PipelineRegistry(const Device::Ptr& device) {
+		_device = device;
+	}
+
+	PipelineRegistry::~PipelineRegistry() {
+		_pipelines.clear();
+	}
+
+	size_t PipelineRegistry::KeyHash::operator()(const std::vector<uint8_t>& key) const {
+		return static_cast<size_t>(StateKeyWriter::hash(key));
+	}
+
+	std::vector<uint8_t> PipelineRegistry::computeStateKey(const Pipeline::Ptr& pipeline) {
+		StateKeyWriter writer;
+
+		//shaders
+		writer.write(pipeline->getShaderGroup().size());
+		for (const auto& shader : pipeline->getShaderGroup()) {
+			writer.write(shader->getCode());
+			writer.write(shader->getShaderStage());
+			writer.write(shader->getShaderEntryPoint());
+		}
+
+		//Ų
+		const auto& vertexInput = pipeline->mVertexInputState;
+		writer.write(vertexInput.vertexBindingDescriptionCount);
+		for (uint32_t i = 0; i < vertexInput.vertexBindingDescriptionCount; ++i) {
+			const auto& binding = vertexInput.pVertexBindingDescriptions[i];
+			writer.write(binding.binding);
+			writer.write(binding.stride);
+			writer.write(binding.inputRate);
+		}
+		writer.write(vertexInput.vertexAttributeDescriptionCount);
+		for (uint32_t i = 0; i < vertexInput.vertexAttributeDescriptionCount; ++i) {
+			const auto& attribute = vertexInput.pVertexAttributeDescriptions[i];
+			writer.write(attribute.location);
+			writer.write(attribute.binding);
+			writer.write(attribute.format);
+			writer.write(attribute.offset);
+		}
+
+		//ͼԪװ
+		writer.write(pipeline->mAssemblyState.topology);
+		writer.write(pipeline->mAssemblyState.primitiveRestartEnable);
+
+		//̬״̬
+		writer.write(pipeline->getDynamicStates().size());
+		for (auto state : pipeline->getDynamicStates()) {
+			writer.write(state);
+		}
+
+		//ӿڼã̬ʱֻȽϣڴСͬԹһpipeline
+		bool dynamicViewport = pipeline->isDynamicState(VK_DYNAMIC_STATE_VIEWPORT);
+		bool dynamicScissor = pipeline->isDynamicState(VK_DYNAMIC_STATE_SCISSOR);
+		writer.write(pipeline->getViewports().size());
+		for (const auto& viewport : pipeline->getViewports()) {
+			if (dynamicViewport) {
+				break;
+			}
+			writer.write(viewport.x);
+			writer.write(viewport.y);
+			writer.write(viewport.width);
+			writer.write(viewport.height);
+			writer.write(viewport.minDepth);
+			writer.write(viewport.maxDepth);
+		}
+		writer.write(pipeline->getScissors().size());
+		for (const auto& scissor : pipeline->getScissors()) {
+			if (dynamicScissor) {
+				break;
+			}
+			writer.write(scissor.offset.x);
+			writer.write(scissor.offset.y);
+			writer.write(scissor.extent.width);
+			writer.write(scissor.extent.height);
+		}
+
+		//դ
+		const auto& raster = pipeline->mRasterState;
+		writer.write(raster.depthClampEnable);
+		writer.write(raster.rasterizerDiscardEnable);
+		writer.write(raster.polygonMode);
+		writer.write(raster.cullMode);
+		writer.write(raster.frontFace);
+		writer.write(raster.depthBiasEnable);
+		writer.write(raster.depthBiasConstantFactor);
+		writer.write(raster.depthBiasClamp);
+		writer.write(raster.depthBiasSlopeFactor);
+		writer.write(raster.lineWidth);
+
+		//ز
+		const auto& sample = pipeline->mSampleState;
+		writer.write(sample.rasterizationSamples);
+		writer.write(sample.sampleShadingEnable);
+		writer.write(sample.minSampleShading);
+		writer.write(sample.alphaToCoverageEnable);
+		writer.write(sample.alphaToOneEnable);
+		writer.write(sample.pSampleMask != nullptr);
+		if (sample.pSampleMask != nullptr) {
+			for (uint32_t i = 0; i < (static_cast<uint32_t>(sample.rasterizationSamples) + 31) / 32; ++i) {
+				writer.write(sample.pSampleMask[i]);
+			}
+		}
+
+		//ģ
+		const auto& depthStencil = pipeline->mDepthStencilState;
+		writer.write(depthStencil.depthTestEnable);
+		writer.write(depthStencil.depthWriteEnable);
+		writer.write(depthStencil.depthCompareOp);
+		writer.write(depthStencil.depthBoundsTestEnable);
+		writer.write(depthStencil.stencilTestEnable);
+		writer.write(depthStencil.front);
+		writer.write(depthStencil.back);
+		writer.write(depthStencil.minDepthBounds);
+		writer.write(depthStencil.maxDepthBounds);
+
+		//
+		const auto& blend = pipeline->mBlendState;
+		writer.write(blend.logicOpEnable);
+		writer.write(blend.logicOp);
+		for (float constant : blend.blendConstants) {
+			writer.write(constant);
+		}
+		writer.write(pipeline->getBlendAttachments().size());
+		for (const auto& attachment : pipeline->getBlendAttachments()) {
+			writer.write(attachment.blendEnable);
+			writer.write(attachment.srcColorBlendFactor);
+			writer.write(attachment.dstColorBlendFactor);
+			writer.write(attachment.colorBlendOp);
+			writer.write(attachment.srcAlphaBlendFactor);
+			writer.write(attachment.dstAlphaBlendFactor);
+			writer.write(attachment.alphaBlendOp);
+			writer.write(attachment.colorWriteMask);
+		}
+
+		//pipeline layout
+		const auto& layout = pipeline->mLayoutCreateInfo;
+		writer.write(pipeline->getSetLayoutKeys().size());
+		for (const auto& setLayoutKey : pipeline->getSetLayoutKeys()) {
+			writer.write(setLayoutKey);
+		}
+		writer.write(layout.pushConstantRangeCount);
+		for (uint32_t i = 0; i < layout.pushConstantRangeCount; ++i) {
+			writer.write(layout.pPushConstantRanges[i].stageFlags);
+			writer.write(layout.pPushConstantRanges[i].offset);
+			writer.write(layout.pPushConstantRanges[i].size);
+		}
+
+		//render passݣݵrender passԹpipelineloadOp/storeOp/layoutӰ
+		writer.write(pipeline->getRenderPass()->getCompatibilityKey());
+
+		return writer.getBytes();
+	}
+
+	Pipeline::Ptr PipelineRegistry::getPipeline(const Pipeline::Ptr& pipeline) {
+		auto key = computeStateKey(pipeline);
+
+		auto existing = findPipeline(key);
+		if (existing) {
+			return existing;
+		}
+
+		pipeline->build();
+		addPipeline(key, pipeline);
+		return pipeline;
+	}
+
+	Pipeline::Ptr PipelineRegistry::findPipeline(const std::vector<uint8_t>& key) const {
+		auto iter = _pipelines.find(key);
+		if (iter == _pipelines.end()) {
+			return nullptr;
+		}
+		return iter->second;
+	}
+
+	void PipelineRegistry::addPipeline(const std::vector<uint8_t>& key, const Pipeline::Ptr& pipeline) {
+		_pipelines[key] = pipeline;
+	}
+
+	void PipelineRegistry::purgeUnused() {
+		for (auto iter = _pipelines.begin(); iter != _pipelines.end();) {
+			if (iter->second.use_count() == 1) {
+				iter = _pipelines.erase(iter);
+			}
+			else {
+				++iter;
+			}
+		}
+	}
+}
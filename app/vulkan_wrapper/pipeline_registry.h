@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+#include "pipeline.h"
+#include "pipeline_state_key.h"
+#include <unordered_map>
+
+namespace FF::Wrapper {
+
+	/*
+	* Ĺ״̬ȥصPipelineע
+	* 1 ״̬shader(SPIR-V/stage/)ŲͼԪװ䡢̬״̬ӿڼ(̬ʱֻ)դزģ塢ϡ
+	*   pipeline layout(set layoutpush constant)Լrender passļϢ(šsubpassĸdependency)
+	* 2 ״̬ȫͬ󷵻ѾbuildõPipelineͬĲʿԹһVkPipeline¼ʱҲֻҪһ
+	* 3 ״̬StateKeyWriterֶдֽΪkeyָ롢ṹеֽ
+	*/
+	class PipelineRegistry {
+	public:
+		using Ptr = std::shared_ptr<PipelineRegistry>;
+		static Ptr create(const Device::Ptr& device) { return std::make_shared<PipelineRegistry>(device); }
+
+		PipelineRegistry(const Device::Ptr& device);
+
+		~PipelineRegistry();
+
+		//pipelineΪѾú״̬ûbuildʱеPipelinebuildǼ
+		Pipeline::Ptr getPipeline(const Pipeline::Ptr& pipeline);
+
+		[[nodiscard]] Pipeline::Ptr findPipeline(const std::vector<uint8_t>& key) const;
+
+		//pipelineҪѾbuild
+		void addPipeline(const std::vector<uint8_t>& key, const Pipeline::Ptr& pipeline);
+
+		//ƳֻעõPipelineǰҪ֤ûбGPUʹ
+		void purgeUnused();
+
+		[[nodiscard]] size_t getPipelineCount() const { return _pipelines.size(); }
+
+		[[nodiscard]] static std::vector<uint8_t> computeStateKey(const Pipeline::Ptr& pipeline);
+
+	private:
+		struct KeyHash {
+			size_t operator()(const std::vector<uint8_t>& key) const;
+		};
+
+	private:
+		Device::Ptr _device{ nullptr };
+		std::unordered_map<std::vector<uint8_t>, Pipeline::Ptr, KeyHash> _pipelines{};
+	};
+}
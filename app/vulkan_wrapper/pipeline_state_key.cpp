@@ -0,0 +1,123 @@
+#include "pipeline_state_key.h"
+#include <stdexcept>
+
+namespace FF::Wrapper {
+
+	void StateKeyWriter::write(const std::string& value) {
+		write(value.size());
+		_bytes.insert(_bytes.end(), value.begin(), value.end());
+	}
+
+	void StateKeyWriter::write(const std::vector<uint8_t>& bytes) {
+		write(bytes.size());
+		_bytes.insert(_bytes.end(), bytes.begin(), bytes.end());
+	}
+
+	void StateKeyWriter::write(const VkStencilOpState& state) {
+		write(state.failOp);
+		write(state.passOp);
+		write(state.depthFailOp);
+		write(state.compareOp);
+		write(state.compareMask);
+		write(state.writeMask);
+		write(state.reference);
+	}
+
+	void StateKeyWriter::writeSetLayout(const VkDescriptorSetLayoutCreateInfo& createInfo) {
+		const VkDescriptorSetLayoutBindingFlagsCreateInfo* bindingFlags = nullptr;
+		for (auto next = static_cast<const VkBaseInStructure*>(createInfo.pNext); next != nullptr; next = next->pNext) {
+			if (next->sType == VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO) {
+				bindingFlags = reinterpret_cast<const VkDescriptorSetLayoutBindingFlagsCreateInfo*>(next);
+			}
+		}
+
+		write(createInfo.flags);
+		write(createInfo.bindingCount);
+		for (uint32_t i = 0; i < createInfo.bindingCount; ++i) {
+			const auto& binding = createInfo.pBindings[i];
+			if (binding.pImmutableSamplers != nullptr) {
+				throw std::runtime_error("Error: immutable samplers are not supported by the pipeline state key");
+			}
+
+			write(binding.binding);
+			write(binding.descriptorType);
+			write(binding.descriptorCount);
+			write(binding.stageFlags);
+
+			VkDescriptorBindingFlags flags = 0;
+			if (bindingFlags != nullptr && i < bindingFlags->bindingCount) {
+				flags = bindingFlags->pBindingFlags[i];
+			}
+			write(flags);
+		}
+	}
+
+	void StateKeyWriter::writeAttachmentReferences(const VkAttachmentReference* references, uint32_t count, const VkRenderPassCreateInfo& createInfo) {
+		for (uint32_t i = 0; i < count; ++i) {
+			uint32_t attachment = references == nullptr ? VK_ATTACHMENT_UNUSED : references[i].attachment;
+			if (attachment == VK_ATTACHMENT_UNUSED || attachment >= createInfo.attachmentCount) {
+				write(false);
+				continue;
+			}
+
+			write(true);
+			write(createInfo.pAttachments[attachment].format);
+			write(createInfo.pAttachments[attachment].samples);
+		}
+	}
+
+	void StateKeyWriter::writeRenderPass(const VkRenderPassCreateInfo& createInfo) {
+		write(createInfo.flags);
+
+		write(createInfo.attachmentCount);
+		for (uint32_t i = 0; i < createInfo.attachmentCount; ++i) {
+			const auto& attachment = createInfo.pAttachments[i];
+			write(attachment.flags);
+			write(attachment.format);
+			write(attachment.samples);
+		}
+
+		write(createInfo.subpassCount);
+		for (uint32_t i = 0; i < createInfo.subpassCount; ++i) {
+			const auto& subpass = createInfo.pSubpasses[i];
+			write(subpass.flags);
+			write(subpass.pipelineBindPoint);
+
+			write(subpass.inputAttachmentCount);
+			writeAttachmentReferences(subpass.pInputAttachments, subpass.inputAttachmentCount, createInfo);
+
+			//resolvecolorһһӦ
+			write(subpass.colorAttachmentCount);
+			writeAttachmentReferences(subpass.pColorAttachments, subpass.colorAttachmentCount, createInfo);
+			writeAttachmentReferences(subpass.pResolveAttachments, subpass.colorAttachmentCount, createInfo);
+
+			writeAttachmentReferences(subpass.pDepthStencilAttachment, 1, createInfo);
+
+			write(subpass.preserveAttachmentCount);
+			for (uint32_t j = 0; j < subpass.preserveAttachmentCount; ++j) {
+				write(subpass.pPreserveAttachments[j]);
+			}
+		}
+
+		write(createInfo.dependencyCount);
+		for (uint32_t i = 0; i < createInfo.dependencyCount; ++i) {
+			const auto& dependency = createInfo.pDependencies[i];
+			write(dependency.srcSubpass);
+			write(dependency.dstSubpass);
+			write(dependency.srcStageMask);
+			write(dependency.dstStageMask);
+			write(dependency.srcAccessMask);
+			write(dependency.dstAccessMask);
+			write(dependency.dependencyFlags);
+		}
+	}
+
+	uint64_t StateKeyWriter::hash(const std::vector<uint8_t>& bytes) {
+		uint64_t hash = 14695981039346656037ull;
+		for (uint8_t byte : bytes) {
+			hash ^= byte;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <vulkan/vulkan.h>
+
+namespace FF::Wrapper {
+
+	/*
+	* ѹص״̬дֽУΪPipelineRegistrykeyκvulkan
+	* 1 ֶд룬дṹ屾ָ롢ṹеֽڶȽ
+	* 2 descriptor set layoutϢд룬ͬlayoutʹǲͬVkDescriptorSetLayoutҲõͬkey
+	* 3 render passݹд룺дɱøŵĸʽloadOp/storeOp/layout룬
+	*   subpassеcolor/input/resolve/depthápreserveԼdependency
+	*/
+	class StateKeyWriter {
+	public:
+		template<typename T>
+		void write(const T& value) {
+			static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "write fields one by one");
+			auto offset = _bytes.size();
+			_bytes.resize(offset + sizeof(T));
+			memcpy(_bytes.data() + offset, &value, sizeof(T));
+		}
+
+		void write(const std::string& value);
+
+		void write(const std::vector<uint8_t>& bytes);
+
+		void write(const VkStencilOpState& state);
+
+		//pNextеVkDescriptorSetLayoutBindingFlagsCreateInfoһд룬֧immutable sampler
+		void writeSetLayout(const VkDescriptorSetLayoutCreateInfo& createInfo);
+
+		void writeRenderPass(const VkRenderPassCreateInfo& createInfo);
+
+		[[nodiscard]] const std::vector<uint8_t>& getBytes() const { return _bytes; }
+
+		//FNV-1a
+		[[nodiscard]] static uint64_t hash(const std::vector<uint8_t>& bytes);
+
+	private:
+		//referencesΪָʱcountVK_ATTACHMENT_UNUSEDͬ
+		void writeAttachmentReferences(const VkAttachmentReference* references, uint32_t count, const VkRenderPassCreateInfo& createInfo);
+
+	private:
+		std::vector<uint8_t> _bytes{};
+	};
+}
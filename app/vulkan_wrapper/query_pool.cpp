@@ -0,0 +1,65 @@
+#include "query_pool.h"
+
+namespace FF::Wrapper {
+
+	QueryPool::QueryPool(const Device::Ptr& device, VkQueryType type, uint32_t queryCount) {
+		_device = device;
+		_queryCount = queryCount;
+
+		VkQueryPoolCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		createInfo.queryType = type;
+		createInfo.queryCount = queryCount;
+
+		if (vkCreateQueryPool(_device->getDevice(), &createInfo, nullptr, &_queryPool) != VK_SUCCESS) {
+			throw std::runtime_error("Error: failed to create query pool");
+		}
+	}
+
+	QueryPool::~QueryPool() {
+		if (_queryPool != VK_NULL_HANDLE) {
+			vkDestroyQueryPool(_device->getDevice(), _queryPool, nullptr);
+		}
+	}
+
+	bool QueryPool::getResults(uint32_t firstQuery, uint32_t count, std::vector<uint64_t>& results, VkQueryResultFlags flags) {
+		results.resize(count);
+		if (count == 0) {
+			return true;
+		}
+
+		VkResult result = vkGetQueryPoolResults(
+			_device->getDevice(), _queryPool, firstQuery, count,
+			results.size() * sizeof(uint64_t), results.data(), sizeof(uint64_t),
+			flags | VK_QUERY_RESULT_64_BIT
+		);
+
+		return result == VK_SUCCESS;
+	}
+
+	void QueryPool::getResultsWithAvailability(uint32_t firstQuery, uint32_t count, std::vector<uint64_t>& results, std::vector<bool>& available) {
+		results.resize(count);
+		available.assign(count, false);
+		if (count == 0) {
+			return;
+		}
+
+		//ÿqueryдñ־64λֵ
+		std::vector<uint64_t> data(static_cast<size_t>(count) * 2);
+		VkResult result = vkGetQueryPoolResults(
+			_device->getDevice(), _queryPool, firstQuery, count,
+			data.size() * sizeof(uint64_t), data.data(), sizeof(uint64_t) * 2,
+			VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+		);
+
+		//queryδʱVK_NOT_READYѾĽȻд
+		if (result != VK_SUCCESS && result != VK_NOT_READY) {
+			throw std::runtime_error("Error: failed to get query pool results");
+		}
+
+		for (uint32_t i = 0; i < count; ++i) {
+			results[i] = data[i * 2];
+			available[i] = data[i * 2 + 1] != 0;
+		}
+	}
+}
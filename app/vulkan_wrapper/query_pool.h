@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+
+namespace FF::Wrapper {
+
+	/*
+	* ѯأһGPUдquery
+	* 1 ʹǰҪCommandBufferreset(CommandBuffer::resetQueryPool)ҪRenderPass֮
+	* 2 ִϺͨgetResultsأWAIT־ʱδ᷵false
+	*/
+	class QueryPool {
+	public:
+		using Ptr = std::shared_ptr<QueryPool>;
+
+		static Ptr create(const Device::Ptr& device, VkQueryType type, uint32_t queryCount) {
+			return std::make_shared<QueryPool>(device, type, queryCount);
+		}
+
+		QueryPool(const Device::Ptr& device, VkQueryType type, uint32_t queryCount);
+
+		~QueryPool();
+
+		//[firstQuery, firstQuery + count)64λнδʱfalse
+		bool getResults(uint32_t firstQuery, uint32_t count, std::vector<uint64_t>& results, VkQueryResultFlags flags = 0);
+
+		//ͬʱÿqueryĿñ־δqueryӦavailableΪfalseȻЧʧʱ׳
+		void getResultsWithAvailability(uint32_t firstQuery, uint32_t count, std::vector<uint64_t>& results, std::vector<bool>& available);
+
+		[[nodiscard]] VkQueryPool getQueryPool() const { return _queryPool; }
+
+		[[nodiscard]] uint32_t getQueryCount() const { return _queryCount; }
+
+	private:
+		VkQueryPool _queryPool{ VK_NULL_HANDLE };
+		uint32_t _queryCount{ 0 };
+		Device::Ptr _device{ nullptr };
+	};
+}
@@ -86,6 +86,11 @@ namespace FF::Wrapper {
 		createInfo.subpassCount = static_cast<uint32_t>(subPasses.size());
 		createInfo.pSubpasses = subPasses.data();
 
+		//subpassеָֻЧǰɼϢ
+		StateKeyWriter keyWriter;
+		keyWriter.writeRenderPass(createInfo);
+		_compatibilityKey = keyWriter.getBytes();
+
 		if (vkCreateRenderPass(_device->getDevice(), &createInfo, nullptr, &_renderPass) != VK_SUCCESS) {
 			throw std::runtime_error("Error: failed to create render pass");
 		}
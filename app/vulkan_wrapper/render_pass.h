@@ -2,6 +2,7 @@
 
 #include "../base.h"
 #include "device.h"
+#include "pipeline_state_key.h"
 
 namespace FF::Wrapper {
 	//˼·
@@ -59,12 +60,20 @@ namespace FF::Wrapper {
 		void buildPrenderPass();
 
 		[[nodiscard]] VkRenderPass getRenderPass() const { return _renderPass; }
+
+		[[nodiscard]] const std::vector<VkAttachmentDescription>& getAttachmentDescriptions() const { return _attachmentDescriptions; }
+
+		[[nodiscard]] size_t getSubPassCount() const { return _subPasses.size(); }
+
+		//buildʱɣݵrender passõͬkeyԹpipeline
+		[[nodiscard]] const std::vector<uint8_t>& getCompatibilityKey() const { return _compatibilityKey; }
 	private:
 
 		VkRenderPass _renderPass{ VK_NULL_HANDLE };
 		std::vector<SubPass> _subPasses{};
 		std::vector<VkSubpassDependency> _dependencies;
 		std::vector<VkAttachmentDescription> _attachmentDescriptions;
+		std::vector<uint8_t> _compatibilityKey{};
 
 		Device::Ptr _device;
 	};
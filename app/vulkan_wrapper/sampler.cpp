@@ -2,9 +2,7 @@
 
 namespace FF::Wrapper {
 
-	Sampler::Sampler(const Device::Ptr& device) {
-		_device = device;
-
+	VkSamplerCreateInfo Sampler::getDefaultCreateInfo(uint32_t mipLevels) {
 		VkSamplerCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
 		createInfo.magFilter = VK_FILTER_LINEAR;
@@ -23,7 +21,17 @@ namespace FF::Wrapper {
 		createInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
 		createInfo.mipLodBias = 0.0f;
 		createInfo.minLod = 0.0f;
-		createInfo.maxLod = 0.0f;
+		//һlodΪmipLevels - 1
+		createInfo.maxLod = static_cast<float>(mipLevels > 0 ? mipLevels - 1 : 0);
+		return createInfo;
+	}
+
+	Sampler::Sampler(const Device::Ptr& device, uint32_t mipLevels) : Sampler(device, getDefaultCreateInfo(mipLevels)) {
+	}
+
+	Sampler::Sampler(const Device::Ptr& device, const VkSamplerCreateInfo& createInfo) {
+		_device = device;
+
 		if (vkCreateSampler(_device->getDevice(), &createInfo, nullptr, &_sampler) != VK_SUCCESS) {
 			throw std::runtime_error("Error: failed to create sampler");
 		}
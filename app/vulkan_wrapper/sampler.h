@@ -9,9 +9,17 @@ namespace FF::Wrapper {
 	public:
 
 		using Ptr = std::shared_ptr<Sampler>;
-		static Ptr create(const Device::Ptr& device) { return std::make_shared<Sampler>(device); }
+		//mipLevelsmaxLodʱʹȫmipmap
+		static Ptr create(const Device::Ptr& device, uint32_t mipLevels = 1) { return std::make_shared<Sampler>(device, mipLevels); }
 
-		Sampler(const Device::Ptr& device);
+		static Ptr create(const Device::Ptr& device, const VkSamplerCreateInfo& createInfo) { return std::make_shared<Sampler>(device, createInfo); }
+
+		//ԹˡظѰַ16ԣmaxLodmipLevels
+		static VkSamplerCreateInfo getDefaultCreateInfo(uint32_t mipLevels = 1);
+
+		Sampler(const Device::Ptr& device, uint32_t mipLevels = 1);
+
+		Sampler(const Device::Ptr& device, const VkSamplerCreateInfo& createInfo);
 
 		~Sampler();
 
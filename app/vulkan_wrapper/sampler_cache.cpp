@@ -0,0 +1,87 @@
+#include "sampler_cache.h"
+
+namespace FF::Wrapper {
+
+	namespace {
+		//λϣ-0.00.0Ϊͬãֻഴһsampler
+		template<typename T>
+		void hashCombine(size_t& seed, const T& value) {
+			size_t bits = 0;
+			memcpy(&bits, &value, std::min(sizeof(T), sizeof(size_t)));
+			seed ^= bits + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+		}
+	}
+
+	bool SamplerCache::Key::operator==(const Key& other) const {
+		const auto& a = mCreateInfo;
+		const auto& b = other.mCreateInfo;
+		return a.flags == b.flags &&
+			a.magFilter == b.magFilter &&
+			a.minFilter == b.minFilter &&
+			a.mipmapMode == b.mipmapMode &&
+			a.addressModeU == b.addressModeU &&
+			a.addressModeV == b.addressModeV &&
+			a.addressModeW == b.addressModeW &&
+			a.mipLodBias == b.mipLodBias &&
+			a.anisotropyEnable == b.anisotropyEnable &&
+			a.maxAnisotropy == b.maxAnisotropy &&
+			a.compareEnable == b.compareEnable &&
+			a.compareOp == b.compareOp &&
+			a.minLod == b.minLod &&
+			a.maxLod == b.maxLod &&
+			a.borderColor == b.borderColor &&
+			a.unnormalizedCoordinates == b.unnormalizedCoordinates;
+	}
+
+	size_t SamplerCache::KeyHash::operator()(const Key& key) const {
+		const auto& info = key.mCreateInfo;
+		size_t seed = 0;
+		hashCombine(seed, info.flags);
+		hashCombine(seed, info.magFilter);
+		hashCombine(seed, info.minFilter);
+		hashCombine(seed, info.mipmapMode);
+		hashCombine(seed, info.addressModeU);
+		hashCombine(seed, info.addressModeV);
+		hashCombine(seed, info.addressModeW);
+		hashCombine(seed, info.mipLodBias);
+		hashCombine(seed, info.anisotropyEnable);
+		hashCombine(seed, info.maxAnisotropy);
+		hashCombine(seed, info.compareEnable);
+		hashCombine(seed, info.compareOp);
+		hashCombine(seed, info.minLod);
+		hashCombine(seed, info.maxLod);
+		hashCombine(seed, info.borderColor);
+		hashCombine(seed, info.unnormalizedCoordinates);
+		return seed;
+	}
+
+	SamplerCache::SamplerCache(const Device::Ptr& device) {
+		_device = device;
+	}
+
+	SamplerCache::~SamplerCache() {
+		_samplers.clear();
+	}
+
+	Sampler::Ptr SamplerCache::getSampler(const VkSamplerCreateInfo& createInfo) {
+		if (createInfo.pNext != nullptr) {
+			throw std::runtime_error("Error: sampler cache does not support pNext chains");
+		}
+
+		Key key{ createInfo };
+		auto iter = _samplers.find(key);
+		if (iter != _samplers.end()) {
+			return iter->second;
+		}
+
+		auto sampler = Sampler::create(_device, createInfo);
+		_samplers.emplace(key, sampler);
+		return sampler;
+	}
+
+	Sampler::Ptr SamplerCache::getDefaultSampler() {
+		auto createInfo = Sampler::getDefaultCreateInfo();
+		createInfo.maxLod = VK_LOD_CLAMP_NONE;
+		return getSampler(createInfo);
+	}
+}
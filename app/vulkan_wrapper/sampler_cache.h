@@ -0,0 +1,47 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+#include "sampler.h"
+#include <unordered_map>
+
+namespace FF::Wrapper {
+
+	/*
+	* VkSamplerCreateInfoݻSamplerͬͬһVkSampler
+	* 1 ֻȽcreateInfoֶΣִ֧pNextcreateInfo
+	* 2 Sampler豸(maxSamplerAllocationCount)ֻ֮벻ͬõй
+	*/
+	class SamplerCache {
+	public:
+		using Ptr = std::shared_ptr<SamplerCache>;
+
+		static Ptr create(const Device::Ptr& device) { return std::make_shared<SamplerCache>(device); }
+
+		SamplerCache(const Device::Ptr& device);
+
+		~SamplerCache();
+
+		Sampler::Ptr getSampler(const VkSamplerCreateInfo& createInfo);
+
+		//ĬãmaxLodƣimageViewļʵʿõmipmapͬҲԹ
+		Sampler::Ptr getDefaultSampler();
+
+		[[nodiscard]] size_t getSamplerCount() const { return _samplers.size(); }
+
+	private:
+		struct Key {
+			VkSamplerCreateInfo mCreateInfo{};
+
+			bool operator==(const Key& other) const;
+		};
+
+		struct KeyHash {
+			size_t operator()(const Key& key) const;
+		};
+
+	private:
+		Device::Ptr _device{ nullptr };
+		std::unordered_map<Key, Sampler::Ptr, KeyHash> _samplers{};
+	};
+}
@@ -24,6 +24,9 @@ namespace FF::Wrapper {
 		_entryPoint = entryPoint;
 
 		std::vector<char> codeBuffer = readBinary(fileName);
+
+		_code.assign(codeBuffer.begin(), codeBuffer.end());
+
 		VkShaderModuleCreateInfo shaderCreateInfo{};
 		shaderCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
 		shaderCreateInfo.codeSize = codeBuffer.size();
@@ -22,10 +22,14 @@ namespace FF::Wrapper {
 		[[nodiscard]] VkShaderStageFlagBits getShaderStage() const { return _shaderStage; }
 		[[nodiscard]] const std::string& getShaderEntryPoint() const { return _entryPoint; }
 		[[nodiscard]] VkShaderModule getShaderModule() const { return _shaderModule; }
+
+		//SPIR-VݣPipelineRegistryshaderʹùϣͻʱshaderpipeline
+		[[nodiscard]] const std::vector<uint8_t>& getCode() const { return _code; }
 	private:
 		VkShaderModule _shaderModule{ VK_NULL_HANDLE };
 		Device::Ptr _device{ nullptr };
 		std::string _entryPoint;
 		VkShaderStageFlagBits _shaderStage;
+		std::vector<uint8_t> _code{};
 	};
 }
\ No newline at end of file
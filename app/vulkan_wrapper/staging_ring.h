@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+
+namespace FF::Wrapper {
+
+	/*
+	* stagingλĵַ㣬漰κvulkan
+	* 1 headtailΪַֻȡģõʵƫƣhead - tailΪڱGPUʹõĴС
+	* 2 һݲܿԽĩβԽʱһȦ㿪ʼĩβʣµĲ
+	* 3 밴ȦƫƼ㣬СǶʱҲܷȦС
+	* 4 ûκʹʱ(head == tail)resetheadtailһƵһȦ㣬֮Ȧ
+	*/
+	class StagingRing {
+	public:
+		StagingRing() = default;
+
+		StagingRing(uint64_t size, uint64_t alignment) {
+			_size = size;
+			_alignment = alignment == 0 ? 1 : alignment;
+		}
+
+		//ռ㹻ʱгsizeСһΣoffsetΪڻеʵƫƣռ䲻false״̬
+		bool allocate(uint64_t size, uint64_t& offset) {
+			if (size > _size) {
+				return false;
+			}
+
+			uint64_t lap = _head / _size * _size;
+			uint64_t inLap = (_head - lap + _alignment - 1) / _alignment * _alignment;
+			if (inLap + size > _size) {
+				lap += _size;
+				inLap = 0;
+			}
+
+			uint64_t begin = lap + inLap;
+			if (begin + size - _tail > _size) {
+				return false;
+			}
+
+			offset = inLap;
+			_head = begin + size;
+			return true;
+		}
+
+		//黹end֮ǰпռ䣬endΪ֮ǰĳgetHeadķֵ
+		void release(uint64_t end) { _tail = end; }
+
+		//ֻûʹʱ
+		void reset() {
+			uint64_t next = (_head + _size - 1) / _size * _size;
+			_head = next;
+			_tail = next;
+		}
+
+		[[nodiscard]] bool isIdle() const { return _head == _tail; }
+
+		[[nodiscard]] uint64_t getHead() const { return _head; }
+
+		[[nodiscard]] uint64_t getTail() const { return _tail; }
+
+		[[nodiscard]] uint64_t getSize() const { return _size; }
+
+	private:
+		uint64_t _size{ 0 };
+		uint64_t _alignment{ 1 };
+		uint64_t _head{ 0 };
+		uint64_t _tail{ 0 };
+	};
+}
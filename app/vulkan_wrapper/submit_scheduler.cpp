@@ -0,0 +1,91 @@
+#include "submit_scheduler.h"
+#include "../profiler.h"
+
+namespace FF::Wrapper {
+
+	SubmitScheduler::SubmitScheduler(const Device::Ptr& device, VkQueue queue) {
+		_device = device;
+		_queue = queue;
+		_timeline = TimelineSemaphore::create(_device, 0);
+	}
+
+	SubmitScheduler::~SubmitScheduler() {
+		waitIdle();
+	}
+
+	uint64_t SubmitScheduler::submit(
+		const std::vector<VkCommandBuffer>& commandBuffers,
+		const std::vector<VkSemaphore>& waitSemaphores,
+		const std::vector<VkPipelineStageFlags>& waitStages,
+		const std::vector<VkSemaphore>& signalSemaphores,
+		const std::vector<TimelineWait>& timelineWaits
+	) {
+		assert(waitSemaphores.size() == waitStages.size());
+
+		//binary semaphoretimeline semaphoreͬһУbinaryӦֵᱻ
+		std::vector<VkSemaphore> waits = waitSemaphores;
+		std::vector<VkPipelineStageFlags> stages = waitStages;
+		std::vector<uint64_t> waitValues(waitSemaphores.size(), 0);
+		for (const auto& timelineWait : timelineWaits) {
+			waits.push_back(timelineWait.mSemaphore->getSemaphore());
+			stages.push_back(timelineWait.mStageMask);
+			waitValues.push_back(timelineWait.mValue);
+		}
+
+		uint64_t signalValue = _submittedValue + 1;
+		std::vector<VkSemaphore> signals = signalSemaphores;
+		std::vector<uint64_t> signalValues(signalSemaphores.size(), 0);
+		signals.push_back(_timeline->getSemaphore());
+		signalValues.push_back(signalValue);
+
+		VkTimelineSemaphoreSubmitInfo timelineInfo{};
+		timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+		timelineInfo.waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size());
+		timelineInfo.pWaitSemaphoreValues = waitValues.data();
+		timelineInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signalValues.size());
+		timelineInfo.pSignalSemaphoreValues = signalValues.data();
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.pNext = &timelineInfo;
+		submitInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
+		submitInfo.pCommandBuffers = commandBuffers.data();
+		submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waits.size());
+		submitInfo.pWaitSemaphores = waits.data();
+		submitInfo.pWaitDstStageMask = stages.data();
+		submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signals.size());
+		submitInfo.pSignalSemaphores = signals.data();
+
+		{
+			FF_PROFILE_ZONE("vkQueueSubmit");
+			if (vkQueueSubmit(_queue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+				throw std::runtime_error("Error: failed to submit to queue");
+			}
+		}
+
+		_submittedValue = signalValue;
+		return _submittedValue;
+	}
+
+	void SubmitScheduler::wait(uint64_t value) {
+		if (value <= _completedValue) {
+			return;
+		}
+
+		FF_PROFILE_ZONE("SubmitScheduler::wait");
+		_timeline->wait(value);
+		_completedValue = std::max(_completedValue, value);
+	}
+
+	bool SubmitScheduler::isComplete(uint64_t value) {
+		if (value <= _completedValue) {
+			return true;
+		}
+		return value <= getCompletedValue();
+	}
+
+	uint64_t SubmitScheduler::getCompletedValue() {
+		_completedValue = std::max(_completedValue, _timeline->getValue());
+		return _completedValue;
+	}
+}
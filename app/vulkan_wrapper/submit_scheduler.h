@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+#include "timeline_semaphore.h"
+
+namespace FF::Wrapper {
+
+	/*
+	* һеύÿύͬһtimeline semaphoresignalһֵ
+	* 1 submitرύֵCPUȴԴʱԻգֻҪȽֵ
+	* 2 еύͨTimelineWaitȴֵʵֿҪΪÿύ׼binary semaphore
+	* 3 ͬһеύ˳ɣֵСڵgetCompletedValueύȫִ
+	* 4 ֻһ߳ύбҪⲿͬ
+	*/
+	class SubmitScheduler {
+	public:
+		using Ptr = std::shared_ptr<SubmitScheduler>;
+
+		//ȴһtimeline semaphoremValue֮󣬲ִmStageMask׶
+		struct TimelineWait {
+			TimelineSemaphore::Ptr mSemaphore{ nullptr };
+			uint64_t mValue{ 0 };
+			VkPipelineStageFlags mStageMask{ VK_PIPELINE_STAGE_ALL_COMMANDS_BIT };
+		};
+
+		static Ptr create(const Device::Ptr& device, VkQueue queue) {
+			return std::make_shared<SubmitScheduler>(device, queue);
+		}
+
+		SubmitScheduler(const Device::Ptr& device, VkQueue queue);
+
+		~SubmitScheduler();
+
+		/*
+		* ύcommandBuffersرύsignalֵ
+		* waitSemaphores/signalSemaphoresΪbinary semaphore罻acquirepresent
+		*/
+		uint64_t submit(
+			const std::vector<VkCommandBuffer>& commandBuffers,
+			const std::vector<VkSemaphore>& waitSemaphores = {},
+			const std::vector<VkPipelineStageFlags>& waitStages = {},
+			const std::vector<VkSemaphore>& signalSemaphores = {},
+			const std::vector<TimelineWait>& timelineWaits = {}
+		);
+
+		//ֱvalueӦύִ
+		void wait(uint64_t value);
+
+		//ȴĿǰΪֹеύִ
+		void waitIdle() { wait(_submittedValue); }
+
+		[[nodiscard]] bool isComplete(uint64_t value);
+
+		//ѯGPUѾִϵֵ
+		[[nodiscard]] uint64_t getCompletedValue();
+
+		//һύֵ˿֮ǰ¼Ƶָִֵ
+		[[nodiscard]] uint64_t getSubmittedValue() const { return _submittedValue; }
+
+		[[nodiscard]] TimelineSemaphore::Ptr getTimelineSemaphore() const { return _timeline; }
+
+		[[nodiscard]] VkQueue getQueue() const { return _queue; }
+
+	private:
+		VkQueue _queue{ VK_NULL_HANDLE };
+		TimelineSemaphore::Ptr _timeline{ nullptr };
+
+		uint64_t _submittedValue{ 0 };
+
+		//һβѯֵֻ
+		uint64_t _completedValue{ 0 };
+
+		Device::Ptr _device{ nullptr };
+	};
+}
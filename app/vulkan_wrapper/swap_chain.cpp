@@ -3,9 +3,9 @@
 namespace FF::Wrapper {
 	SwapChain::SwapChain(
 		const Device::Ptr& device, 
-		const CommandPool::Ptr& commandPool,
 		const Window::Ptr& window, 
-		const WindowSurface::Ptr& surface
+		const WindowSurface::Ptr& surface,
+		const Ptr& oldSwapChain
 	) {
 		_device = device;
 		_window = window;
@@ -71,6 +71,9 @@ namespace FF::Wrapper {
 		//ǰ屻סĲ֣ûƣǻӰ쵽ض
 		createInfo.clipped = VK_TRUE;
 
+		//ڴС仯ʱµĽҪپɵĽ
+		createInfo.oldSwapchain = oldSwapChain ? oldSwapChain->getSwapChain() : VK_NULL_HANDLE;
+
 		if (vkCreateSwapchainKHR(_device->getDevice(), &createInfo, nullptr, &_swapChain) != VK_SUCCESS) {
 			throw std::runtime_error("Error: failed to create swap chain");
 		}
@@ -90,16 +93,10 @@ namespace FF::Wrapper {
 			_swapChainImageViews[i] = createImageView(_swapChainImages[i], _swapChainFormat, VK_IMAGE_ASPECT_COLOR_BIT, 1);
 		}
 
-		//depthImage
+		//depthImagemultiSampleImage
+		//RenderPassŵinitialLayoutΪUNDEFINEDRenderPassʱԶתlayout
+		//ﲻҪύlayoutתؽʱҲͲõȴп
 		_depthImages.resize(_imageCount);
-
-		VkImageSubresourceRange region{};
-		region.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-		region.baseMipLevel = 0;
-		region.levelCount = 1;
-		region.baseArrayLayer = 0;
-		region.layerCount = 1;
-
 		for (int i = 0; i < _imageCount; ++i) {
 			_depthImages[i] = Image::createDepthImage(
 				_device, 
@@ -107,21 +104,8 @@ namespace FF::Wrapper {
 				_swapChainExtent.height,
 				_device->getMaxUsableSampleCount()
 			);
-			_depthImages[i]->setImageLayout(
-				VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
-				VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-				VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
-				region, commandPool
-			);
 		}
 
-		//multiSampleImage
-		VkImageSubresourceRange mulsampleRegion{};
-		mulsampleRegion.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		mulsampleRegion.baseMipLevel = 0;
-		mulsampleRegion.levelCount = 1;
-		mulsampleRegion.baseArrayLayer = 0;
-		mulsampleRegion.layerCount = 1;
 		_multiSampleImages.resize(_imageCount);
 		for (int i = 0; i < _imageCount; ++i) {
 			_multiSampleImages[i] = Image::createRenderTargetImage(
@@ -129,12 +113,12 @@ namespace FF::Wrapper {
 				_swapChainExtent.height, _swapChainFormat,
 				_device->getMaxUsableSampleCount()
 			);
-			_multiSampleImages[i]->setImageLayout(
-				VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-				VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-				VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-				mulsampleRegion, commandPool
-			);
+		}
+
+		//ְͼƬȴͬһͼƬһαacquire֮ǰһγһѾsemaphore
+		_renderFinishedSemaphores.resize(_imageCount);
+		for (int i = 0; i < _imageCount; ++i) {
+			_renderFinishedSemaphores[i] = Semaphore::create(_device);
 		}
 	}
 	SwapChain::~SwapChain() {
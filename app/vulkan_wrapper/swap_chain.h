@@ -6,7 +6,7 @@
 #include "window_surface.h"
 #include "render_pass.h"
 #include "image.h"
-#include "command_pool.h"
+#include "semaphore.h"
 
 namespace FF::Wrapper {
 
@@ -21,20 +21,22 @@ namespace FF::Wrapper {
 
 		using Ptr = std::shared_ptr<SwapChain>;
 
+		//ؽʱɵĽԸԴɽѾύĳȻ
+		//ɽ״̬ʹִ֡Ϻ
 		static Ptr create(
 			const Device::Ptr& device,
-			const CommandPool::Ptr& commandPool,
 			const Window::Ptr& window,
-			const WindowSurface::Ptr& surface
+			const WindowSurface::Ptr& surface,
+			const Ptr& oldSwapChain = nullptr
 		) {
-			return std::make_shared<SwapChain>(device, commandPool, window, surface);
+			return std::make_shared<SwapChain>(device, window, surface, oldSwapChain);
 		}
 
 		SwapChain(
 			const Device::Ptr& device,
-			const CommandPool::Ptr& commandPool,
 			const Window::Ptr& window,
-			const WindowSurface::Ptr& surface
+			const WindowSurface::Ptr& surface,
+			const Ptr& oldSwapChain = nullptr
 		);
 		~SwapChain();
 
@@ -56,10 +58,13 @@ namespace FF::Wrapper {
 
 		[[nodiscard]] VkSwapchainKHR getSwapChain() const { return _swapChain; }
 
-		[[nodiscard]] VkFramebuffer getFrameBuffer(const int index) { return _swapChainFrameBuffers[index]; }
+		[[nodiscard]] VkFramebuffer getFrameBuffer(uint32_t index) const { return _swapChainFrameBuffers[index]; }
 
 		[[nodiscard]] VkExtent2D getExtent() const { return _swapChainExtent; }
 
+		//ȾϡֵȴsemaphoreacquireõͼƬ
+		[[nodiscard]] Semaphore::Ptr getRenderFinishedSemaphore(uint32_t imageIndex) const { return _renderFinishedSemaphores[imageIndex]; }
+
 	private:
 
 		VkImageView createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels = 1);
@@ -86,6 +91,8 @@ namespace FF::Wrapper {
 		//زмͼƬ
 		std::vector<Image::Ptr> _multiSampleImages{};
 
+		std::vector<Semaphore::Ptr> _renderFinishedSemaphores{};
+
 		Device::Ptr _device{ nullptr };
 		Window::Ptr _window{ nullptr };
 		WindowSurface::Ptr _surface{ nullptr };
@@ -0,0 +1,58 @@
+#include "timeline_semaphore.h"
+
+namespace FF::Wrapper {
+
+	TimelineSemaphore::TimelineSemaphore(const Device::Ptr& device, uint64_t initialValue) {
+		_device = device;
+
+		if (!_device->isTimelineSemaphoreSupported()) {
+			throw std::runtime_error("Error: timeline semaphore is not supported");
+		}
+
+		VkSemaphoreTypeCreateInfo typeCreateInfo{};
+		typeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+		typeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+		typeCreateInfo.initialValue = initialValue;
+
+		VkSemaphoreCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		createInfo.pNext = &typeCreateInfo;
+
+		if (vkCreateSemaphore(_device->getDevice(), &createInfo, nullptr, &_semaphore) != VK_SUCCESS) {
+			throw std::runtime_error("Error: failed to create timeline semaphore");
+		}
+	}
+
+	TimelineSemaphore::~TimelineSemaphore() {
+		if (_semaphore != VK_NULL_HANDLE) {
+			vkDestroySemaphore(_device->getDevice(), _semaphore, nullptr);
+		}
+	}
+
+	bool TimelineSemaphore::wait(uint64_t value, uint64_t timeout) const {
+		VkSemaphoreWaitInfo waitInfo{};
+		waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+		waitInfo.semaphoreCount = 1;
+		waitInfo.pSemaphores = &_semaphore;
+		waitInfo.pValues = &value;
+
+		return vkWaitSemaphores(_device->getDevice(), &waitInfo, timeout) == VK_SUCCESS;
+	}
+
+	void TimelineSemaphore::signal(uint64_t value) {
+		VkSemaphoreSignalInfo signalInfo{};
+		signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+		signalInfo.semaphore = _semaphore;
+		signalInfo.value = value;
+
+		if (vkSignalSemaphore(_device->getDevice(), &signalInfo) != VK_SUCCESS) {
+			throw std::runtime_error("Error: failed to signal timeline semaphore");
+		}
+	}
+
+	uint64_t TimelineSemaphore::getValue() const {
+		uint64_t value{ 0 };
+		vkGetSemaphoreCounterValue(_device->getDevice(), _semaphore, &value);
+		return value;
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+
+namespace FF::Wrapper {
+
+	/*
+	* timeline semaphoreڲһֻ64λ
+	* 1 ύʱsignalһֵGPUִϺΪֵ
+	* 2 CPUֱӵȴ/ѯĳֵȡfenceеύԵȴĳֵȡbinary semaphore
+	* 3 ͬһsemaphoreһֱʹȥҪfenceһreset
+	* 4 acquire/presentֻ֧binary semaphoreȻʹSemaphore
+	*/
+	class TimelineSemaphore {
+	public:
+		using Ptr = std::shared_ptr<TimelineSemaphore>;
+
+		static Ptr create(const Device::Ptr& device, uint64_t initialValue = 0) {
+			return std::make_shared<TimelineSemaphore>(device, initialValue);
+		}
+
+		TimelineSemaphore(const Device::Ptr& device, uint64_t initialValue = 0);
+
+		~TimelineSemaphore();
+
+		//ֱڵvalueʱfalse
+		bool wait(uint64_t value, uint64_t timeout = UINT64_MAX) const;
+
+		//CPU˰ѼΪvaluevalueڵǰֵ
+		void signal(uint64_t value);
+
+		//ѯGPUǰѾֵ
+		[[nodiscard]] uint64_t getValue() const;
+
+		[[nodiscard]] VkSemaphore getSemaphore() const { return _semaphore; }
+
+	private:
+		VkSemaphore _semaphore{ VK_NULL_HANDLE };
+		Device::Ptr _device{ nullptr };
+	};
+}
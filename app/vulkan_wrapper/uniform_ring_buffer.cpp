@@ -0,0 +1,62 @@
+#include "uniform_ring_buffer.h"
+
+namespace FF::Wrapper {
+
+	UniformRingBuffer::UniformRingBuffer(const Device::Ptr& device, VkDeviceSize regionSize, uint32_t frameCount) {
+		_device = device;
+		_frameCount = frameCount;
+
+		VkPhysicalDeviceProperties props;
+		vkGetPhysicalDeviceProperties(_device->getPhysicalDevice(), &props);
+		_alignment = std::max<VkDeviceSize>(props.limits.minUniformBufferOffsetAlignment, 1);
+
+		//ÿregionҲҪҪ
+		_regionSize = alignUp(regionSize);
+
+		_buffer = Buffer::create(
+			_device, _regionSize * _frameCount,
+			VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+		);
+
+		_mappedData = static_cast<uint8_t*>(_buffer->getMappedData());
+		if (_mappedData == nullptr) {
+			throw std::runtime_error("Error: uniform ring buffer is not host visible");
+		}
+	}
+
+	UniformRingBuffer::~UniformRingBuffer() {}
+
+	void UniformRingBuffer::beginFrame(uint32_t frameIndex) {
+		if (frameIndex >= _frameCount) {
+			throw std::runtime_error("Error: uniform ring buffer frame index out of range");
+		}
+		_frameIndex = frameIndex;
+		_head = getRegionOffset(frameIndex);
+	}
+
+	void* UniformRingBuffer::allocate(VkDeviceSize size, VkDeviceSize& offset) {
+		VkDeviceSize alignedSize = alignUp(size);
+		if (_head + alignedSize > getRegionOffset(_frameIndex) + _regionSize) {
+			throw std::runtime_error("Error: uniform ring buffer region overflow");
+		}
+
+		offset = _head;
+		_head += alignedSize;
+		return _mappedData + offset;
+	}
+
+	VkDeviceSize UniformRingBuffer::push(const void* data, VkDeviceSize size) {
+		VkDeviceSize offset{ 0 };
+		void* dst = allocate(size, offset);
+		memcpy(dst, data, static_cast<size_t>(size));
+		return offset;
+	}
+
+	void UniformRingBuffer::endFrame() {
+		VkDeviceSize usedSize = getUsedSize();
+		if (usedSize > 0) {
+			_device->getAllocator()->flush(_buffer->getAllocation(), getRegionOffset(_frameIndex), usedSize);
+		}
+	}
+}
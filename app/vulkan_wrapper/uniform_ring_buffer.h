@@ -0,0 +1,68 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+#include "buffer.h"
+
+namespace FF::Wrapper {
+
+	/*
+	* ÿ֡uniformλ
+	* 1 һפӳHostVisibleBufferշе֡зΪregionÿ֡ռһregion
+	* 2 ÿ֡ʼʱbeginFrameαص֡region㣬֮ÿallocate/pushα괦гһΣ
+	*   minUniformBufferOffsetAlignment룬гoffsetֱдDescriptorΪdynamic offset
+	* 3 ֡ѭڲκmap/unmapҲҪΪÿ崴VkBuffer
+	*/
+
+	class UniformRingBuffer {
+	public:
+		using Ptr = std::shared_ptr<UniformRingBuffer>;
+		static Ptr create(const Device::Ptr& device, VkDeviceSize regionSize, uint32_t frameCount) {
+			return std::make_shared<UniformRingBuffer>(device, regionSize, frameCount);
+		}
+
+		UniformRingBuffer(const Device::Ptr& device, VkDeviceSize regionSize, uint32_t frameCount);
+
+		~UniformRingBuffer();
+
+		//αصframeIndexӦregion㣬һʹñregion֡Ѿִ
+		void beginFrame(uint32_t frameIndex);
+
+		//гsizeСһΣؿдĵַoffsetΪBufferƫ
+		void* allocate(VkDeviceSize size, VkDeviceSize& offset);
+
+		//гһβݽȥBufferƫ
+		VkDeviceSize push(const void* data, VkDeviceSize size);
+
+		//ڷHostCoherentڴ棬ѱ֡дķΧflush
+		void endFrame();
+
+		[[nodiscard]] VkDeviceSize alignUp(VkDeviceSize size) const {
+			return (size + _alignment - 1) / _alignment * _alignment;
+		}
+
+		[[nodiscard]] Buffer::Ptr getBuffer() const { return _buffer; }
+
+		[[nodiscard]] VkDeviceSize getAlignment() const { return _alignment; }
+
+		[[nodiscard]] VkDeviceSize getRegionSize() const { return _regionSize; }
+
+		[[nodiscard]] VkDeviceSize getRegionOffset(uint32_t frameIndex) const { return _regionSize * frameIndex; }
+
+		//֡Ѿʹõֽ
+		[[nodiscard]] VkDeviceSize getUsedSize() const { return _head - getRegionOffset(_frameIndex); }
+
+	private:
+		Buffer::Ptr _buffer{ nullptr };
+		Device::Ptr _device{ nullptr };
+
+		uint8_t* _mappedData{ nullptr };
+
+		VkDeviceSize _alignment{ 1 };
+		VkDeviceSize _regionSize{ 0 };
+		uint32_t _frameCount{ 0 };
+
+		uint32_t _frameIndex{ 0 };
+		VkDeviceSize _head{ 0 };
+	};
+}
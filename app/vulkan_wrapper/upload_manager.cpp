@@ -0,0 +1,325 @@
+#include "upload_manager.h"
+
+namespace FF::Wrapper {
+
+	UploadManager::UploadManager(const Device::Ptr& device, const SubmitScheduler::Ptr& graphicScheduler, VkDeviceSize stagingSize) {
+		_device = device;
+		_graphicScheduler = graphicScheduler;
+		_stagingSize = stagingSize;
+
+		_dedicatedTransfer = _device->hasDedicatedTransferQueue();
+		_transferQueueFamily = _device->getTransferQueueFamily().value();
+		_graphicQueueFamily = _device->getGraphicQueueFamily().value();
+
+		//ڴڵָأCommandBufferҪ
+		_commandPool = CommandPool::create(_device, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, _transferQueueFamily);
+		if (_dedicatedTransfer) {
+			_acquireCommandPool = CommandPool::create(_device, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, _graphicQueueFamily);
+			_transferScheduler = SubmitScheduler::create(_device, _device->getTransferQueue());
+		}
+
+		_stagingBuffer = Buffer::createStageBuffer(_device, _stagingSize);
+		_stagingData = static_cast<uint8_t*>(_stagingBuffer->getMappedData());
+		if (_stagingData == nullptr) {
+			throw std::runtime_error("Error: staging buffer is not host visible");
+		}
+
+		VkPhysicalDeviceProperties props;
+		vkGetPhysicalDeviceProperties(_device->getPhysicalDevice(), &props);
+		VkDeviceSize alignment = std::max<VkDeviceSize>(16, props.limits.optimalBufferCopyOffsetAlignment);
+		_stagingRing = StagingRing(_stagingSize, alignment);
+	}
+
+	UploadManager::~UploadManager() {
+		waitIdle();
+	}
+
+	Buffer::Ptr UploadManager::stage(const void* data, VkDeviceSize size, VkBuffer& srcBuffer, VkDeviceSize& srcOffset) {
+		if (size > _stagingSize) {
+			auto tempBuffer = Buffer::createStageBuffer(_device, size, const_cast<void*>(data));
+			srcBuffer = tempBuffer->getBuffer();
+			srcOffset = 0;
+			return tempBuffer;
+		}
+
+		VkDeviceSize offset{ 0 };
+		while (!_stagingRing.allocate(size, offset)) {
+			//ռ䲻Ȱ¼еύٵȴɣ黹ռ
+			if (_recordingBatch && _recordingBatch->mHasWork) {
+				flush();
+			}
+
+			//ζɣstagingУһȦ㿪ʼȦСҲܷ
+			if (_pendingBatches.empty()) {
+				_stagingRing.reset();
+				continue;
+			}
+
+			_graphicScheduler->wait(_pendingBatches.front()->mSubmitValue);
+			collect();
+		}
+
+		srcBuffer = _stagingBuffer->getBuffer();
+		srcOffset = offset;
+		memcpy(_stagingData + srcOffset, data, static_cast<size_t>(size));
+		return nullptr;
+	}
+
+	UploadManager::Batch& UploadManager::getRecordingBatch() {
+		if (!_recordingBatch) {
+			if (!_freeBatches.empty()) {
+				_recordingBatch = std::move(_freeBatches.back());
+				_freeBatches.pop_back();
+			}
+			else {
+				_recordingBatch = std::make_unique<Batch>();
+				_recordingBatch->mCommandBuffer = CommandBuffer::create(_device, _commandPool);
+
+				if (_dedicatedTransfer) {
+					_recordingBatch->mAcquireCommandBuffer = CommandBuffer::create(_device, _acquireCommandPool);
+				}
+			}
+
+			_recordingBatch->mId = _nextBatchId++;
+			_recordingBatch->mCommandBuffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+			if (_dedicatedTransfer) {
+				_recordingBatch->mAcquireCommandBuffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+			}
+		}
+
+		return *_recordingBatch;
+	}
+
+	void UploadManager::uploadBuffer(const Buffer::Ptr& dstBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset) {
+		assert(data);
+		assert(size);
+
+		VkBuffer srcBuffer{ VK_NULL_HANDLE };
+		VkDeviceSize srcOffset{ 0 };
+		auto tempBuffer = stage(data, size, srcBuffer, srcOffset);
+
+		auto& batch = getRecordingBatch();
+		if (tempBuffer) {
+			batch.mTempBuffers.push_back(tempBuffer);
+		}
+
+		VkBufferCopy copyInfo{};
+		copyInfo.srcOffset = srcOffset;
+		copyInfo.dstOffset = dstOffset;
+		copyInfo.size = size;
+		batch.mCommandBuffer->copyBufferToBuffer(srcBuffer, dstBuffer->getBuffer(), 1, { copyInfo });
+
+		if (_dedicatedTransfer) {
+			batch.mCommandBuffer->releaseBufferOwnership(
+				dstBuffer->getBuffer(),
+				_transferQueueFamily, _graphicQueueFamily,
+				VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT
+			);
+			batch.mAcquireCommandBuffer->acquireBufferOwnership(
+				dstBuffer->getBuffer(),
+				_transferQueueFamily, _graphicQueueFamily,
+				VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+				VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT
+			);
+		}
+
+		batch.mDstBuffers.push_back(dstBuffer);
+		batch.mHasWork = true;
+	}
+
+	void UploadManager::uploadImage(
+		const Image::Ptr& dstImage,
+		const void* data,
+		VkDeviceSize size,
+		const VkImageSubresourceRange& subresourceRange,
+		VkImageLayout finalLayout,
+		VkPipelineStageFlags dstStageMask
+	) {
+		VkBufferImageCopy region{};
+		region.bufferOffset = 0;
+
+		//Ϊ0Ҫpadding
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+
+		region.imageSubresource.aspectMask = subresourceRange.aspectMask;
+		region.imageSubresource.mipLevel = subresourceRange.baseMipLevel;
+		region.imageSubresource.baseArrayLayer = subresourceRange.baseArrayLayer;
+		region.imageSubresource.layerCount = subresourceRange.layerCount;
+		region.imageOffset = { 0,0,0 };
+		region.imageExtent = { static_cast<uint32_t>(dstImage->getWidth()), static_cast<uint32_t>(dstImage->getHeight()), 1 };
+
+		uploadImage(dstImage, data, size, { region }, subresourceRange, finalLayout, dstStageMask, false);
+	}
+
+	void UploadManager::uploadImage(
+		const Image::Ptr& dstImage,
+		const void* data,
+		VkDeviceSize size,
+		const std::vector<VkBufferImageCopy>& regions,
+		const VkImageSubresourceRange& subresourceRange,
+		VkImageLayout finalLayout,
+		VkPipelineStageFlags dstStageMask,
+		bool generateMipmaps
+	) {
+		assert(data);
+		assert(size);
+
+		VkBuffer srcBuffer{ VK_NULL_HANDLE };
+		VkDeviceSize srcOffset{ 0 };
+		auto tempBuffer = stage(data, size, srcBuffer, srcOffset);
+
+		auto& batch = getRecordingBatch();
+		if (tempBuffer) {
+			batch.mTempBuffers.push_back(tempBuffer);
+		}
+
+		dstImage->addLayoutBarrier(
+			batch.mCommandBuffer,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			subresourceRange
+		);
+
+		//regionsеƫdataģstagingеλ
+		std::vector<VkBufferImageCopy> copyRegions = regions;
+		for (auto& region : copyRegions) {
+			region.bufferOffset += srcOffset;
+		}
+
+		batch.mCommandBuffer->copyBufferToImage(srcBuffer, dstImage->getImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, copyRegions);
+
+		//blitҪȾִУȨתʱTRANSFER_DST
+		VkImageLayout transferLayout = generateMipmaps ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : finalLayout;
+
+		if (_dedicatedTransfer) {
+			//layoutתȨתƵbarrierһ
+			batch.mCommandBuffer->releaseImageOwnership(
+				dstImage->getImage(), subresourceRange,
+				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, transferLayout,
+				_transferQueueFamily, _graphicQueueFamily,
+				VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT
+			);
+			batch.mAcquireCommandBuffer->acquireImageOwnership(
+				dstImage->getImage(), subresourceRange,
+				VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, transferLayout,
+				_transferQueueFamily, _graphicQueueFamily,
+				generateMipmaps ? VK_PIPELINE_STAGE_TRANSFER_BIT : dstStageMask,
+				generateMipmaps ? (VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT) : VK_ACCESS_SHADER_READ_BIT
+			);
+			dstImage->setLayout(transferLayout);
+
+			if (generateMipmaps) {
+				dstImage->generateMipmaps(batch.mAcquireCommandBuffer, finalLayout, dstStageMask);
+			}
+		}
+		else if (generateMipmaps) {
+			dstImage->generateMipmaps(batch.mCommandBuffer, finalLayout, dstStageMask);
+		}
+		else {
+			//flushʱmemoryBarrierϲ¼
+			dstImage->addLayoutBarrier(
+				batch.mCommandBuffer,
+				finalLayout,
+				VK_PIPELINE_STAGE_TRANSFER_BIT,
+				dstStageMask,
+				subresourceRange
+			);
+		}
+
+		batch.mDstImages.push_back(dstImage);
+		batch.mHasWork = true;
+	}
+
+	void UploadManager::addCompletionCallback(const Callback& callback) {
+		getRecordingBatch().mCallbacks.push_back(callback);
+	}
+
+	uint64_t UploadManager::flush() {
+		if (!_recordingBatch || (!_recordingBatch->mHasWork && _recordingBatch->mCallbacks.empty())) {
+			return _submittedBatchId;
+		}
+
+		auto& batch = *_recordingBatch;
+
+		if (_dedicatedTransfer) {
+			//ȾϵacquireȴtimelineﱾεֵεacquireύֵΪ׼
+			batch.mCommandBuffer->end();
+			uint64_t transferValue = _transferScheduler->submit({ batch.mCommandBuffer->getCommandBuffer() });
+
+			SubmitScheduler::TimelineWait transferWait{};
+			transferWait.mSemaphore = _transferScheduler->getTimelineSemaphore();
+			transferWait.mValue = transferValue;
+			transferWait.mStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+			batch.mAcquireCommandBuffer->end();
+			batch.mSubmitValue = _graphicScheduler->submit(
+				{ batch.mAcquireCommandBuffer->getCommandBuffer() }, 
+				{}, {}, {}, 
+				{ transferWait }
+			);
+		}
+		else {
+			//Ľ֮жȡ//uniform/Ľ׶οɼ
+			batch.mCommandBuffer->memoryBarrier(
+				VK_PIPELINE_STAGE_TRANSFER_BIT,
+				VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+				VK_ACCESS_TRANSFER_WRITE_BIT,
+				VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT
+			);
+			batch.mCommandBuffer->end();
+			batch.mSubmitValue = _graphicScheduler->submit({ batch.mCommandBuffer->getCommandBuffer() });
+		}
+
+		batch.mStagingEnd = _stagingRing.getHead();
+		_submittedBatchId = batch.mId;
+
+		_pendingBatches.push_back(std::move(_recordingBatch));
+		return _submittedBatchId;
+	}
+
+	void UploadManager::collect() {
+		std::vector<Callback> callbacks{};
+
+		//ͬһϵΰύ˳ɣֻҪͷ
+		while (!_pendingBatches.empty() && _graphicScheduler->isComplete(_pendingBatches.front()->mSubmitValue)) {
+			auto batch = std::move(_pendingBatches.front());
+			_pendingBatches.pop_front();
+
+			_stagingRing.release(batch->mStagingEnd);
+			_completedBatchId = batch->mId;
+
+			callbacks.insert(callbacks.end(), batch->mCallbacks.begin(), batch->mCallbacks.end());
+			batch->mCallbacks.clear();
+			batch->mTempBuffers.clear();
+			batch->mDstBuffers.clear();
+			batch->mDstImages.clear();
+			batch->mHasWork = false;
+
+			_freeBatches.push_back(std::move(batch));
+		}
+
+		//صпܻᷢµϴִ
+		for (auto& callback : callbacks) {
+			callback();
+		}
+	}
+
+	void UploadManager::update() {
+		flush();
+		collect();
+	}
+
+	void UploadManager::waitIdle() {
+		//ɻصпַϴֱûκδִеΪֹ
+		while (true) {
+			flush();
+			if (_pendingBatches.empty()) {
+				break;
+			}
+			_graphicScheduler->wait(_pendingBatches.back()->mSubmitValue);
+			collect();
+		}
+	}
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "../base.h"
+#include "device.h"
+#include "buffer.h"
+#include "image.h"
+#include "command_pool.h"
+#include "command_buffer.h"
+#include "submit_scheduler.h"
+#include "staging_ring.h"
+#include <functional>
+#include <deque>
+
+namespace FF::Wrapper {
+
+	/*
+	* ϴ CPU -> GPU(DeviceLocal) ݿ
+	* 1 һפӳstagingλ壬staging÷ڴ󼴿ͷ
+	* 2 һڴڵCommandPoolָ¼Ƶǰ(batch)CommandBufferУύ
+	* 3 flushʱύһΣvkQueueWaitIdleȾеύֵжǷִ
+	* 4 collectʱѾɵΣ黹stagingռ䣬ִɻصCommandBufferFenceŻسӸ
+	* 5 豸רôʱύУԴȨͨrelease/acquireתƸȾ壬
+	*   acquireָ¼ȾеCommandBufferУȴtimelineϵֵȾԲ
+	* 6 ûרôʱϴȾύͬһУĩβbarrier֤Ⱦָܶ
+	*/
+
+	class UploadManager {
+	public:
+		using Ptr = std::shared_ptr<UploadManager>;
+		using Callback = std::function<void()>;
+
+		static constexpr VkDeviceSize DEFAULT_STAGING_SIZE = 32ull * 1024 * 1024;
+
+		//graphicSchedulerΪȾеĵ֡ύͬһtimeline
+		static Ptr create(
+			const Device::Ptr& device, 
+			const SubmitScheduler::Ptr& graphicScheduler, 
+			VkDeviceSize stagingSize = DEFAULT_STAGING_SIZE
+		) {
+			return std::make_shared<UploadManager>(device, graphicScheduler, stagingSize);
+		}
+
+		UploadManager(
+			const Device::Ptr& device, 
+			const SubmitScheduler::Ptr& graphicScheduler, 
+			VkDeviceSize stagingSize = DEFAULT_STAGING_SIZE
+		);
+
+		~UploadManager();
+
+		//dstBufferdstOffsetdstBufferҪTRANSFER_DST;
+		void uploadBuffer(const Buffer::Ptr& dstBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset = 0);
+
+		/*
+		* ͼƬĵ0mipmap
+		* ͼƬתΪTRANSFER_DSTϺתΪfinalLayout
+		* dstStageMaskΪ֮ʹͼƬĽ׶
+		*/
+		void uploadImage(
+			const Image::Ptr& dstImage,
+			const void* data,
+			VkDeviceSize size,
+			const VkImageSubresourceRange& subresourceRange,
+			VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+		);
+
+		/*
+		* regions(CPUɺõÿһmipmap)regionsеbufferOffsetdataƫ
+		* subresourceRangeҪбļΧתΪTRANSFER_DST
+		* generateMipmapsΪtrueʱregionsֻҪ0༶Ⱦblitɣ
+		* רôʱȨתƱTRANSFER_DST䣬blit¼acquire֮
+		*/
+		void uploadImage(
+			const Image::Ptr& dstImage,
+			const void* data,
+			VkDeviceSize size,
+			const std::vector<VkBufferImageCopy>& regions,
+			const VkImageSubresourceRange& subresourceRange,
+			VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			bool generateMipmaps = false
+		);
+
+		//ǰִϺãcollectִ
+		void addCompletionCallback(const Callback& callback);
+
+		//ύǰΣȴرεţûдύʱһε
+		uint64_t flush();
+
+		//Ѿִϵ
+		void collect();
+
+		//ÿ֡һΣflush + collect
+		void update();
+
+		//ύȴִ
+		void waitIdle();
+
+		[[nodiscard]] bool isBatchComplete(uint64_t batchId) const { return batchId <= _completedBatchId; }
+
+		[[nodiscard]] VkDeviceSize getStagingSize() const { return _stagingSize; }
+
+	private:
+		struct Batch {
+			uint64_t mId{ 0 };
+			CommandBuffer::Ptr mCommandBuffer{ nullptr };
+
+			//רôʱʹãȾϵacquireָ
+			CommandBuffer::Ptr mAcquireCommandBuffer{ nullptr };
+
+			//Ⱦtimelineϵύִֵ
+			uint64_t mSubmitValue{ 0 };
+
+			//ʹõstagingΧյ(ַ)
+			VkDeviceSize mStagingEnd{ 0 };
+
+			//stagingСݵʱstagingɺͷ
+			std::vector<Buffer::Ptr> mTempBuffers{};
+
+			//Ŀǰ뱣ִ
+			std::vector<Buffer::Ptr> mDstBuffers{};
+			std::vector<Image::Ptr> mDstImages{};
+
+			std::vector<Callback> mCallbacks{};
+
+			//ǷѾ¼˿ָ
+			bool mHasWork{ false };
+		};
+
+		//¼еΣûʼһ
+		Batch& getRecordingBatch();
+
+		/*
+		* stagingгһβݣbufferƫ
+		* ռ䲻ʱύǰβȴɣԱgetRecordingBatch֮ǰ
+		* stagingСݷһʱBufferɵ÷ҵ
+		*/
+		Buffer::Ptr stage(const void* data, VkDeviceSize size, VkBuffer& srcBuffer, VkDeviceSize& srcOffset);
+
+
+	private:
+		Device::Ptr _device{ nullptr };
+		CommandPool::Ptr _commandPool{ nullptr };
+
+		SubmitScheduler::Ptr _graphicScheduler{ nullptr };
+
+		//רôеĵûרôʱΪ
+		SubmitScheduler::Ptr _transferScheduler{ nullptr };
+
+		//רôʱ¼acquireָȾָ
+		CommandPool::Ptr _acquireCommandPool{ nullptr };
+		bool _dedicatedTransfer{ false };
+		uint32_t _transferQueueFamily{ 0 };
+		uint32_t _graphicQueueFamily{ 0 };
+
+		Buffer::Ptr _stagingBuffer{ nullptr };
+		uint8_t* _stagingData{ nullptr };
+		VkDeviceSize _stagingSize{ 0 };
+		StagingRing _stagingRing{};
+
+		std::unique_ptr<Batch> _recordingBatch{ nullptr };
+		std::deque<std::unique_ptr<Batch>> _pendingBatches{};
+
+		//ִϵΣCommandBufferFenceԸ
+		std::vector<std::unique_ptr<Batch>> _freeBatches{};
+
+		uint64_t _nextBatchId{ 1 };
+		uint64_t _submittedBatchId{ 0 };
+		uint64_t _completedBatchId{ 0 };
+	};
+}
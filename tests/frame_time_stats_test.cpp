@@ -0,0 +1,58 @@
+#include "test.h"
+#include "../app/bench/frame_time_stats.h"
+
+using FF::FrameTimeStats;
+
+static void testEmpty() {
+	auto stats = FrameTimeStats::compute({});
+	FF_CHECK(stats.mSampleCount == 0);
+	FF_CHECK(stats.mMaxMs == 0.0);
+}
+
+//1..100һȷpNN
+static void testNearestRank() {
+	std::vector<double> samples{};
+	for (int i = 100; i >= 1; --i) {
+		samples.push_back(static_cast<double>(i));
+	}
+
+	auto stats = FrameTimeStats::compute(samples);
+	FF_CHECK(stats.mSampleCount == 100);
+	FF_CHECK(stats.mMinMs == 1.0);
+	FF_CHECK(stats.mMaxMs == 100.0);
+	FF_CHECK(stats.mAvgMs == 50.5);
+	FF_CHECK(stats.mP50Ms == 50.0);
+	FF_CHECK(stats.mP95Ms == 95.0);
+	FF_CHECK(stats.mP99Ms == 99.0);
+}
+
+//ʱ߰ٷλֵϣԽ
+static void testFewSamples() {
+	auto single = FrameTimeStats::compute({ 4.0 });
+	FF_CHECK(single.mP50Ms == 4.0);
+	FF_CHECK(single.mP99Ms == 4.0);
+
+	auto three = FrameTimeStats::compute({ 3.0, 1.0, 2.0 });
+	FF_CHECK(three.mP50Ms == 2.0);
+	FF_CHECK(three.mP95Ms == 3.0);
+	FF_CHECK(three.mAvgMs == 2.0);
+}
+
+//һγֻ֡Ӱ߰ٷλ
+static void testSpike() {
+	std::vector<double> samples(99, 16.0);
+	samples.push_back(100.0);
+
+	auto stats = FrameTimeStats::compute(samples);
+	FF_CHECK(stats.mP50Ms == 16.0);
+	FF_CHECK(stats.mP99Ms == 16.0);
+	FF_CHECK(stats.mMaxMs == 100.0);
+}
+
+int main() {
+	testEmpty();
+	testNearestRank();
+	testFewSamples();
+	testSpike();
+	return FF_TEST_RESULT();
+}
@@ -0,0 +1,131 @@
+#include "test.h"
+#include "../app/vulkan_wrapper/free_range_list.h"
+
+using FF::Wrapper::FreeRangeList;
+
+static void testAlignment() {
+	FreeRangeList list(256);
+	uint64_t offset{ 0 };
+	uint64_t padding{ 0 };
+
+	FF_CHECK(list.allocate(10, 1, offset, padding));
+	FF_CHECK(offset == 0);
+	FF_CHECK(padding == 0);
+
+	//10뵽166ֽpadding
+	FF_CHECK(list.allocate(16, 16, offset, padding));
+	FF_CHECK(offset == 16);
+	FF_CHECK(padding == 6);
+	FF_CHECK(list.getFreeBytes() == 256 - 32);
+
+	//alignmentΪ0ʱ
+	FF_CHECK(list.allocate(3, 0, offset, padding));
+	FF_CHECK(offset == 32);
+	FF_CHECK(padding == 0);
+}
+
+static void testBestFit() {
+	FreeRangeList list(100);
+	uint64_t offsets[4]{};
+	uint64_t padding{ 0 };
+	FF_CHECK(list.allocate(10, 1, offsets[0], padding));
+	FF_CHECK(list.allocate(20, 1, offsets[1], padding));
+	FF_CHECK(list.allocate(30, 1, offsets[2], padding));
+	FF_CHECK(list.allocate(10, 1, offsets[3], padding));
+
+	//Ϊ[10, 30)[70, 100)
+	list.free(offsets[1], 20, 0);
+	FF_CHECK(list.getRanges().size() == 2);
+
+	//15ʣС[10, 30)УǵһŵµĻ
+	uint64_t offset{ 0 };
+	FF_CHECK(list.allocate(15, 1, offset, padding));
+	FF_CHECK(offset == 10);
+
+	//պ÷µȡ
+	FF_CHECK(list.allocate(30, 1, offset, padding));
+	FF_CHECK(offset == 70);
+	FF_CHECK(list.getRanges().size() == 1);
+	FF_CHECK(list.getFreeBytes() == 5);
+}
+
+static void testFullUnchanged() {
+	FreeRangeList list(64);
+	uint64_t offset{ 0 };
+	uint64_t padding{ 0 };
+	FF_CHECK(list.allocate(40, 1, offset, padding));
+
+	//ʣ24Ų
+	FF_CHECK(!list.allocate(30, 1, offset, padding));
+
+	//Сŵ£֮Ų
+	FF_CHECK(!list.allocate(20, 64, offset, padding));
+
+	FF_CHECK(list.getRanges().size() == 1);
+	FF_CHECK(list.getRanges().begin()->first == 40);
+	FF_CHECK(list.getFreeBytes() == 24);
+
+	FreeRangeList empty;
+	FF_CHECK(!empty.allocate(1, 1, offset, padding));
+}
+
+//ǰһһǰϲȫͷźָΪһ
+static void testMerge() {
+	FreeRangeList list(50);
+	uint64_t offsets[5]{};
+	uint64_t padding{ 0 };
+	for (auto& offset : offsets) {
+		FF_CHECK(list.allocate(10, 1, offset, padding));
+	}
+	FF_CHECK(list.getFreeBytes() == 0);
+
+	list.free(offsets[1], 10, 0);
+	list.free(offsets[3], 10, 0);
+	FF_CHECK(list.getRanges().size() == 2);
+
+	//ǰһϲ
+	list.free(offsets[4], 10, 0);
+	FF_CHECK(list.getRanges().size() == 2);
+	FF_CHECK(list.getRanges().at(30) == 20);
+
+	//һϲ
+	list.free(offsets[0], 10, 0);
+	FF_CHECK(list.getRanges().size() == 2);
+	FF_CHECK(list.getRanges().at(0) == 20);
+
+	//ǰһϲ
+	list.free(offsets[2], 10, 0);
+	FF_CHECK(list.getRanges().size() == 1);
+	FF_CHECK(list.getRanges().at(0) == 50);
+	FF_CHECK(list.getLargestRange() == 50);
+}
+
+//paddingͷʱһ黹
+static void testFreeWithPadding() {
+	FreeRangeList list(128);
+	uint64_t first{ 0 };
+	uint64_t second{ 0 };
+	uint64_t firstPadding{ 0 };
+	uint64_t secondPadding{ 0 };
+	FF_CHECK(list.allocate(5, 1, first, firstPadding));
+	FF_CHECK(list.allocate(20, 32, second, secondPadding));
+	FF_CHECK(second == 32);
+	FF_CHECK(secondPadding == 27);
+
+	list.free(second, 20, secondPadding);
+	FF_CHECK(list.getRanges().size() == 1);
+	FF_CHECK(list.getRanges().at(5) == 123);
+
+	list.free(first, 5, firstPadding);
+	FF_CHECK(list.getRanges().size() == 1);
+	FF_CHECK(list.getFreeBytes() == 128);
+}
+
+int main() {
+	testAlignment();
+	testBestFit();
+	testFullUnchanged();
+	testMerge();
+	testFreeWithPadding();
+	return FF_TEST_RESULT();
+}
@@ -0,0 +1,133 @@
+#include "test.h"
+#include "../app/texture/ktx2.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using FF::Ktx2;
+using FF::Ktx2Image;
+
+static const char* TEST_PATH = "ktx2_test.ktx2";
+
+static std::vector<uint8_t> readFile(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void writeFile(const std::string& path, const std::vector<uint8_t>& bytes) {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+//levelSizesӵ0ʼÿһΪֵͬ
+static Ktx2Image createImage(VkFormat format, uint32_t width, uint32_t height, const std::vector<size_t>& levelSizes) {
+	Ktx2Image image;
+	image.mFormat = format;
+	image.mWidth = width;
+	image.mHeight = height;
+	for (size_t i = 0; i < levelSizes.size(); ++i) {
+		FF::Ktx2Level level{};
+		level.mOffset = image.mData.size();
+		level.mSize = levelSizes[i];
+		image.mLevels.push_back(level);
+		image.mData.resize(image.mData.size() + levelSizes[i], static_cast<uint8_t>(i + 1));
+	}
+	return image;
+}
+
+static bool loadThrows(const std::vector<uint8_t>& bytes) {
+	writeFile(TEST_PATH, bytes);
+	try {
+		Ktx2::load(TEST_PATH);
+	}
+	catch (const std::runtime_error& e) {
+		return std::string(e.what()).rfind("Error:", 0) == 0;
+	}
+	return false;
+}
+
+template<typename T>
+static void patch(std::vector<uint8_t>& bytes, size_t offset, T value) {
+	memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+static void testRoundTrip(const Ktx2Image& source) {
+	Ktx2::save(TEST_PATH, source);
+	FF_CHECK(Ktx2::isKtx2File(TEST_PATH));
+
+	auto loaded = Ktx2::load(TEST_PATH);
+	FF_CHECK(loaded.mFormat == source.mFormat);
+	FF_CHECK(loaded.mWidth == source.mWidth);
+	FF_CHECK(loaded.mHeight == source.mHeight);
+	FF_CHECK(loaded.mLevels.size() == source.mLevels.size());
+	for (size_t i = 0; i < loaded.mLevels.size() && i < source.mLevels.size(); ++i) {
+		const auto& a = loaded.mLevels[i];
+		const auto& b = source.mLevels[i];
+		FF_CHECK(a.mSize == b.mSize);
+		FF_CHECK(a.mOffset + a.mSize <= loaded.mData.size());
+		FF_CHECK(memcmp(loaded.mData.data() + a.mOffset, source.mData.data() + b.mOffset, b.mSize) == 0);
+	}
+}
+
+static void testRoundTrips() {
+	//4x2 -> 2x1 -> 1x1
+	testRoundTrip(createImage(VK_FORMAT_R8G8B8A8_SRGB, 4, 2, { 32, 8, 4 }));
+
+	//8x8BC12x2飬֮ÿһһ
+	testRoundTrip(createImage(VK_FORMAT_BC1_RGBA_SRGB_BLOCK, 8, 8, { 32, 8, 8, 8 }));
+}
+
+//headerlevelCountλidentifier7uint32֮level index80ֽڵheader
+static constexpr size_t LEVEL_COUNT_OFFSET = 12 + 4 * 7;
+static constexpr size_t LEVEL_INDEX_OFFSET = 80;
+
+static void testCorruptedFiles() {
+	Ktx2::save(TEST_PATH, createImage(VK_FORMAT_R8G8B8A8_SRGB, 4, 2, { 32, 8, 4 }));
+	const auto valid = readFile(TEST_PATH);
+	FF_CHECK(!loadThrows(valid));
+
+	auto badIdentifier = valid;
+	badIdentifier[1] = 'X';
+	FF_CHECK(loadThrows(badIdentifier));
+
+	//ݱض
+	auto truncated = valid;
+	truncated.pop_back();
+	FF_CHECK(loadThrows(truncated));
+
+	//ֻʣheader
+	auto headerOnly = std::vector<uint8_t>(valid.begin(), valid.begin() + LEVEL_INDEX_OFFSET);
+	FF_CHECK(loadThrows(headerOnly));
+
+	//4x23
+	auto tooManyLevels = valid;
+	patch<uint32_t>(tooManyLevels, LEVEL_COUNT_OFFSET, 4);
+	FF_CHECK(loadThrows(tooManyLevels));
+
+	auto hugeLevelCount = valid;
+	patch<uint32_t>(hugeLevelCount, LEVEL_COUNT_OFFSET, 0x40000000u);
+	FF_CHECK(loadThrows(hugeLevelCount));
+
+	//0ƫƳļƫƼӳ
+	auto badOffset = valid;
+	patch<uint64_t>(badOffset, LEVEL_INDEX_OFFSET, UINT64_MAX - 4);
+	FF_CHECK(loadThrows(badOffset));
+
+	//0ƫָheader
+	auto offsetInHeader = valid;
+	patch<uint64_t>(offsetInHeader, LEVEL_INDEX_OFFSET, 0);
+	FF_CHECK(loadThrows(offsetInHeader));
+
+	//0ĳ4x2RGBA8һ
+	auto badLength = valid;
+	patch<uint64_t>(badLength, LEVEL_INDEX_OFFSET + 8, 16);
+	FF_CHECK(loadThrows(badLength));
+}
+
+int main() {
+	testRoundTrips();
+	testCorruptedFiles();
+	std::remove(TEST_PATH);
+	return FF_TEST_RESULT();
+}
@@ -0,0 +1,170 @@
+#include "test.h"
+#include "../app/vulkan_wrapper/pipeline_state_key.h"
+#include <array>
+
+using FF::Wrapper::StateKeyWriter;
+
+static std::vector<uint8_t> setLayoutKey(const VkDescriptorSetLayoutCreateInfo& createInfo) {
+	StateKeyWriter writer;
+	writer.writeSetLayout(createInfo);
+	return writer.getBytes();
+}
+
+static std::vector<uint8_t> renderPassKey(const VkRenderPassCreateInfo& createInfo) {
+	StateKeyWriter writer;
+	writer.writeRenderPass(createInfo);
+	return writer.getBytes();
+}
+
+//set layoutֻݣͬ(ӦͬVkDescriptorSetLayout)ͬʱkeyͬ
+static void testSetLayoutByContent() {
+	std::array<VkDescriptorSetLayoutBinding, 2> bindingsA{};
+	bindingsA[0].binding = 0;
+	bindingsA[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	bindingsA[0].descriptorCount = 1;
+	bindingsA[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	bindingsA[1].binding = 1;
+	bindingsA[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	bindingsA[1].descriptorCount = 1;
+	bindingsA[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+	auto bindingsB = bindingsA;
+
+	VkDescriptorSetLayoutCreateInfo infoA{};
+	infoA.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	infoA.bindingCount = static_cast<uint32_t>(bindingsA.size());
+	infoA.pBindings = bindingsA.data();
+	auto infoB = infoA;
+	infoB.pBindings = bindingsB.data();
+
+	FF_CHECK(setLayoutKey(infoA) == setLayoutKey(infoB));
+
+	bindingsB[1].descriptorCount = 16;
+	FF_CHECK(setLayoutKey(infoA) != setLayoutKey(infoB));
+}
+
+//pNextеbinding flagsҲlayoutݵһ
+static void testSetLayoutBindingFlags() {
+	VkDescriptorSetLayoutBinding binding{};
+	binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	binding.descriptorCount = 64;
+	binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+	VkDescriptorSetLayoutCreateInfo plain{};
+	plain.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	plain.bindingCount = 1;
+	plain.pBindings = &binding;
+
+	VkDescriptorBindingFlags flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+	VkDescriptorSetLayoutBindingFlagsCreateInfo flagsInfo{};
+	flagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+	flagsInfo.bindingCount = 1;
+	flagsInfo.pBindingFlags = &flags;
+	auto withFlags = plain;
+	withFlags.pNext = &flagsInfo;
+
+	FF_CHECK(setLayoutKey(plain) != setLayoutKey(withFlags));
+
+	//flagsΪ0ûflagsṹͬ
+	flags = 0;
+	FF_CHECK(setLayoutKey(plain) == setLayoutKey(withFlags));
+}
+
+struct TestRenderPass {
+	std::array<VkAttachmentDescription, 3> mAttachments{};
+	VkAttachmentReference mColor{ 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+	VkAttachmentReference mResolve{ 1, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+	VkAttachmentReference mDepth{ 2, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+	VkSubpassDescription mSubpass{};
+	VkSubpassDependency mDependency{};
+	VkRenderPassCreateInfo mCreateInfo{};
+
+	//زɫ + resolve + ȣapplicationеrender passͬĽṹ
+	TestRenderPass() {
+		mAttachments[0].format = VK_FORMAT_B8G8R8A8_SRGB;
+		mAttachments[0].samples = VK_SAMPLE_COUNT_4_BIT;
+		mAttachments[1].format = VK_FORMAT_B8G8R8A8_SRGB;
+		mAttachments[1].samples = VK_SAMPLE_COUNT_1_BIT;
+		mAttachments[2].format = VK_FORMAT_D32_SFLOAT;
+		mAttachments[2].samples = VK_SAMPLE_COUNT_4_BIT;
+
+		mSubpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+		mSubpass.colorAttachmentCount = 1;
+		mSubpass.pColorAttachments = &mColor;
+		mSubpass.pResolveAttachments = &mResolve;
+		mSubpass.pDepthStencilAttachment = &mDepth;
+
+		mDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+		mDependency.dstSubpass = 0;
+		mDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		mDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+		mCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+		mCreateInfo.attachmentCount = static_cast<uint32_t>(mAttachments.size());
+		mCreateInfo.pAttachments = mAttachments.data();
+		mCreateInfo.subpassCount = 1;
+		mCreateInfo.pSubpasses = &mSubpass;
+		mCreateInfo.dependencyCount = 1;
+		mCreateInfo.pDependencies = &mDependency;
+	}
+
+	TestRenderPass(const TestRenderPass&) = delete;
+};
+
+//loadOp/storeOp/layoutӰ
+static void testRenderPassIgnoresLoadOpAndLayout() {
+	TestRenderPass a;
+	TestRenderPass b;
+	b.mAttachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+	b.mAttachments[1].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	b.mColor.layout = VK_IMAGE_LAYOUT_GENERAL;
+
+	FF_CHECK(renderPassKey(a.mCreateInfo) == renderPassKey(b.mCreateInfo));
+}
+
+//ͬsubpassòͬrender pass
+static void testRenderPassSubpassReferences() {
+	TestRenderPass base;
+	auto baseKey = renderPassKey(base.mCreateInfo);
+
+	TestRenderPass noDepth;
+	noDepth.mSubpass.pDepthStencilAttachment = nullptr;
+	FF_CHECK(renderPassKey(noDepth.mCreateInfo) != baseKey);
+
+	TestRenderPass noResolve;
+	noResolve.mSubpass.pResolveAttachments = nullptr;
+	FF_CHECK(renderPassKey(noResolve.mCreateInfo) != baseKey);
+
+	//resolveΪUNUSEDûresolveͬ
+	TestRenderPass unusedResolve;
+	unusedResolve.mResolve.attachment = VK_ATTACHMENT_UNUSED;
+	FF_CHECK(renderPassKey(unusedResolve.mCreateInfo) == renderPassKey(noResolve.mCreateInfo));
+
+	TestRenderPass otherDependency;
+	otherDependency.mDependency.dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+	FF_CHECK(renderPassKey(otherDependency.mCreateInfo) != baseKey);
+
+	TestRenderPass otherSamples;
+	otherSamples.mAttachments[2].samples = VK_SAMPLE_COUNT_1_BIT;
+	FF_CHECK(renderPassKey(otherSamples.mCreateInfo) != baseKey);
+}
+
+//FNV-1aı׼ֵ
+static void testHash() {
+	FF_CHECK(StateKeyWriter::hash({}) == 14695981039346656037ull);
+	FF_CHECK(StateKeyWriter::hash({ 'a' }) == 0xaf63dc4c8601ec8cull);
+
+	StateKeyWriter a;
+	a.write(uint32_t{ 1 });
+	StateKeyWriter b;
+	b.write(uint32_t{ 1 });
+	FF_CHECK(StateKeyWriter::hash(a.getBytes()) == StateKeyWriter::hash(b.getBytes()));
+}
+
+int main() {
+	testSetLayoutByContent();
+	testSetLayoutBindingFlags();
+	testRenderPassIgnoresLoadOpAndLayout();
+	testRenderPassSubpassReferences();
+	testHash();
+	return FF_TEST_RESULT();
+}
@@ -0,0 +1,69 @@
+#include "test.h"
+#include "../app/profiler.h"
+#include <sstream>
+#include <cstdio>
+#include <stdexcept>
+
+using FF::CpuProfiler;
+
+static std::string readFile(const std::string& path) {
+	std::ifstream file(path);
+	std::stringstream stream;
+	stream << file.rdbuf();
+	return stream.str();
+}
+
+static bool contains(const std::string& text, const std::string& part) {
+	return text.find(part) != std::string::npos;
+}
+
+static void testChromeTrace() {
+	auto& profiler = CpuProfiler::getInstance();
+	profiler.setEnabled(true);
+
+	const uint64_t base = 1000000000ull;
+	profiler.record("First", base, base + 1377);
+
+	//кܾ֮¼ɿѧ
+	profiler.record("Quote\"Name", base + 10000000000000ull, base + 10000000002500ull);
+	profiler.addGpuEvent("MainPass", base + 500, base + 750);
+
+	const std::string path = "profiler_test_trace.json";
+	profiler.writeChromeTrace(path);
+	std::string json = readFile(path);
+	std::remove(path.c_str());
+
+	FF_CHECK(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+	FF_CHECK(contains(json, "]}"));
+
+	//¼Ϊ0㣬λ΢룬λС
+	FF_CHECK(contains(json, "{\"name\":\"First\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":0.000,\"dur\":1.377}"));
+	FF_CHECK(contains(json, "{\"name\":\"Quote\\\"Name\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":10000000000.000,\"dur\":2.500}"));
+	FF_CHECK(contains(json, "{\"name\":\"MainPass\",\"ph\":\"X\",\"pid\":2,\"tid\":0,\"ts\":0.500,\"dur\":0.250}"));
+	FF_CHECK(!contains(json, "e+"));
+
+	size_t open = 0;
+	size_t close = 0;
+	for (char c : json) {
+		open += c == '{';
+		close += c == '}';
+	}
+	FF_CHECK(open == close);
+}
+
+static void testWriteFailureThrows() {
+	bool thrown = false;
+	try {
+		CpuProfiler::getInstance().writeChromeTrace("missing_directory/trace.json");
+	}
+	catch (const std::runtime_error&) {
+		thrown = true;
+	}
+	FF_CHECK(thrown);
+}
+
+int main() {
+	testChromeTrace();
+	testWriteFailureThrows();
+	return FF_TEST_RESULT();
+}
@@ -0,0 +1,78 @@
+#include "test.h"
+#include "../app/vulkan_wrapper/staging_ring.h"
+
+using FF::Wrapper::StagingRing;
+
+static void testAlignment() {
+	StagingRing ring(256, 16);
+	uint64_t offset{ 0 };
+
+	FF_CHECK(ring.allocate(10, offset));
+	FF_CHECK(offset == 0);
+	FF_CHECK(ring.allocate(10, offset));
+	FF_CHECK(offset == 16);
+	FF_CHECK(ring.getHead() == 26);
+}
+
+static void testFullUntilReleased() {
+	StagingRing ring(100, 1);
+	uint64_t offset{ 0 };
+
+	FF_CHECK(ring.allocate(60, offset));
+	uint64_t firstEnd = ring.getHead();
+	FF_CHECK(ring.allocate(30, offset));
+	FF_CHECK(offset == 60);
+
+	//ʣ10Ų£״̬
+	FF_CHECK(!ring.allocate(20, offset));
+	FF_CHECK(ring.getHead() == 90);
+
+	//ĩβŲʱһȦ㣬Ҫȵһι黹
+	FF_CHECK(!ring.allocate(50, offset));
+	ring.release(firstEnd);
+	FF_CHECK(ring.allocate(50, offset));
+	FF_CHECK(offset == 0);
+	FF_CHECK(ring.getHead() == 150);
+}
+
+//ʱҪȦҴڰȦݣreset֮ǰԶŲ£resetܷ֮
+static void testIdleWrapNeedsReset() {
+	StagingRing ring(100, 1);
+	uint64_t offset{ 0 };
+
+	FF_CHECK(ring.allocate(70, offset));
+	ring.release(ring.getHead());
+	FF_CHECK(ring.isIdle());
+
+	FF_CHECK(!ring.allocate(80, offset));
+	ring.reset();
+	FF_CHECK(ring.isIdle());
+	FF_CHECK(ring.allocate(80, offset));
+	FF_CHECK(offset == 0);
+}
+
+static void testWholeRingWithUnalignedSize() {
+	StagingRing ring(100, 16);
+	uint64_t offset{ 0 };
+
+	FF_CHECK(ring.allocate(5, offset));
+	ring.release(ring.getHead());
+	ring.reset();
+	FF_CHECK(ring.allocate(100, offset));
+	FF_CHECK(offset == 0);
+
+	ring.release(ring.getHead());
+	ring.reset();
+	FF_CHECK(ring.allocate(100, offset));
+	FF_CHECK(offset == 0);
+
+	FF_CHECK(!ring.allocate(101, offset));
+}
+
+int main() {
+	testAlignment();
+	testFullUntilReleased();
+	testIdleWrapNeedsReset();
+	testWholeRingWithUnalignedSize();
+	return FF_TEST_RESULT();
+}
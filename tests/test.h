@@ -0,0 +1,35 @@
+#pragma once
+
+#include <iostream>
+
+/*
+* СĲԹߣ
+* 1 FF_CHECKʧʱӡʽλãִкļ
+* 2 main󷵻FF_TEST_RESULT()ʧʱ0ctestݴж
+*/
+namespace FF::Test {
+
+	inline int& getFailureCount() {
+		static int count = 0;
+		return count;
+	}
+
+	inline void check(bool condition, const char* expression, const char* file, int line) {
+		if (!condition) {
+			std::cout << file << "(" << line << "): check failed: " << expression << std::endl;
+			++getFailureCount();
+		}
+	}
+
+	inline int getResult() {
+		if (getFailureCount() != 0) {
+			std::cout << getFailureCount() << " check(s) failed" << std::endl;
+			return 1;
+		}
+		return 0;
+	}
+}
+
+#define FF_CHECK(expression) FF::Test::check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+
+#define FF_TEST_RESULT() FF::Test::getResult()
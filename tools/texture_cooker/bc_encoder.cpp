@@ -0,0 +1,331 @@
+#include "bc_encoder.h"
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+
+namespace FF::Cooker {
+
+	namespace {
+		//ЭdimensionΪ3(RGB)4(RGBA)
+		void principalAxis(const uint8_t* pixels, uint32_t dimension, float* mean, float* axis) {
+			for (uint32_t c = 0; c < dimension; ++c) {
+				mean[c] = 0.0f;
+				for (uint32_t i = 0; i < 16; ++i) {
+					mean[c] += pixels[i * 4 + c];
+				}
+				mean[c] /= 16.0f;
+			}
+
+			float cov[4][4]{};
+			for (uint32_t i = 0; i < 16; ++i) {
+				float d[4]{};
+				for (uint32_t c = 0; c < dimension; ++c) {
+					d[c] = pixels[i * 4 + c] - mean[c];
+				}
+				for (uint32_t r = 0; r < dimension; ++r) {
+					for (uint32_t c = 0; c < dimension; ++c) {
+						cov[r][c] += d[r] * d[c];
+					}
+				}
+			}
+
+			//ݵɫһ㼯һֱ߸ε㹻
+			for (uint32_t c = 0; c < dimension; ++c) {
+				axis[c] = 1.0f;
+			}
+			for (int iter = 0; iter < 8; ++iter) {
+				float next[4]{};
+				float length = 0.0f;
+				for (uint32_t r = 0; r < dimension; ++r) {
+					for (uint32_t c = 0; c < dimension; ++c) {
+						next[r] += cov[r][c] * axis[c];
+					}
+					length += next[r] * next[r];
+				}
+				if (length < 1e-8f) {
+					break;
+				}
+				length = std::sqrt(length);
+				for (uint32_t c = 0; c < dimension; ++c) {
+					axis[c] = next[c] / length;
+				}
+			}
+		}
+
+		//ɷַͶӰȡԶΪ˵
+		void boundingEndpoints(const uint8_t* pixels, uint32_t dimension, float* e0, float* e1) {
+			float mean[4]{};
+			float axis[4]{};
+			principalAxis(pixels, dimension, mean, axis);
+
+			float minT = FLT_MAX;
+			float maxT = -FLT_MAX;
+			for (uint32_t i = 0; i < 16; ++i) {
+				float t = 0.0f;
+				for (uint32_t c = 0; c < dimension; ++c) {
+					t += (pixels[i * 4 + c] - mean[c]) * axis[c];
+				}
+				minT = std::min(minT, t);
+				maxT = std::max(maxT, t);
+			}
+
+			for (uint32_t c = 0; c < dimension; ++c) {
+				e0[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+				e1[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+			}
+		}
+
+		uint16_t packRGB565(const float* color) {
+			uint32_t r = static_cast<uint32_t>(color[0] * 31.0f / 255.0f + 0.5f);
+			uint32_t g = static_cast<uint32_t>(color[1] * 63.0f / 255.0f + 0.5f);
+			uint32_t b = static_cast<uint32_t>(color[2] * 31.0f / 255.0f + 0.5f);
+			return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+		}
+
+		void unpackRGB565(uint16_t packed, int* color) {
+			int r = (packed >> 11) & 31;
+			int g = (packed >> 5) & 63;
+			int b = packed & 31;
+			color[0] = (r << 3) | (r >> 2);
+			color[1] = (g << 2) | (g >> 4);
+			color[2] = (b << 3) | (b >> 2);
+		}
+
+		//λд128bitĿ飬ӵλʼ
+		void writeBits(uint8_t* block, uint32_t& position, uint32_t count, uint32_t value) {
+			for (uint32_t i = 0; i < count; ++i, ++position) {
+				if (value & (1u << i)) {
+					block[position >> 3] |= static_cast<uint8_t>(1u << (position & 7));
+				}
+			}
+		}
+
+		constexpr int BC7_WEIGHTS4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		struct Bc7Mode6 {
+			int mEndpoints[2][4]{};//7bit
+			int mPBits[2]{};
+			int mIndices[16]{};
+			uint64_t mError{ UINT64_MAX };
+		};
+
+		//˵Ϊ7bit + pbitpbitһȡС
+		void quantizeBc7Endpoint(const float* color, int* quantized, int& pBit) {
+			uint64_t bestError = UINT64_MAX;
+			for (int p = 0; p < 2; ++p) {
+				int q[4];
+				uint64_t error = 0;
+				for (int c = 0; c < 4; ++c) {
+					q[c] = std::clamp(static_cast<int>((color[c] - p) / 2.0f + 0.5f), 0, 127);
+					int d = ((q[c] << 1) | p) - static_cast<int>(color[c] + 0.5f);
+					error += d * d;
+				}
+				if (error < bestError) {
+					bestError = error;
+					pBit = p;
+					memcpy(quantized, q, sizeof(q));
+				}
+			}
+		}
+
+		//õĶ˵㣬Ϊÿѡ
+		void assignBc7Indices(const uint8_t* pixels, Bc7Mode6& mode) {
+			int palette[16][4];
+			for (int c = 0; c < 4; ++c) {
+				int e0 = (mode.mEndpoints[0][c] << 1) | mode.mPBits[0];
+				int e1 = (mode.mEndpoints[1][c] << 1) | mode.mPBits[1];
+				for (int i = 0; i < 16; ++i) {
+					palette[i][c] = ((64 - BC7_WEIGHTS4[i]) * e0 + BC7_WEIGHTS4[i] * e1 + 32) >> 6;
+				}
+			}
+
+			mode.mError = 0;
+			for (int p = 0; p < 16; ++p) {
+				uint32_t bestError = UINT32_MAX;
+				for (int i = 0; i < 16; ++i) {
+					uint32_t error = 0;
+					for (int c = 0; c < 4; ++c) {
+						int d = palette[i][c] - pixels[p * 4 + c];
+						error += d * d;
+					}
+					if (error < bestError) {
+						bestError = error;
+						mode.mIndices[p] = i;
+					}
+				}
+				mode.mError += bestError;
+			}
+		}
+
+		Bc7Mode6 fitBc7(const uint8_t* pixels, const float* e0, const float* e1) {
+			Bc7Mode6 mode;
+			quantizeBc7Endpoint(e0, mode.mEndpoints[0], mode.mPBits[0]);
+			quantizeBc7Endpoint(e1, mode.mEndpoints[1], mode.mPBits[1]);
+			assignBc7Indices(pixels, mode);
+			return mode;
+		}
+	}
+
+	void BcEncoder::encodeBC1(const uint8_t* pixels, uint8_t* block) {
+		float e0[4]{};
+		float e1[4]{};
+		boundingEndpoints(pixels, 3, e0, e1);
+
+		uint16_t c0 = packRGB565(e1);
+		uint16_t c1 = packRGB565(e0);
+
+		//c0 > c1ʱΪ4ɫģʽc0 == c1ʱضȡc0
+		if (c0 < c1) {
+			std::swap(c0, c1);
+		}
+
+		uint32_t indices = 0;
+		if (c0 != c1) {
+			int palette[4][3];
+			unpackRGB565(c0, palette[0]);
+			unpackRGB565(c1, palette[1]);
+			for (int c = 0; c < 3; ++c) {
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+
+			for (uint32_t p = 0; p < 16; ++p) {
+				uint32_t bestError = UINT32_MAX;
+				uint32_t bestIndex = 0;
+				for (uint32_t i = 0; i < 4; ++i) {
+					uint32_t error = 0;
+					for (int c = 0; c < 3; ++c) {
+						int d = palette[i][c] - pixels[p * 4 + c];
+						error += d * d;
+					}
+					if (error < bestError) {
+						bestError = error;
+						bestIndex = i;
+					}
+				}
+				indices |= bestIndex << (p * 2);
+			}
+		}
+
+		block[0] = static_cast<uint8_t>(c0 & 0xFF);
+		block[1] = static_cast<uint8_t>(c0 >> 8);
+		block[2] = static_cast<uint8_t>(c1 & 0xFF);
+		block[3] = static_cast<uint8_t>(c1 >> 8);
+		memcpy(block + 4, &indices, sizeof(indices));
+	}
+
+	void BcEncoder::encodeBC4(const uint8_t* pixels, uint32_t channel, uint8_t* block) {
+		int minValue = 255;
+		int maxValue = 0;
+		for (uint32_t p = 0; p < 16; ++p) {
+			minValue = std::min(minValue, static_cast<int>(pixels[p * 4 + channel]));
+			maxValue = std::max(maxValue, static_cast<int>(pixels[p * 4 + channel]));
+		}
+
+		memset(block, 0, 8);
+		block[0] = static_cast<uint8_t>(maxValue);
+		block[1] = static_cast<uint8_t>(minValue);
+		if (maxValue == minValue) {
+			return;
+		}
+
+		//r0 > r1ʱΪ8ֵģʽ0/1Ϊ˵㣬2-7Ϊr0r1Ĳֵ
+		int palette[8];
+		palette[0] = maxValue;
+		palette[1] = minValue;
+		for (int i = 1; i < 7; ++i) {
+			palette[i + 1] = ((7 - i) * maxValue + i * minValue + 3) / 7;
+		}
+
+		uint64_t indices = 0;
+		for (uint32_t p = 0; p < 16; ++p) {
+			int value = pixels[p * 4 + channel];
+			int bestError = INT32_MAX;
+			uint64_t bestIndex = 0;
+			for (int i = 0; i < 8; ++i) {
+				int error = std::abs(palette[i] - value);
+				if (error < bestError) {
+					bestError = error;
+					bestIndex = static_cast<uint64_t>(i);
+				}
+			}
+			indices |= bestIndex << (p * 3);
+		}
+
+		for (int i = 0; i < 6; ++i) {
+			block[2 + i] = static_cast<uint8_t>((indices >> (i * 8)) & 0xFF);
+		}
+	}
+
+	void BcEncoder::encodeBC5(const uint8_t* pixels, uint8_t* block) {
+		encodeBC4(pixels, 0, block);
+		encodeBC4(pixels, 1, block + 8);
+	}
+
+	void BcEncoder::encodeBC7(const uint8_t* pixels, uint8_t* block) {
+		float e0[4]{};
+		float e1[4]{};
+		boundingEndpoints(pixels, 4, e0, e1);
+
+		Bc7Mode6 best = fitBc7(pixels, e0, e1);
+
+		//ݵǰС˵: ÿͨ sum((1-w)e0 + w*e1 - p)^2 С
+		if (best.mError > 0) {
+			float a00 = 0.0f, a01 = 0.0f, a11 = 0.0f;
+			float b0[4]{}, b1[4]{};
+			for (int p = 0; p < 16; ++p) {
+				float w = BC7_WEIGHTS4[best.mIndices[p]] / 64.0f;
+				a00 += (1.0f - w) * (1.0f - w);
+				a01 += (1.0f - w) * w;
+				a11 += w * w;
+				for (int c = 0; c < 4; ++c) {
+					b0[c] += (1.0f - w) * pixels[p * 4 + c];
+					b1[c] += w * pixels[p * 4 + c];
+				}
+			}
+
+			float det = a00 * a11 - a01 * a01;
+			if (std::abs(det) > 1e-6f) {
+				float r0[4], r1[4];
+				for (int c = 0; c < 4; ++c) {
+					r0[c] = std::clamp((a11 * b0[c] - a01 * b1[c]) / det, 0.0f, 255.0f);
+					r1[c] = std::clamp((a00 * b1[c] - a01 * b0[c]) / det, 0.0f, 255.0f);
+				}
+
+				Bc7Mode6 refined = fitBc7(pixels, r0, r1);
+				if (refined.mError < best.mError) {
+					best = refined;
+				}
+			}
+		}
+
+		//0صλΪ0ʱ˵㲢ת
+		if (best.mIndices[0] & 8) {
+			for (int c = 0; c < 4; ++c) {
+				std::swap(best.mEndpoints[0][c], best.mEndpoints[1][c]);
+			}
+			std::swap(best.mPBits[0], best.mPBits[1]);
+			for (int p = 0; p < 16; ++p) {
+				best.mIndices[p] = 15 - best.mIndices[p];
+			}
+		}
+
+		memset(block, 0, BC7_BLOCK_BYTES);
+		uint32_t position = 0;
+
+		//mode 6: 60֮һ1
+		writeBits(block, position, 7, 1u << 6);
+		for (int c = 0; c < 4; ++c) {
+			writeBits(block, position, 7, best.mEndpoints[0][c]);
+			writeBits(block, position, 7, best.mEndpoints[1][c]);
+		}
+		writeBits(block, position, 1, best.mPBits[0]);
+		writeBits(block, position, 1, best.mPBits[1]);
+
+		writeBits(block, position, 3, best.mIndices[0]);
+		for (int p = 1; p < 16; ++p) {
+			writeBits(block, position, 4, best.mIndices[p]);
+		}
+	}
+}
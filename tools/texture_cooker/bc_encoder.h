@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../../app/base.h"
+
+namespace FF::Cooker {
+
+	/*
+	* 4x4ѹ룬Ϊе16RGBA8
+	* 1 BC1: ɷַȡ˵㣬5654ɫɫ壬ֻRGB
+	* 2 BC5: BC4ͨ(R/G)8ֵɫ壬ʺϷͼ
+	* 3 BC7: ֻʹmode 6ӼRGBA 7777+pbit˵㣬4bit
+	*        ɷ˵СһΣȡСĽ
+	*/
+	class BcEncoder {
+	public:
+		static constexpr uint32_t BC1_BLOCK_BYTES = 8;
+		static constexpr uint32_t BC5_BLOCK_BYTES = 16;
+		static constexpr uint32_t BC7_BLOCK_BYTES = 16;
+
+		static void encodeBC1(const uint8_t* pixels, uint8_t* block);
+
+		static void encodeBC5(const uint8_t* pixels, uint8_t* block);
+
+		static void encodeBC7(const uint8_t* pixels, uint8_t* block);
+
+	private:
+		//channelΪRGBAеͨ±
+		static void encodeBC4(const uint8_t* pixels, uint32_t channel, uint8_t* block);
+	};
+}
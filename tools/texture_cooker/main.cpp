@@ -0,0 +1,173 @@
+#include "../../app/base.h"
+#include "../../app/texture/ktx2.h"
+#include "../../app/texture/mip_generator.h"
+#include "../../app/vulkan_wrapper/image.h"
+#include "bc_encoder.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../../app/stb_image.h"
+
+/*
+* 決
+* texture_cooker <input.jpg|png> <output.ktx2> [--format bc7|bc1|bc5] [--linear] [--no-mips]
+* 1 ȡͼƬCPUmipmapÿһ4x4ѹ
+* 2 ĬBC7 sRGBߵȷɫʹ--linear˫ͨͼʹbc5
+* 3 KTX2ֱӽFF::TextureأʱٽͼƬ
+*/
+
+using namespace FF;
+
+namespace {
+	enum class BlockFormat {
+		BC1,
+		BC5,
+		BC7
+	};
+
+	struct CookOptions {
+		std::string mInput;
+		std::string mOutput;
+		BlockFormat mFormat{ BlockFormat::BC7 };
+		bool mLinear{ false };
+		bool mMipmaps{ true };
+	};
+
+	void printUsage() {
+		std::cout << "usage: texture_cooker <input> <output.ktx2> [--format bc7|bc1|bc5] [--linear] [--no-mips]" << std::endl;
+	}
+
+	bool parseOptions(int argc, char** argv, CookOptions& options) {
+		std::vector<std::string> positional;
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			if (arg == "--format" && i + 1 < argc) {
+				std::string format = argv[++i];
+				if (format == "bc1") {
+					options.mFormat = BlockFormat::BC1;
+				}
+				else if (format == "bc5") {
+					options.mFormat = BlockFormat::BC5;
+				}
+				else if (format == "bc7") {
+					options.mFormat = BlockFormat::BC7;
+				}
+				else {
+					std::cout << "unknown format " << format << std::endl;
+					return false;
+				}
+			}
+			else if (arg == "--linear") {
+				options.mLinear = true;
+			}
+			else if (arg == "--no-mips") {
+				options.mMipmaps = false;
+			}
+			else {
+				positional.push_back(arg);
+			}
+		}
+
+		if (positional.size() != 2) {
+			return false;
+		}
+
+		options.mInput = positional[0];
+		options.mOutput = positional[1];
+		return true;
+	}
+
+	VkFormat toVkFormat(const CookOptions& options) {
+		switch (options.mFormat) {
+		case BlockFormat::BC1:
+			return options.mLinear ? VK_FORMAT_BC1_RGB_UNORM_BLOCK : VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+		case BlockFormat::BC5:
+			//BC5ûsRGB汾
+			return VK_FORMAT_BC5_UNORM_BLOCK;
+		case BlockFormat::BC7:
+		default:
+			return options.mLinear ? VK_FORMAT_BC7_UNORM_BLOCK : VK_FORMAT_BC7_SRGB_BLOCK;
+		}
+	}
+
+	//һmipmap4x4ѹԵ4ʱظһ/
+	void encodeLevel(const uint8_t* pixels, uint32_t width, uint32_t height, BlockFormat format, std::vector<uint8_t>& out) {
+		uint32_t blockBytes = format == BlockFormat::BC1 ? Cooker::BcEncoder::BC1_BLOCK_BYTES : Cooker::BcEncoder::BC7_BLOCK_BYTES;
+		uint32_t blocksX = (width + 3) / 4;
+		uint32_t blocksY = (height + 3) / 4;
+
+		size_t begin = out.size();
+		out.resize(begin + static_cast<size_t>(blocksX) * blocksY * blockBytes);
+
+		uint8_t blockPixels[16 * 4];
+		for (uint32_t by = 0; by < blocksY; ++by) {
+			for (uint32_t bx = 0; bx < blocksX; ++bx) {
+				for (uint32_t y = 0; y < 4; ++y) {
+					uint32_t sy = std::min(by * 4 + y, height - 1);
+					for (uint32_t x = 0; x < 4; ++x) {
+						uint32_t sx = std::min(bx * 4 + x, width - 1);
+						memcpy(blockPixels + (y * 4 + x) * 4, pixels + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+					}
+				}
+
+				uint8_t* block = out.data() + begin + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+				switch (format) {
+				case BlockFormat::BC1:
+					Cooker::BcEncoder::encodeBC1(blockPixels, block);
+					break;
+				case BlockFormat::BC5:
+					Cooker::BcEncoder::encodeBC5(blockPixels, block);
+					break;
+				case BlockFormat::BC7:
+					Cooker::BcEncoder::encodeBC7(blockPixels, block);
+					break;
+				}
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	CookOptions options;
+	if (!parseOptions(argc, argv, options)) {
+		printUsage();
+		return -1;
+	}
+
+	try {
+		int texWidth, texHeight, texChannels;
+		stbi_uc* pixels = stbi_load(options.mInput.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+		if (!pixels) {
+			throw std::runtime_error("Error: failed to read image data " + options.mInput);
+		}
+
+		uint32_t levelCount = options.mMipmaps ? Wrapper::Image::calculateMipLevels(texWidth, texHeight) : 1;
+
+		std::vector<MipLevelInfo> levels;
+		auto mipData = MipGenerator::generate(pixels, texWidth, texHeight, levelCount, levels);
+		stbi_image_free(pixels);
+
+		Ktx2Image image;
+		image.mFormat = toVkFormat(options);
+		image.mWidth = static_cast<uint32_t>(texWidth);
+		image.mHeight = static_cast<uint32_t>(texHeight);
+		image.mLevels.resize(levelCount);
+
+		for (uint32_t i = 0; i < levelCount; ++i) {
+			image.mLevels[i].mOffset = image.mData.size();
+			encodeLevel(mipData.data() + levels[i].mOffset, levels[i].mWidth, levels[i].mHeight, options.mFormat, image.mData);
+			image.mLevels[i].mSize = image.mData.size() - image.mLevels[i].mOffset;
+		}
+
+		Ktx2::save(options.mOutput, image);
+
+		std::cout << options.mInput << " -> " << options.mOutput << ": "
+			<< texWidth << "x" << texHeight << ", " << levelCount << " levels, "
+			<< mipData.size() << " -> " << image.mData.size() << " bytes" << std::endl;
+	}
+	catch (const std::exception& e) {
+		std::cout << e.what() << std::endl;
+		return -1;
+	}
+
+	return 0;
+}